@@ -17,19 +17,25 @@
  */
 
 #include "AI.h"
+#include "BotPlanningPool.h"
 #include "CustomException.h"
-#include "MainGame.h"
+#include "Game.h"
 #include "MazeManager.h"
 #include "Player.h"
 #include "SpellChecker.h"
 #include "StringConverter.h"
 
+#include <algorithm>
+#ifdef HAVE_IOSTREAM
+	#include <iostream>
+#endif //HAVE_IOSTREAM
+
 ///TODO: Update the AI to reflect the addition of a wall dissolver item (icon: spray can labeled 'ACID')
 /* Progress report:
  * DFS and IDDFS can use acid.
  * Wall-following algorithms not updated yet because the maze may not be simply connected anymore. I've given up on them for now, but I'm leaving this todo note here. */
 
-AI::AI() : controlsPlayer(0) {
+AI::AI() : controlsPlayer(0), planNumber(0) {
 	try {
 		setup( nullptr, false, RANDOM_DEPTH_FIRST_SEARCH, 300 ); //setup( pointer to MainGame, whether to start solved, the algorithm to use, and the movement delay )
 	} catch( std::exception &e ) {
@@ -41,15 +47,13 @@ AI::~AI() {
 	try {
 		pathsToLockedCells.clear();
 		pathTaken.clear();
-		pretendCellsVisited.clear();
-		pretendCellsUnvisited.clear();
 	} catch( std::exception &e ) {
 		std::wcerr << L"Error in AI::~AI(): " << e.what() << std::endl;
 	}
 }
 
 AI::algorithm_t AI::algorithmFromString( std::wstring input ) {
-	std::vector< std::wstring > possibleChoices = { stringFromAlgorithm( RANDOM_DEPTH_FIRST_SEARCH ), stringFromAlgorithm( ITERATIVE_DEEPENING_DEPTH_FIRST_SEARCH ), stringFromAlgorithm( RIGHT_HAND_RULE ), stringFromAlgorithm( LEFT_HAND_RULE ), stringFromAlgorithm( DIJKSTRA ), stringFromAlgorithm( HEURISTIC_DEPTH_FIRST_SEARCH ) };
+	std::vector< std::wstring > possibleChoices = { stringFromAlgorithm( RANDOM_DEPTH_FIRST_SEARCH ), stringFromAlgorithm( ITERATIVE_DEEPENING_DEPTH_FIRST_SEARCH ), stringFromAlgorithm( RIGHT_HAND_RULE ), stringFromAlgorithm( LEFT_HAND_RULE ), stringFromAlgorithm( DIJKSTRA ), stringFromAlgorithm( HEURISTIC_DEPTH_FIRST_SEARCH ), stringFromAlgorithm( A_STAR ) };
 	
 	std::wstring choice;
 	{
@@ -71,6 +75,8 @@ AI::algorithm_t AI::algorithmFromString( std::wstring input ) {
 		result = DIJKSTRA;
 	} else if( choice == possibleChoices.at( 5 ) ) {
 		result = HEURISTIC_DEPTH_FIRST_SEARCH;
+	} else if( choice == possibleChoices.at( 6 ) ) {
+		result = A_STAR;
 	}
 	
 	return result;
@@ -83,66 +89,43 @@ void AI::allKeysFound() {
 		for( decltype( pathsToLockedCells.size() ) o = 0; o < pathsToLockedCells.size(); ++o ) {
 
 			for( decltype( pathsToLockedCells.at( o ).size() ) i = 0; i < pathsToLockedCells.at( o ).size(); ++i ) {
-
-				decltype( cellsVisited.size() ) j = 0;
-				while( j < cellsVisited.size() ) {
-
-					if( ( cellsVisited.at( j ).X == pathsToLockedCells.at( o )[ i ].X and cellsVisited.at( j ).Y == pathsToLockedCells.at( o )[ i ].Y ) ) {
-						cellsVisited.erase( cellsVisited.begin() + j );
-						j--;
-					}
-					++j;
-				}
+				cellsVisited.erase( pathsToLockedCells.at( o )[ i ].X, pathsToLockedCells.at( o )[ i ].Y );
 			}
 
 			//Reduce memory usage: We're done with these now, so clear them.
 			pathsToLockedCells.at( o ).clear();
 			pathsToLockedCells.at( o ).shrink_to_fit(); //If your compiler doesn't support C++11 or later, comment this line and uncomment the next
-			//std::vector< core::position2d< uint_fast8_t > >().swap( pathsToLockedCells.at( o ) );
+			//std::vector< core::position2d< coordinate_t > >().swap( pathsToLockedCells.at( o ) );
 		}
 		//Reduce memory usage: We're done with these now, so clear them.
 		pathsToLockedCells.clear();
 		pathsToLockedCells.shrink_to_fit(); //If your compiler doesn't support C++11 or later, comment this line and uncomment the next
-		//std::vector< std::vector< core::position2d< uint_fast8_t > > >().swap( pathsToLockedCells );
+		//std::vector< std::vector< core::position2d< coordinate_t > > >().swap( pathsToLockedCells );
 		
 		if( startSolved ) {
-			findSolution();
+			solveAgain();
 		}
 	} catch( std::exception &e ) {
 		std::wcerr << L"Error in AI::allKeysFound(): " << e.what() << std::endl;
 	}
 }
 
-bool AI::alreadyVisited( irr::core::position2d< uint_fast8_t > position ) {
+bool AI::alreadyVisited( irr::core::position2d< coordinate_t > position ) {
 	try {
-		bool result = false;
-
-		decltype( cellsVisited.size() ) i = 0;
-		while( i < cellsVisited.size() and result not_eq true ) {
-			if( cellsVisited.at( i ).X == position.X and cellsVisited.at( i ).Y == position.Y ) {
-				result = true;
-			}
-			++i;
+		auto maze = mg->getMazeManager();
+		if( cellsVisited.getCols() not_eq maze->cols or cellsVisited.getRows() not_eq maze->rows ) { //The maze was made after the last reset()
+			cellsVisited.clear( maze->cols, maze->rows );
 		}
-		return result;
+		return cellsVisited.contains( position.X, position.Y );
 	} catch( std::exception &e ) {
 		std::wcerr << L"Error in AI::alreadyVisited(): " << e.what() << std::endl;
 		return false;
 	}
 }
 
-bool AI::alreadyVisitedPretend( irr::core::position2d< uint_fast8_t > position ) {
+bool AI::alreadyVisitedPretend( irr::core::position2d< coordinate_t > position ) {
 	try {
-		bool result = false;
-
-		decltype( pretendCellsVisited.size() ) i = 0;
-		while( i < pretendCellsVisited.size() and result not_eq true ) {
-			if( pretendCellsVisited.at( i ).X == position.X and pretendCellsVisited.at( i ).Y == position.Y ) {
-				result = true;
-			}
-			++i;
-		}
-		return result;
+		return pretendCellsVisited.contains( position.X, position.Y );
 	} catch( std::exception &e ) {
 		std::wcerr << L"Error in AI::alreadyVisitedPretend(): " << e.what() << std::endl;
 		return false;
@@ -153,7 +136,7 @@ bool AI::atGoal() {
 	try {
 		if( mg != nullptr ) {
 			Player* p = mg->getPlayer( controlsPlayer );
-			irr::core::position2d< uint_fast8_t > currentPosition( p->getX(), p->getY() );
+			irr::core::position2d< coordinate_t > currentPosition( p->getX(), p->getY() );
 			Goal* goal = mg->getGoal();
 			if( currentPosition.X == goal->getX() and currentPosition.Y == goal->getY() ) {
 				return true;
@@ -170,9 +153,48 @@ bool AI::atGoal() {
 	}
 }
 
+irr::core::position2d< coordinate_t > AI::chooseTarget() {
+	irr::core::position2d< coordinate_t > goal( mg->getGoal()->getX(), mg->getGoal()->getY() );
+	
+	//Acid is no use to bots which only walk through open passages, so only the keys get planned for
+	auto isKeyAt = [ this ]( decltype( mg->getNumCollectables() ) c, irr::core::position2d< coordinate_t > position ) {
+		auto collectable = mg->getCollectable( c );
+		return not collectable->owned and collectable->getType() == Collectable::KEY and collectable->getX() == position.X and collectable->getY() == position.Y;
+	};
+	
+	if( not keyRoutePlanned ) {
+		std::vector< irr::core::position2d< coordinate_t > > keys;
+		for( decltype( mg->getNumCollectables() ) c = 0; c < mg->getNumCollectables(); ++c ) {
+			auto collectable = mg->getCollectable( c );
+			irr::core::position2d< coordinate_t > position( collectable->getX(), collectable->getY() );
+			if( isKeyAt( c, position ) ) {
+				keys.push_back( position );
+			}
+		}
+		
+		auto maze = mg->getMazeManager();
+		auto cellsSearchedBefore = maze->distanceFields.getCellsSearched() + maze->treeDistances.getCellsSearched();
+		irr::core::position2d< coordinate_t > start( mg->getPlayer( controlsPlayer )->getX(), mg->getPlayer( controlsPlayer )->getY() );
+		keyRoute = maze->keyOrderPlanner.plan( maze->maze, maze->distanceFields, maze->treeDistances, start, keys, goal );
+		nodesExpanded += maze->distanceFields.getCellsSearched() + maze->treeDistances.getCellsSearched() - cellsSearchedBefore;
+		std::reverse( keyRoute.begin(), keyRoute.end() );
+		keyRoutePlanned = true;
+	}
+	
+	while( not keyRoute.empty() ) {
+		for( decltype( mg->getNumCollectables() ) c = 0; c < mg->getNumCollectables(); ++c ) {
+			if( isKeyAt( c, keyRoute.back() ) ) {
+				return keyRoute.back();
+			}
+		}
+		keyRoute.pop_back(); //Picked up already, maybe by someone else
+	}
+	return goal;
+}
+
 bool AI::doneWaiting() {
 	try {
-		if( lastTimeMoved < mg->timer->getRealTime() - movementDelay ) {
+		if( lastTimeMoved < mg->getRealTime() - movementDelay ) {
 			return true;
 		} else {
 			return false;
@@ -183,26 +205,26 @@ bool AI::doneWaiting() {
 	}
 }
 
-bool AI::effectivelyNoTopWall( uint_fast8_t x, uint_fast8_t y ) {
+bool AI::effectivelyNoTopWall( coordinate_t x, coordinate_t y ) {
 	return effectivelyNoTopWall( x, y, ( mg->getPlayer( controlsPlayer )->hasItem() and mg->getPlayer( controlsPlayer )->getItemType() == Collectable::ACID ) );
 }
 
-bool AI::effectivelyNoTopWall( uint_fast8_t x, uint_fast8_t y, bool canDissolveWalls ) {
-	if( mg not_eq nullptr and mg->getMazeManager() not_eq nullptr and mg->getMazeManager()->maze not_eq nullptr ) {
-		auto topWall = mg->getMazeManager()->maze[ x ][ y ].getTop();
+bool AI::effectivelyNoTopWall( coordinate_t x, coordinate_t y, bool canDissolveWalls ) {
+	if( mg not_eq nullptr and mg->getMazeManager() not_eq nullptr and not mg->getMazeManager()->maze.empty() ) {
+		auto topWall = mg->getMazeManager()->maze.getTop( x, y );
 		return ( topWall == MazeCell::NONE or ( ( topWall not_eq MazeCell::LOCK and topWall not_eq MazeCell::ACIDPROOF )  and canDissolveWalls ) );
 	} else {
 		return false;
 	}
 }
 
-bool AI::effectivelyNoLeftWall( uint_fast8_t x, uint_fast8_t y ) {
+bool AI::effectivelyNoLeftWall( coordinate_t x, coordinate_t y ) {
 	return effectivelyNoLeftWall( x, y, ( mg->getPlayer( controlsPlayer )->hasItem() and mg->getPlayer( controlsPlayer )->getItemType() == Collectable::ACID ) );
 }
 
-bool AI::effectivelyNoLeftWall( uint_fast8_t x, uint_fast8_t y, bool canDissolveWalls ) {
-	if( mg not_eq nullptr and mg->getMazeManager()->maze not_eq nullptr ) {
-		auto leftWall = mg->getMazeManager()->maze[ x ][ y ].getLeft();
+bool AI::effectivelyNoLeftWall( coordinate_t x, coordinate_t y, bool canDissolveWalls ) {
+	if( mg not_eq nullptr and not mg->getMazeManager()->maze.empty() ) {
+		auto leftWall = mg->getMazeManager()->maze.getLeft( x, y );
 		return( leftWall == MazeCell::NONE or ( ( leftWall not_eq MazeCell::LOCK and leftWall not_eq MazeCell::ACIDPROOF ) and canDissolveWalls ) );
 	} else {
 		return false;
@@ -217,16 +239,16 @@ void AI::findSolution() {
 		solution.clear();
 		{
 			Player* p = mg->getPlayer( controlsPlayer );
-			irr::core::position2d< uint_fast8_t > currentPosition( p->getX(), p->getY() );
+			irr::core::position2d< coordinate_t > currentPosition( p->getX(), p->getY() );
 			switch( algorithm ) {
 				case RANDOM_DEPTH_FIRST_SEARCH: {
-					pretendCellsVisited.clear();
+					pretendCellsVisited.clear( mg->getMazeManager()->cols, mg->getMazeManager()->rows );
 					findSolutionDFS( currentPosition );
 					solved = true;
 					break;
 				}
 				case ITERATIVE_DEEPENING_DEPTH_FIRST_SEARCH: {
-					pretendCellsVisited.clear();
+					pretendCellsVisited.clear( mg->getMazeManager()->cols, mg->getMazeManager()->rows );
 					findSolutionIDDFS( currentPosition );
 					solved = true;
 					break;
@@ -243,11 +265,15 @@ void AI::findSolution() {
 					break;
 				}
 				case HEURISTIC_DEPTH_FIRST_SEARCH: {
-					pretendCellsVisited.clear();
+					pretendCellsVisited.clear( mg->getMazeManager()->cols, mg->getMazeManager()->rows );
 					findSolutionBFS( currentPosition );
 					solved = true;
 					break;
 				}
+				case A_STAR: {
+					findSolutionAStar( currentPosition );
+					break;
+				}
 				default: {
 					StringConverter sc;
 					CustomException ce( std::wstring( L"Algorithm " ) + sc.toStdWString( algorithm ) + L" not yet added to findSolution()." );
@@ -272,201 +298,212 @@ void AI::findSolution() {
 	}
 }
 
+void AI::findSolutionAStar( irr::core::position2d< coordinate_t > startPosition ) {
+	try {
+		if( mg->getDebugStatus() ) {
+			std::wcout << L"Solving the maze using A*. Start position is (" << startPosition.X << L"," << startPosition.Y << L")" << std::endl;
+		}
+		
+		solution.clear();
+		auto maze = mg->getMazeManager();
+		if( maze->rows > 0 and maze->cols > 0 ) { //The maze size can be zero when the game first starts.
+			auto target = chooseTarget();
+			auto cols = maze->cols;
+			auto rows = maze->rows;
+			auto& graph = maze->junctionGraph;
+			graph.update( maze->maze );
+			
+			if( AStarStepsTaken.size() < maze->maze.getNumCells() ) {
+				AStarStepsTaken.resize( maze->maze.getNumCells() );
+				AStarCameFrom.resize( maze->maze.getNumCells() );
+				AStarSetOffGoing.resize( maze->maze.getNumCells() );
+			}
+			AStarReached.clear( cols, rows );
+			AStarClosed.clear( cols, rows );
+			AStarOpen.clear();
+			
+			//Each step moves one cell up, down, left, or right, so the Manhattan distance never overestimates how far away the target is. Since it also never drops by more than one per step, however long a corridor is, the first path found to any node is a shortest one, and no node gets expanded twice.
+			auto remaining = [ &target ]( coordinate_t x, coordinate_t y ) -> uint32_t {
+				return ( x > target.X ? x - target.X : target.X - x ) + ( y > target.Y ? y - target.Y : target.Y - y );
+			};
+			auto comesOutLater = []( const AStarNode& a, const AStarNode& b ) {
+				return a.estimate > b.estimate or ( a.estimate == b.estimate and a.remaining > b.remaining );
+			};
+			auto reach = [ & ]( uint_fast32_t cell, uint32_t stepsTaken, uint_fast32_t cameFrom, JunctionGraph::direction_t setOffGoing ) {
+				coordinate_t x = cell % cols;
+				coordinate_t y = cell / cols;
+				if( not AStarClosed.contains( x, y ) and ( not AStarReached.contains( x, y ) or stepsTaken < AStarStepsTaken[ cell ] ) ) {
+					AStarReached.insert( x, y );
+					AStarStepsTaken[ cell ] = stepsTaken;
+					AStarCameFrom[ cell ] = cameFrom;
+					AStarSetOffGoing[ cell ] = setOffGoing;
+					auto toGo = remaining( x, y );
+					AStarOpen.push_back( { stepsTaken + toGo, toGo, cell } );
+					std::push_heap( AStarOpen.begin(), AStarOpen.end(), comesOutLater );
+				}
+			};
+			
+			auto start = maze->maze.index( startPosition.X, startPosition.Y );
+			auto goal = maze->maze.index( target.X, target.Y );
+			
+			//The start and the target can both be partway along corridors. The target gets joined to the nodes at each end of its corridor, so that expanding either of those can reach it; the start gets joined to them when it's expanded.
+			uint_fast32_t targetEnd[ JunctionGraph::NUM_DIRECTIONS ];
+			JunctionGraph::direction_t towardTarget[ JunctionGraph::NUM_DIRECTIONS ];
+			uint32_t targetDistance[ JunctionGraph::NUM_DIRECTIONS ];
+			uint_fast8_t numTargetEnds = 0;
+			if( graph.nodeAt( goal ) == JunctionGraph::NOT_A_NODE ) {
+				for( uint_fast8_t d = 0; d < JunctionGraph::NUM_DIRECTIONS; ++d ) {
+					auto direction = static_cast< JunctionGraph::direction_t >( d );
+					if( graph.isOpen( maze->maze, goal, direction ) ) {
+						uint32_t steps;
+						auto end = graph.follow( maze->maze, goal, direction, goal, steps );
+						nodesExpanded += steps;
+						if( end not_eq goal ) { //It's on a loop with no junctions, which nothing can get into
+							targetEnd[ numTargetEnds ] = end;
+							towardTarget[ numTargetEnds ] = static_cast< JunctionGraph::direction_t >( ( direction + 2 ) % JunctionGraph::NUM_DIRECTIONS );
+							targetDistance[ numTargetEnds ] = steps;
+							numTargetEnds += 1;
+						}
+					}
+				}
+			}
+			
+			reach( start, 0, start, JunctionGraph::UP );
+			bool found = false;
+			while( not found and not AStarOpen.empty() ) {
+				std::pop_heap( AStarOpen.begin(), AStarOpen.end(), comesOutLater );
+				auto cell = AStarOpen.back().cell;
+				AStarOpen.pop_back();
+				
+				coordinate_t x = cell % cols;
+				coordinate_t y = cell / cols;
+				if( AStarClosed.contains( x, y ) ) { //Left over from before a shorter way here was found
+					continue;
+				}
+				AStarClosed.insert( x, y );
+				nodesExpanded += 1;
+				
+				if( cell == goal ) {
+					found = true;
+				} else {
+					auto node = graph.nodeAt( cell );
+					if( node == JunctionGraph::NOT_A_NODE ) { //Only the start can be partway along a corridor. Walk to each end, or to the target if it's in the same corridor.
+						for( uint_fast8_t d = 0; d < JunctionGraph::NUM_DIRECTIONS; ++d ) {
+							auto direction = static_cast< JunctionGraph::direction_t >( d );
+							if( graph.isOpen( maze->maze, cell, direction ) ) {
+								uint32_t steps;
+								auto end = graph.follow( maze->maze, cell, direction, goal, steps );
+								nodesExpanded += steps;
+								reach( end, AStarStepsTaken[ cell ] + steps, cell, static_cast< JunctionGraph::direction_t >( d ) );
+							}
+						}
+					} else {
+						for( uint_fast8_t d = 0; d < JunctionGraph::NUM_DIRECTIONS; ++d ) {
+							auto direction = static_cast< JunctionGraph::direction_t >( d );
+							auto neighbor = graph.getNeighbor( node, direction );
+							if( neighbor not_eq JunctionGraph::NOT_A_NODE ) {
+								reach( graph.getCell( neighbor ), AStarStepsTaken[ cell ] + graph.getLength( node, direction ), cell, direction );
+							}
+						}
+						for( decltype( numTargetEnds ) t = 0; t < numTargetEnds; ++t ) {
+							if( targetEnd[ t ] == cell ) {
+								reach( goal, AStarStepsTaken[ cell ] + targetDistance[ t ], cell, towardTarget[ t ] );
+							}
+						}
+					}
+				}
+			}
+			
+			if( found ) { //Walk each corridor on the way back from the target. Reversing each one as it's added leaves the first step at the back, which is where move() takes steps from.
+				auto cell = goal;
+				while( cell not_eq start ) {
+					auto corridorStart = solution.size();
+					auto direction = static_cast< JunctionGraph::direction_t >( AStarSetOffGoing[ cell ] );
+					uint32_t steps;
+					graph.follow( maze->maze, AStarCameFrom[ cell ], direction, cell, steps, &solution );
+					std::reverse( solution.begin() + corridorStart, solution.end() );
+					cell = AStarCameFrom[ cell ];
+				}
+			}
+		} else { //Maze size is zero
+		}
+		
+		if( solution.size() > 0 ) {
+			solved = true;
+		}
+		
+		if( mg->getDebugStatus() ) {
+			std::wcout << L"Done solving using A*. Solution size: " << solution.size() << std::endl;
+		}
+	} catch( std::exception &e ) {
+		std::wcerr << L"Error in AI::findSolutionAStar(): " << e.what() << std::endl;
+	}
+}
+
 /**
 * @brief Finds a solution using a modified Depth-First search algorithm. Works by calling findSolutionIDDFS() with the max depth possible and the chooseBest argument set to true.
 * @param startPosition
 */
-void AI::findSolutionBFS( irr::core::position2d< uint_fast8_t > startPosition ) {
+void AI::findSolutionBFS( irr::core::position2d< coordinate_t > startPosition ) {
 	try {
-		std::vector< irr::core::position2d< uint_fast8_t > > partialSolution;
 		//Instead of adding a bunch of code for DFS, just do IDDFS with the deepest max depth possible.
-		uint_fast16_t maxDepth = static_cast< uint_fast16_t > ( mg->getMazeManager()->cols ) * static_cast< uint_fast16_t > ( mg->getMazeManager()->rows );
-		pretendCellsVisited.clear();
-		IDDFSDeadEnds.clear();
-		findSolutionIDDFS( partialSolution, startPosition, maxDepth, false, true );
+		uint_fast32_t maxDepth = static_cast< uint_fast32_t > ( mg->getMazeManager()->cols ) * static_cast< uint_fast32_t > ( mg->getMazeManager()->rows );
+		pretendCellsVisited.clear( mg->getMazeManager()->cols, mg->getMazeManager()->rows );
+		IDDFSDeadEnds.clear( mg->getMazeManager()->cols, mg->getMazeManager()->rows );
+		findSolutionIDDFS( startPosition, maxDepth, true );
 
-		{ //Reverses the order of the solution, so we don't start at the wrong end
-			std::vector< irr::core::position2d< uint_fast8_t > > tempSolution;
-			while( not solution.empty() ) {
-				tempSolution.push_back( solution.back() );
-				solution.pop_back();
-			}
-			while( not tempSolution.empty() ) {
-				solution.insert( solution.begin(), tempSolution.back() );
-				tempSolution.pop_back();
-			}
-		}
+		std::reverse( solution.begin(), solution.end() ); //So we don't start at the wrong end
 		solution.push_back( startPosition );
 	} catch( std::exception &e ) {
 		std::wcerr << L"Error in AI::findSolutionBFS(): " << e.what() << std::endl;
 	}
 }
 
-void AI::findSolutionDFS( irr::core::position2d< uint_fast8_t > startPosition ) {
+void AI::findSolutionDFS( irr::core::position2d< coordinate_t > startPosition ) {
 	try {
-		std::vector< irr::core::position2d< uint_fast8_t > > partialSolution;
 		//Instead of adding a bunch of code for DFS, just do IDDFS with the deepest max depth possible.
-		uint_fast16_t maxDepth = static_cast< uint_fast16_t > ( mg->getMazeManager()->cols ) * static_cast< uint_fast16_t > ( mg->getMazeManager()->rows );
-		pretendCellsVisited.clear();
-		IDDFSDeadEnds.clear();
-		findSolutionIDDFS( partialSolution, startPosition, maxDepth, false );
+		uint_fast32_t maxDepth = static_cast< uint_fast32_t > ( mg->getMazeManager()->cols ) * static_cast< uint_fast32_t > ( mg->getMazeManager()->rows );
+		pretendCellsVisited.clear( mg->getMazeManager()->cols, mg->getMazeManager()->rows );
+		IDDFSDeadEnds.clear( mg->getMazeManager()->cols, mg->getMazeManager()->rows );
+		findSolutionIDDFS( startPosition, maxDepth, false );
 
-		{ //Reverses the order of the solution, so we don't start at the wrong end
-			std::vector< irr::core::position2d< uint_fast8_t > > tempSolution;
-			while( not solution.empty() ) {
-				tempSolution.push_back( solution.back() );
-				solution.pop_back();
-			}
-			while( not tempSolution.empty() ) {
-				solution.insert( solution.begin(), tempSolution.back() );
-				tempSolution.pop_back();
-			}
-		}
+		std::reverse( solution.begin(), solution.end() ); //So we don't start at the wrong end
 		solution.push_back( startPosition );
 	} catch( std::exception &e ) {
 		std::wcerr << L"Error in AI::findSolutionDFS(): " << e.what() << std::endl;
 	}
 }
 
-void AI::findSolutionDijkstra( irr::core::position2d< uint_fast8_t > startPosition ) {
+void AI::findSolutionDijkstra( irr::core::position2d< coordinate_t > startPosition ) {
 	try {
 		if( mg->getDebugStatus() ) {
 			std::wcout << L"Solving the maze using Dijkstra's algorithm. Start position is (" << startPosition.X << L"," << startPosition.Y << L")" << std::endl;
 		}
 		
+		solution.clear();
 		auto maze = mg->getMazeManager();
 		if( maze->rows > 0 and maze->cols > 0 ) { //The maze size can be zero when the game first starts.
-			std::vector< std::vector< irr::core::position2d< uint_fast8_t > > > previous;
-			DijkstraDistance.clear();
-			DijkstraDistance.resize( maze->cols );
-			previous.clear();
-			previous.resize( DijkstraDistance.size() );
-			for( decltype( DijkstraDistance.size() ) i = 0; i < DijkstraDistance.size(); ++i ) {
-				DijkstraDistance.at( i ).clear();
-				DijkstraDistance.at( i ).resize( maze->rows );
-				previous.at( i ).clear();
-				previous.at( i ).resize( maze->rows );
-			}
-			auto undefined = irr::core::position2d< uint_fast8_t >( UINT_FAST8_MAX, UINT_FAST8_MAX ); //An approximation for previous[v]  := undefined
-			//irr::core::position2d< uint_fast8_t > target;
-			std::vector< irr::core::position2d< uint_fast8_t > > targets;
-			decltype( targets.size() ) targetNumber = 0; //If a target gets found, targetNumber will identify it
-			
-			for( decltype( mg->getNumCollectables() ) c = 0; c < mg->getNumCollectables(); ++c ) {
-				auto collectable = mg->getCollectable( c );
-				targets.push_back( irr::core::position2d< uint_fast8_t >( collectable->getX(), collectable->getY() ) );
-			}
-			targets.push_back( irr::core::position2d< uint_fast8_t >( mg->getGoal()->getX(), mg->getGoal()->getY() ) );
+			auto target = chooseTarget();
 			
-			DijkstraDistance.at( startPosition.X ).at( startPosition.Y ) = 0; //dist[source]  := 0 // Distance from source to source
-			previous.at( startPosition.X ).at( startPosition.Y ) = undefined;
-			
-			for( decltype( maze->cols ) x = 0; x < maze->cols; ++x ) {
-				for( decltype( maze->rows ) y = 0; y < maze->rows; ++y ) { //for each vertex v in Graph: // Initializations
-					auto v = irr::core::position2d< decltype( x ) >( x, y );
-					if( v not_eq startPosition ) { //if v ≠ source
-						DijkstraDistance.at( v.X ).at( v.Y ) = UINT_FAST16_MAX; //dist[v] := infinity // Unknown distance function from source to v
-						previous.at( v.X ).at( v.Y ) = undefined; //previous[v]  := undefined
-					}
-					pretendCellsUnvisited.push_back( v ); //add v to Q // All nodes initially in Q (unvisited nodes)
-				}
-			}
-			
-			bool haveAcid = false;
-			
-			while( not pretendCellsUnvisited.empty() ) { //while Q is not empty: // The main loop
-				
-				if( mg->getDebugStatus() ) {
-					std::wcout << L"Distances: " << std::endl;
-					for( decltype( maze->rows ) y = 0; y < maze->rows; ++y ) {
-						for( decltype( maze->cols ) x = 0; x < maze->cols; ++x ) {
-							std::wcout << DijkstraDistance.at( x ).at( y ) << L"\t";
-						}
-						std::wcout << std::endl;
-					}
-				}
-				
-				uint_fast16_t minDistance = UINT_FAST16_MAX;
-				auto u = pretendCellsUnvisited.at( 0 );
-				for( decltype( pretendCellsUnvisited.size() ) i = 0; i < pretendCellsUnvisited.size(); ++i ) {
-					if( DijkstraDistance.at( pretendCellsUnvisited.at( i ).X ).at( pretendCellsUnvisited.at( i ).Y ) <= minDistance ) {
-						minDistance = DijkstraDistance.at( pretendCellsUnvisited.at( i ).X ).at( pretendCellsUnvisited.at( i ).Y );
-						u = pretendCellsUnvisited.at( i ); //u := vertex in Q with min dist[u] // Source node in first case
-					}
-				}
-				
-				for( decltype( pretendCellsUnvisited.size() ) i = 0; i < pretendCellsUnvisited.size(); ++i ) {
-					if( pretendCellsUnvisited.at( i ) == u ) {
-						pretendCellsUnvisited.erase( pretendCellsUnvisited.begin() + i ); //remove u from Q
-						break;
-					}
+			//Every step costs the same, so Dijkstra's algorithm comes down to a breadth-first search from the target. The MazeManager keeps the result for the other bots, and patches it up when walls get dissolved or unlocked, so this bot only pays for a whole search if it's the first to head there in this maze.
+			//Once all the keys have been found there are no locks left, so the field that counts locks as open (which the key planner already made for the goal) is just as good.
+			//Until a wall gets dissolved, though, there's only one way to get anywhere, and the MazeManager's TreeDistances can say what it is without any search at all.
+			auto cellsSearchedBefore = maze->distanceFields.getCellsSearched() + maze->treeDistances.getCellsSearched();
+			maze->treeDistances.update( maze->maze );
+			if( maze->treeDistances.isTree() ) {
+				maze->treeDistances.path( maze->maze, maze->maze.index( startPosition.X, startPosition.Y ), maze->maze.index( target.X, target.Y ), noKeysLeft, solution );
+			} else {
+				auto position = startPosition;
+				while( maze->distanceFields.stepToward( maze->maze, position.X, position.Y, target.X, target.Y, noKeysLeft ) ) {
+					solution.push_back( position );
 				}
 				
-				bool targetFound = false;
-				for( decltype( targets.size() ) t = 0; not targetFound and t < targets.size(); ++t ) {
-					if( u == targets.at( t ) ) {
-						targetFound = true;
-						/*for( decltype( mg->getNumCollectables() ) c = 0; c < mg->getNumCollectables(); ++c ) { //TODO: Dijkstra's algorithm seems to go into an infinite loop if it recognizes acid. Fix it.
-							auto collectable = mg->getCollectable( c );
-							if( collectable->getX() == u.X and collectable->getY() == u.Y ) {
-								if( collectable->getType() == Collectable::ACID ) {
-									haveAcid = true;
-								}
-								break;
-							}
-						}*/
-						break;
-					}
+				if( position not_eq target ) { //Unreachable
+					solution.clear();
 				}
-				
-				if( not targetFound ) {
-					decltype( pretendCellsUnvisited ) possibleNeighbors;
-					if( u.X > 0 and effectivelyNoLeftWall( u.X, u.Y, haveAcid ) ) {
-						possibleNeighbors.push_back( irr::core::position2d< uint_fast8_t >( u.X - 1, u.Y ) );
-					}
-					if( u.X < maze->cols - 1 and effectivelyNoLeftWall( u.X + 1, u.Y, haveAcid ) ) {
-						possibleNeighbors.push_back( irr::core::position2d< uint_fast8_t >( u.X + 1, u.Y ) );
-					}
-					if( u.Y > 0 and effectivelyNoTopWall( u.X, u.Y, haveAcid ) ) {
-						possibleNeighbors.push_back( irr::core::position2d< uint_fast8_t >( u.X, u.Y - 1 ) );
-					}
-					if( u.Y < maze->rows - 1 and effectivelyNoTopWall( u.X, u.Y + 1, haveAcid ) ) {
-						possibleNeighbors.push_back( irr::core::position2d< uint_fast8_t >( u.X, u.Y + 1 ) );
-					}
-					
-					if( possibleNeighbors.size() > 0 ) {
-						uint_fast16_t alt = 0;
-					
-						for( decltype( possibleNeighbors.size() ) i = 0; i < possibleNeighbors.size(); ++i ) {
-							bool stillUnvisited = false;
-							irr::core::position2d< uint_fast8_t > v = undefined; //for each neighbor v of u: // where v has not yet been removed from Q.
-							for( decltype( pretendCellsUnvisited.size() ) j = 0; not stillUnvisited and j < pretendCellsUnvisited.size(); ++j ) {
-								if( pretendCellsUnvisited.at( j ) == possibleNeighbors.at( i ) ) {
-									stillUnvisited = true;
-									v = possibleNeighbors.at( i );
-								}
-							}
-							
-							if( v not_eq undefined ) {
-								alt = DijkstraDistance.at( u.X ).at( u.Y ) + 1; //alt := dist[u] + length(u, v)
-								if( alt < DijkstraDistance.at( v.X ).at( v.Y ) ) { //if alt < dist[v]: // A shorter path to v has been found
-									DijkstraDistance.at( v.X ).at( v.Y ) = alt;
-									previous.at( v.X ).at( v.Y ) = u; //previous[v]  := u
-								} //end if
-							}
-						} //end for
-					}
-				} //end if u not_eq target
-			} //end while
-			
-			solution.clear(); //S := empty sequence
-			auto u = targets.at( targetNumber ); //u := target
-			while( previous.at( u.X ).at( u.Y ) not_eq undefined ) { //while previous[u] is defined: // Construct the shortest path with a stack S
-				//solution.insert( solution.begin(), u ); //insert u at the beginning of S // Push the vertex into the stack
-				solution.push_back( u );
-				u = previous.at( u.X ).at( u.Y ); //u := previous[u] // Traverse from target to source
-			} //end while
-
+			}
+			nodesExpanded += maze->distanceFields.getCellsSearched() + maze->treeDistances.getCellsSearched() - cellsSearchedBefore;
+			std::reverse( solution.begin(), solution.end() ); //move() takes steps off the back
 		} else { //Maze size is zero
 		}
 		
@@ -482,284 +519,249 @@ void AI::findSolutionDijkstra( irr::core::position2d< uint_fast8_t > startPositi
 	}
 }
 
-void AI::findSolutionIDDFS( irr::core::position2d< uint_fast8_t > startPosition, bool chooseBest ) {
+void AI::findSolutionIDDFS( irr::core::position2d< coordinate_t > startPosition, bool chooseBest ) {
 	try {
-		std::vector< irr::core::position2d< uint_fast8_t > > partialSolution;
-		
-		uint_fast16_t maxDepth = static_cast< uint_fast16_t >( mg->getMazeManager()->cols ) * static_cast< uint_fast16_t >( mg->getMazeManager()->rows );
+		uint_fast32_t maxDepth = static_cast< uint_fast32_t >( mg->getMazeManager()->cols ) * static_cast< uint_fast32_t >( mg->getMazeManager()->rows );
 		
 		if( noKeysLeft ) { //If there aren't any keys left, the only thing left to try for is the goal. There's no point in using a less-than-maximum depth limit in that case.
-			pretendCellsVisited.clear();
-			IDDFSDeadEnds.clear();
-			findSolutionIDDFS( partialSolution, startPosition, maxDepth, false, chooseBest );
+			pretendCellsVisited.clear( mg->getMazeManager()->cols, mg->getMazeManager()->rows );
+			IDDFSDeadEnds.clear( mg->getMazeManager()->cols, mg->getMazeManager()->rows );
+			findSolutionIDDFS( startPosition, maxDepth, chooseBest );
 		} else {
-			IDDFSDeadEnds.clear();
+			IDDFSDeadEnds.clear( mg->getMazeManager()->cols, mg->getMazeManager()->rows );
 			for( decltype( maxDepth ) i = 1; solution.empty() and i <= maxDepth; ++i ) {
 				if( mg->getDebugStatus() ) {
 					std::wcout << L"In IDDFS loop, i=" << i << std::endl;
 				}
-				pretendCellsVisited.clear();
-				findSolutionIDDFS( partialSolution, startPosition, i, false, chooseBest );
+				pretendCellsVisited.clear( mg->getMazeManager()->cols, mg->getMazeManager()->rows );
+				findSolutionIDDFS( startPosition, i, chooseBest );
 			}
 		}
 
-		{ //Reverses the order of the solution, so we don't start at the wrong end
-			std::vector< irr::core::position2d< uint_fast8_t > > tempSolution;
-			while( not solution.empty() ) {
-				tempSolution.push_back( solution.back() );
-				solution.pop_back();
-			}
-			while( not tempSolution.empty() ) {
-				solution.insert( solution.begin(), tempSolution.back() );
-				tempSolution.pop_back();
-			}
-		}
+		std::reverse( solution.begin(), solution.end() ); //So we don't start at the wrong end
 		solution.push_back( startPosition );
 	} catch( std::exception &e ) {
 		std::wcerr << L"Error in AI::findSolutionIDDFS(): " << e.what() << std::endl;
 	}
 }
 
-void AI::findSolutionIDDFS( std::vector< irr::core::position2d< uint_fast8_t > > partialSolution, irr::core::position2d< uint_fast8_t > currentPosition, uint_fast16_t depthLimit, bool canDissolveWalls, bool chooseBest ) {
+void AI::findSolutionIDDFS( irr::core::position2d< coordinate_t > startPosition, uint_fast32_t depthLimit, bool chooseBest ) {
 	try {
-		if( mg->getDebugStatus() ) {
-			std::wcout << L"findSolutionIDDFS: currentPosition: " << currentPosition.X << L"x" << currentPosition.Y << L" goal: " << mg->getGoal()->getX() << L"x" << mg->getGoal()->getY() << L" depthLimit: " << depthLimit << std::endl;
-		}
-
-		if( depthLimit == 0 ) {
-			partialSolution.push_back( currentPosition );
-			if( currentPosition.X == mg->getGoal()->getX() and currentPosition.Y == mg->getGoal()->getY() ) {
-				solution = partialSolution;
-				return;
-			} else {
-				for( decltype( mg->getNumCollectables() ) c = 0; c < mg->getNumCollectables(); ++c ) {
-					if( ( currentPosition.X == mg->getCollectable( c )->getX() and currentPosition.Y == mg->getCollectable( c )->getY() ) ) {
-						switch( mg->getCollectable( c )->getType() ) {
-							case Collectable::ACID: {
-								//canDissolveWalls = true; //Commenting this out because Clang's static analyzer says canDissolveWalls is never read after this point.
-								//solution = partialSolution;
-								break;
-							}
-							
-							case Collectable::KEY: {
-								solution = partialSolution;
-								keyImSeeking = c;
-								break;
-							}
+		IDDFSPath.clear();
+		IDDFSStack.clear();
+		
+		auto goal = mg->getGoal();
+		
+		//Looks at a cell the search has just stepped into. If there's anywhere to go from it, pushes a level onto the stack to keep track of where's been tried; either way, the cell stays on the path only as long as its level is on the stack.
+		auto enter = [ & ]( irr::core::position2d< coordinate_t > currentPosition, uint_fast32_t depthLeft, bool canDissolveWalls ) {
+			nodesExpanded += 1;
+			
+			if( mg->getDebugStatus() ) {
+				std::wcout << L"findSolutionIDDFS: currentPosition: " << currentPosition.X << L"x" << currentPosition.Y << L" goal: " << goal->getX() << L"x" << goal->getY() << L" depthLimit: " << depthLeft << std::endl;
+			}
+			
+			IDDFSPath.push_back( currentPosition );
+			if( depthLeft == 0 ) { //As deep as this iteration goes: just see whether it's somewhere worth going
+				if( currentPosition.X == goal->getX() and currentPosition.Y == goal->getY() ) {
+					solution = IDDFSPath;
+				} else {
+					for( decltype( mg->getNumCollectables() ) c = 0; c < mg->getNumCollectables(); ++c ) {
+						if( currentPosition.X == mg->getCollectable( c )->getX() and currentPosition.Y == mg->getCollectable( c )->getY() and mg->getCollectable( c )->getType() == Collectable::KEY ) {
+							solution = IDDFSPath;
+							keyImSeeking = c;
 						}
 					}
 				}
+				IDDFSPath.pop_back();
+				return;
 			}
 			
-			//No solution found, therefore solution.size() should be zero
-			//IDDFSDeadEnds.push_back( currentPosition );
-			return;
-		} else {
-
-			pretendCellsVisited.push_back( currentPosition );
-			partialSolution.push_back( currentPosition );
-			std::vector< direction_t > possibleDirections;
-			if( not ( currentPosition.X == mg->getGoal()->getX() and currentPosition.Y == mg->getGoal()->getY() ) ) {
-				
-				for( decltype( mg->getNumCollectables() ) c = 0; c < mg->getNumCollectables(); ++c ) {
-					if( currentPosition.X == mg->getCollectable( c )->getX() and currentPosition.Y == mg->getCollectable( c )->getY() ) {
-						switch( mg->getCollectable( c )->getType() ) {
-							case Collectable::ACID: {
-								canDissolveWalls = true;
-								//solution = partialSolution;
-								break;
-							}
-							
-							case Collectable::KEY: {
-								solution = partialSolution;
-								keyImSeeking = c;
-								break;
-							}
+			pretendCellsVisited.insert( currentPosition.X, currentPosition.Y );
+			if( currentPosition.X == goal->getX() and currentPosition.Y == goal->getY() ) {
+				solution = IDDFSPath;
+				IDDFSPath.pop_back();
+				return;
+			}
+			
+			for( decltype( mg->getNumCollectables() ) c = 0; c < mg->getNumCollectables(); ++c ) {
+				if( currentPosition.X == mg->getCollectable( c )->getX() and currentPosition.Y == mg->getCollectable( c )->getY() ) {
+					switch( mg->getCollectable( c )->getType() ) {
+						case Collectable::ACID: {
+							canDissolveWalls = true;
+							break;
+						}
+						
+						case Collectable::KEY: {
+							solution = IDDFSPath; //Keep searching, though: anything found later replaces this
+							keyImSeeking = c;
+							break;
 						}
 					}
 				}
-
-				//See which direction(s) the bot can move
-				if( currentPosition.Y > 0 and effectivelyNoTopWall( currentPosition.X, currentPosition.Y, canDissolveWalls ) and not alreadyVisitedPretend( irr::core::position2d< uint_fast8_t >( currentPosition.X, currentPosition.Y - 1 ) ) and not IDDFSIsDeadEnd( irr::core::position2d< uint_fast8_t >( currentPosition.X, currentPosition.Y - 1 ) ) ) {
-					possibleDirections.push_back( UP );
-				}
-				if( currentPosition.X > 0 and effectivelyNoLeftWall( currentPosition.X, currentPosition.Y, canDissolveWalls ) and not alreadyVisitedPretend( irr::core::position2d< uint_fast8_t >( currentPosition.X - 1, currentPosition.Y ) ) and not IDDFSIsDeadEnd( irr::core::position2d< uint_fast8_t >( currentPosition.X - 1, currentPosition.Y ) ) ) {
-					possibleDirections.push_back( LEFT );
-				}
-				if( currentPosition.Y < (mg->getMazeManager()->rows - 1) and effectivelyNoTopWall( currentPosition.X, currentPosition.Y + 1, canDissolveWalls ) and not alreadyVisitedPretend( irr::core::position2d< uint_fast8_t >( currentPosition.X, currentPosition.Y + 1 ) ) and not IDDFSIsDeadEnd( irr::core::position2d< uint_fast8_t >( currentPosition.X, currentPosition.Y + 1 ) ) ) {
-					possibleDirections.push_back( DOWN );
-				}
-				if( currentPosition.X < (mg->getMazeManager()->cols - 1) and effectivelyNoLeftWall( currentPosition.X + 1, currentPosition.Y, canDissolveWalls ) and not alreadyVisitedPretend( irr::core::position2d< uint_fast8_t >( currentPosition.X + 1, currentPosition.Y ) ) and not IDDFSIsDeadEnd( irr::core::position2d< uint_fast8_t >( currentPosition.X + 1, currentPosition.Y ) ) ) {
-					possibleDirections.push_back( RIGHT );
+			}
+			
+			//See which direction(s) the bot can move
+			IDDFSFrame frame;
+			frame.canDissolveWalls = canDissolveWalls;
+			frame.depthLeft = depthLeft;
+			frame.numDirectionsLeft = 0;
+			if( currentPosition.Y > 0 and effectivelyNoTopWall( currentPosition.X, currentPosition.Y, canDissolveWalls ) and not alreadyVisitedPretend( irr::core::position2d< coordinate_t >( currentPosition.X, currentPosition.Y - 1 ) ) and not IDDFSIsDeadEnd( irr::core::position2d< coordinate_t >( currentPosition.X, currentPosition.Y - 1 ) ) ) {
+				frame.directionsLeft[ frame.numDirectionsLeft++ ] = UP;
+			}
+			if( currentPosition.X > 0 and effectivelyNoLeftWall( currentPosition.X, currentPosition.Y, canDissolveWalls ) and not alreadyVisitedPretend( irr::core::position2d< coordinate_t >( currentPosition.X - 1, currentPosition.Y ) ) and not IDDFSIsDeadEnd( irr::core::position2d< coordinate_t >( currentPosition.X - 1, currentPosition.Y ) ) ) {
+				frame.directionsLeft[ frame.numDirectionsLeft++ ] = LEFT;
+			}
+			if( currentPosition.Y < (mg->getMazeManager()->rows - 1) and effectivelyNoTopWall( currentPosition.X, currentPosition.Y + 1, canDissolveWalls ) and not alreadyVisitedPretend( irr::core::position2d< coordinate_t >( currentPosition.X, currentPosition.Y + 1 ) ) and not IDDFSIsDeadEnd( irr::core::position2d< coordinate_t >( currentPosition.X, currentPosition.Y + 1 ) ) ) {
+				frame.directionsLeft[ frame.numDirectionsLeft++ ] = DOWN;
+			}
+			if( currentPosition.X < (mg->getMazeManager()->cols - 1) and effectivelyNoLeftWall( currentPosition.X + 1, currentPosition.Y, canDissolveWalls ) and not alreadyVisitedPretend( irr::core::position2d< coordinate_t >( currentPosition.X + 1, currentPosition.Y ) ) and not IDDFSIsDeadEnd( irr::core::position2d< coordinate_t >( currentPosition.X + 1, currentPosition.Y ) ) ) {
+				frame.directionsLeft[ frame.numDirectionsLeft++ ] = RIGHT;
+			}
+			
+			if( frame.numDirectionsLeft == 0 ) {
+				IDDFSDeadEnds.insert( currentPosition.X, currentPosition.Y );
+				IDDFSPath.pop_back();
+			} else {
+				IDDFSStack.push_back( frame );
+			}
+		};
+		
+		enter( startPosition, depthLimit, false );
+		while( not IDDFSStack.empty() ) {
+			auto& frame = IDDFSStack.back();
+			if( frame.numDirectionsLeft == 0 ) { //Tried everything from here
+				IDDFSStack.pop_back();
+				IDDFSPath.pop_back();
+				continue;
+			}
+			
+			auto currentPosition = IDDFSPath.back();
+			uint_fast8_t choiceInt = 0;
+			direction_t choice = UP;
+			
+			if( not ( chooseBest and IDDFSStack.size() == 1 ) ) { //Only the first step is chosen carefully; after that, the choices are random
+				choiceInt = mg->getRandomNumber() % frame.numDirectionsLeft;
+				choice = frame.directionsLeft[ choiceInt ];
+			} else {
+				//First, decide whether to try for a key/acid (default) or the goal (if all keys have been collected). Second, figure out which one is closest as the crow flies.
+				bool headForGoal = ( noKeysLeft or mg->getNumCollectables() == 0 ); //With nothing left to collect, there's no collectable to head for
+				decltype( mg->getNumCollectables() ) nearestCollectable = 0;
+				uint_fast32_t minDistance = UINT_FAST32_MAX;
+				if( headForGoal ) {
+					minDistance = sqrt( pow( ( int_fast32_t ) currentPosition.X - ( int_fast32_t ) goal->getX(), 2 ) + pow( ( int_fast32_t ) currentPosition.Y - ( int_fast32_t ) goal->getY(), 2 ) );
+				} else {
+					for( decltype( mg->getNumCollectables() ) c = 0; c < mg->getNumCollectables(); ++c ) {
+						auto collectable = mg->getCollectable( c );
+						decltype( minDistance ) distance = sqrt( pow( ( int_fast32_t ) currentPosition.X - ( int_fast32_t ) collectable->getX(), 2 ) + pow( ( int_fast32_t ) currentPosition.Y - ( int_fast32_t ) collectable->getY(), 2 ) );
+						if( distance <= minDistance ) {
+							nearestCollectable = c;
+							minDistance = distance;
+						}
+					}
 				}
 				
-				if( possibleDirections.empty() ) {
-					IDDFSDeadEnds.push_back( currentPosition );
+				//Finally, figure out which direction would move us least far away.
+				irr::core::vector2d< coordinate_t > destination;
+				if( headForGoal ) {
+					destination.X = goal->getX();
+					destination.Y = goal->getY();
+				} else {
+					destination.X = mg->getCollectable( nearestCollectable )->getX();
+					destination.Y = mg->getCollectable( nearestCollectable )->getY();
 				}
 				
-				if( possibleDirections.empty() and partialSolution.size() not_eq 0 ) {
-					partialSolution.pop_back();
-				} else {
-					while( not possibleDirections.empty() ) { //for( uint_fast8_t i = 0; ( i < possibleDirections.size() and solution.empty() ); ++i ) { //changed decltype( possibleDirections.size() ) to uint_fast8_t because the size of possibleDirections can never exceed 4 but could be stored in a needlessly large integer type.
-						
-						uint_fast8_t choiceInt = 0;// = mg->getRandomNumber() % possibleDirections.size();
-						direction_t choice = UP;
-						
-						if( not chooseBest ) {
-							choiceInt = mg->getRandomNumber() % possibleDirections.size();
-							choice = possibleDirections.at( choiceInt );
-						} else {
-							//TODO: Finish.
-							//First, decide whether to try for a key/acid (default) or the goal (if all keys have been collected)...
-							
-							//See bool noKeysLeft
-							
-							//Second, figure out which one is closest as the crow flies.
-							
-							decltype( mg->getNumCollectables() ) nearestCollectable = 0;
-							uint_fast16_t minDistance = UINT_FAST16_MAX;
-							if( noKeysLeft ) {
-								auto goal = mg->getGoal();
-								minDistance = sqrt( pow( ( int_fast16_t ) currentPosition.X - ( int_fast16_t ) goal->getX(), 2 ) + pow( ( int_fast16_t ) currentPosition.Y - ( int_fast16_t ) goal->getY(), 2 ) );
-							} else {
-								for( decltype( mg->getNumCollectables() ) c = 0; c < mg->getNumCollectables(); ++c ) {
-									auto collectable = mg->getCollectable( c );
-									decltype( minDistance ) distance = sqrt( pow( ( int_fast16_t ) currentPosition.X - ( int_fast16_t ) collectable->getX(), 2 ) + pow( ( int_fast16_t ) currentPosition.Y - ( int_fast16_t ) collectable->getY(), 2 ) );
-									if( distance <= minDistance ) {
-										nearestCollectable = c;
-										minDistance = distance;
-									}
-								}
-							}
-							
-							//Finally, figure out which direction would move us least far away.
-							irr::core::vector2d< uint_fast8_t > destination;
-							if( noKeysLeft ) {
-								auto goal = mg->getGoal();
-								destination.X = goal->getX();
-								destination.Y = goal->getY();
-							} else {
-								destination.X = mg->getCollectable( nearestCollectable )->getX();
-								destination.Y = mg->getCollectable( nearestCollectable )->getY();
-							}
-							
-							minDistance = UINT_FAST16_MAX; //Now we're reusing the minDistance variable to figure out which move will get us least far away
-							for( uint_fast8_t possibility = 0; possibility < possibleDirections.size(); ++possibility ) {
-								switch( possibleDirections.at( possibility ) ) {
-									case UP: {
-										decltype( minDistance ) distance = sqrt( pow( ( int_fast16_t ) currentPosition.X - ( int_fast16_t ) destination.X, 2 ) + pow( ( int_fast16_t ) currentPosition.Y - 1 - ( int_fast16_t ) destination.Y, 2 ) );
-										if( distance <= minDistance ) {
-											minDistance = distance;
-											choice = UP;
-										}
-										break;
-									}
-									case DOWN: {
-										decltype( minDistance ) distance = sqrt( pow( ( int_fast16_t ) currentPosition.X - ( int_fast16_t ) destination.X, 2 ) + pow( ( int_fast16_t ) currentPosition.Y + 1 - ( int_fast16_t ) destination.Y, 2 ) );
-										if( distance <= minDistance ) {
-											minDistance = distance;
-											choice = DOWN;
-										}
-										break;
-									}
-									case LEFT: {
-										decltype( minDistance ) distance = sqrt( pow( ( int_fast16_t ) currentPosition.X - 1 - ( int_fast16_t ) destination.X, 2 ) + pow( ( int_fast16_t ) currentPosition.Y - ( int_fast16_t ) destination.Y, 2 ) );
-										if( distance <= minDistance ) {
-											minDistance = distance;
-											choice = LEFT;
-										}
-										break;
-									}
-									case RIGHT: {
-										decltype( minDistance ) distance = sqrt( pow( ( int_fast16_t ) currentPosition.X + 1 - ( int_fast16_t ) destination.X, 2 ) + pow( ( int_fast16_t ) currentPosition.Y - ( int_fast16_t ) destination.Y, 2 ) );
-										if( distance <= minDistance ) {
-											minDistance = distance;
-											choice = RIGHT;
-										}
-										break;
-									}
-								}
-							}
-							
-							//Now, figure out (for later erasure) which index in possibleDirections corresponds to our chosen direction
-							for( uint_fast8_t index = 0; index < possibleDirections.size(); ++index ) {
-								if( possibleDirections.at( index ) == choice ) {
-									choiceInt = index;
-									break;
-								}
-							}
-							
+				minDistance = UINT_FAST32_MAX; //Now we're reusing the minDistance variable to figure out which move will get us least far away
+				for( uint_fast8_t possibility = 0; possibility < frame.numDirectionsLeft; ++possibility ) {
+					int_fast32_t x = currentPosition.X;
+					int_fast32_t y = currentPosition.Y;
+					switch( frame.directionsLeft[ possibility ] ) {
+						case UP: {
+							y -= 1;
+							break;
 						}
-						
-						auto newDepthLimit = depthLimit - 1;
-						switch( choice ) {
-							case UP: {
-								irr::core::position2d< uint_fast8_t > newPosition( currentPosition.X, currentPosition.Y - 1 );
-								
-								if ( mg->getMazeManager()->maze[ currentPosition.X ][ currentPosition.Y ].getTop() not_eq MazeCell::ACIDPROOF and canDissolveWalls ) {
-									canDissolveWalls = false;
-								}
-								
-								findSolutionIDDFS( partialSolution, newPosition, newDepthLimit, canDissolveWalls );
-							} break;
-							case DOWN: {
-								irr::core::position2d< uint_fast8_t > newPosition( currentPosition.X, currentPosition.Y + 1 );
-								
-								if ( mg->getMazeManager()->maze[ currentPosition.X ][ currentPosition.Y + 1 ].getTop() not_eq MazeCell::ACIDPROOF and canDissolveWalls ) {
-									canDissolveWalls = false;
-								}
-								
-								findSolutionIDDFS( partialSolution, newPosition, newDepthLimit, canDissolveWalls );
-							} break;
-							case LEFT: {
-								irr::core::position2d< uint_fast8_t > newPosition( currentPosition.X - 1, currentPosition.Y );
-								
-								if ( mg->getMazeManager()->maze[ currentPosition.X ][ currentPosition.Y ].getLeft() not_eq MazeCell::ACIDPROOF and canDissolveWalls ) {
-									canDissolveWalls = false;
-								}
-								
-								findSolutionIDDFS( partialSolution, newPosition, newDepthLimit, canDissolveWalls );
-							} break;
-							case RIGHT: {
-								irr::core::position2d< uint_fast8_t > newPosition( currentPosition.X + 1, currentPosition.Y );
-								
-								if ( mg->getMazeManager()->maze[ currentPosition.X + 1 ][ currentPosition.Y ].getLeft() not_eq MazeCell::ACIDPROOF and canDissolveWalls ) {
-									canDissolveWalls = false;
-								}
-								
-								findSolutionIDDFS( partialSolution, newPosition, newDepthLimit, canDissolveWalls );
-							} break;
+						case DOWN: {
+							y += 1;
+							break;
+						}
+						case LEFT: {
+							x -= 1;
+							break;
 						}
-						possibleDirections.erase( possibleDirections.begin() + choiceInt );
+						case RIGHT: {
+							x += 1;
+							break;
+						}
+					}
+					decltype( minDistance ) distance = sqrt( pow( x - ( int_fast32_t ) destination.X, 2 ) + pow( y - ( int_fast32_t ) destination.Y, 2 ) );
+					if( distance <= minDistance ) {
+						minDistance = distance;
+						choice = frame.directionsLeft[ possibility ];
+					}
+				}
+				
+				//Now, figure out (for later erasure) which index corresponds to our chosen direction
+				for( uint_fast8_t index = 0; index < frame.numDirectionsLeft; ++index ) {
+					if( frame.directionsLeft[ index ] == choice ) {
+						choiceInt = index;
+						break;
 					}
 				}
-
-			} else { //If we're at the goal
-				solution = partialSolution;
-				return;
 			}
+			
+			//Crossing the choice off before going deeper, since entering the next cell can add to the stack and move the frames around
+			for( auto i = choiceInt; i + 1 < frame.numDirectionsLeft; ++i ) {
+				frame.directionsLeft[ i ] = frame.directionsLeft[ i + 1 ];
+			}
+			frame.numDirectionsLeft -= 1;
+			
+			irr::core::position2d< coordinate_t > newPosition = currentPosition;
+			bool wallIsAcidProof = false;
+			switch( choice ) {
+				case UP: {
+					newPosition.Y -= 1;
+					wallIsAcidProof = ( mg->getMazeManager()->maze.getTop( currentPosition.X, currentPosition.Y ) == MazeCell::ACIDPROOF );
+					break;
+				}
+				case DOWN: {
+					newPosition.Y += 1;
+					wallIsAcidProof = ( mg->getMazeManager()->maze.getTop( currentPosition.X, currentPosition.Y + 1 ) == MazeCell::ACIDPROOF );
+					break;
+				}
+				case LEFT: {
+					newPosition.X -= 1;
+					wallIsAcidProof = ( mg->getMazeManager()->maze.getLeft( currentPosition.X, currentPosition.Y ) == MazeCell::ACIDPROOF );
+					break;
+				}
+				case RIGHT: {
+					newPosition.X += 1;
+					wallIsAcidProof = ( mg->getMazeManager()->maze.getLeft( currentPosition.X + 1, currentPosition.Y ) == MazeCell::ACIDPROOF );
+					break;
+				}
+			}
+			
+			if( not wallIsAcidProof and frame.canDissolveWalls ) { //The acid gets used up on the first step from where it was found
+				frame.canDissolveWalls = false;
+			}
+			
+			enter( newPosition, frame.depthLeft - 1, frame.canDissolveWalls );
 		}
 	} catch( CustomException &e ) {
 		std::wcerr << L"Error in AI::findSolutionIDDFS(): " << e.what() << std::endl;
 	} catch( std::exception &e ) {
 		std::wcerr << L"Error in AI::findSolutionIDDFS(): " << e.what() << std::endl;
 	}
-	if( partialSolution.size() > 0 ) {
-		partialSolution.pop_back();
-	}
+}
+
+uint_fast64_t AI::getNodesExpanded() const {
+	return nodesExpanded;
 }
 
 uint_fast8_t AI::getPlayer() const {
 	return controlsPlayer;
 }
 
-bool AI::IDDFSIsDeadEnd( irr::core::position2d< uint_fast8_t > position ) {
-	for( decltype( IDDFSDeadEnds.size() ) i = 0; i < IDDFSDeadEnds.size(); ++i ) {
-		if( IDDFSDeadEnds.at( i ) == position ) {
-			return true;
-		}
-	}
-	return false;
+bool AI::IDDFSIsDeadEnd( irr::core::position2d< coordinate_t > position ) {
+	return IDDFSDeadEnds.contains( position.X, position.Y );
 }
 
 void AI::keyFound( uint_fast8_t key ) {
@@ -767,9 +769,9 @@ void AI::keyFound( uint_fast8_t key ) {
 		//std::wcout << L"Bot acknowledging key " << key << L" found." << std::endl;
 		if( startSolved ) {
 			//std::wcout << L"Seeking key " << keyImSeeking << std::endl;
-			if( key == keyImSeeking ) {
+			if( key == keyImSeeking or ( mg->getBotPlanningPool() not_eq nullptr and not solved ) ) { //A plan that's still being worked out might be for the key that just got picked up
 				//std::wcout << L"They're the same" << std::endl;
-				findSolution();
+				solveAgain();
 			}
 		}
 
@@ -780,11 +782,18 @@ void AI::keyFound( uint_fast8_t key ) {
 
 void AI::move() {
 	try {
-		lastTimeMoved = mg->timer->getRealTime();
-		irr::core::position2d< uint_fast8_t > currentPosition( mg->getPlayer( controlsPlayer )->getX(), mg->getPlayer( controlsPlayer )->getY() );
+		if( startSolved and ( not solved or solution.empty() ) and mg->getBotPlanningPool() not_eq nullptr ) {
+			if( not mg->getBotPlanningPool()->takePlan( *this ) ) {
+				return; //Nothing to follow yet. Rather than hold up the game, the bot stays where it is and checks again next time.
+			}
+			//A finished plan can still be empty if there's no way to the target. Asking again would only get the same empty plan, so that goes to "Could not find a solution" below.
+		}
+		
+		lastTimeMoved = mg->getRealTime();
+		irr::core::position2d< coordinate_t > currentPosition( mg->getPlayer( controlsPlayer )->getX(), mg->getPlayer( controlsPlayer )->getY() );
 
 		if( startSolved ) {
-			while( not solved or solution.empty() ) {
+			while( ( not solved or solution.empty() ) and mg->getBotPlanningPool() == nullptr ) { //Bots using the pool never solve on the game's thread
 				findSolution();
 			}
 			
@@ -807,50 +816,51 @@ void AI::move() {
 			}
 
 		} else {
+			nodesExpanded += 1; //Without a solution, every move means looking around the current cell
 
 			switch( algorithm ) {
 				case RANDOM_DEPTH_FIRST_SEARCH: {
-					irr::core::position2d< uint_fast8_t > currentPosition( mg->getPlayer( controlsPlayer )->getX(), mg->getPlayer( controlsPlayer )->getY() );
+					irr::core::position2d< coordinate_t > currentPosition( mg->getPlayer( controlsPlayer )->getX(), mg->getPlayer( controlsPlayer )->getY() );
 					
 					if( pathTaken.size() == 0 ) { //Ensures that the player's start position is marked as visited
 						pathTaken.push_back( currentPosition );
 					}
 					
 					if( not alreadyVisited( currentPosition ) ) {
-						cellsVisited.push_back( currentPosition );
+						cellsVisited.insert( currentPosition.X, currentPosition.Y );
 					}
 					
 					std::vector< direction_t > possibleDirections;
 					if( not ( currentPosition.X == mg->getGoal()->getX() and currentPosition.Y == mg->getGoal()->getY() ) ) {
 
 						//Check for locks
-						if( mg->getMazeManager()->maze[ currentPosition.X ][ currentPosition.Y ].hasLock() ) {
-							pathsToLockedCells.push_back( std::vector< irr::core::position2d< uint_fast8_t > >() );
+						if( mg->getMazeManager()->maze.hasLock( currentPosition.X, currentPosition.Y ) ) {
+							pathsToLockedCells.push_back( std::vector< irr::core::position2d< coordinate_t > >() );
 							pathsToLockedCells.back().push_back( currentPosition );
 							pathsToLockedCells.back().push_back( currentPosition );
 						}
-						if( currentPosition.X < ( mg->getMazeManager()->cols - 1 ) and mg->getMazeManager()->maze[ currentPosition.X + 1 ][ currentPosition.Y ].hasLeftLock() ) {
-							pathsToLockedCells.push_back( std::vector< irr::core::position2d< uint_fast8_t > >() );
+						if( currentPosition.X < ( mg->getMazeManager()->cols - 1 ) and mg->getMazeManager()->maze.hasLeftLock( currentPosition.X + 1, currentPosition.Y ) ) {
+							pathsToLockedCells.push_back( std::vector< irr::core::position2d< coordinate_t > >() );
 							pathsToLockedCells.back().push_back( currentPosition );
-							pathsToLockedCells.back().push_back( irr::core::position2d< uint_fast8_t >( currentPosition.X + 1, currentPosition.Y ) );
+							pathsToLockedCells.back().push_back( irr::core::position2d< coordinate_t >( currentPosition.X + 1, currentPosition.Y ) );
 						}
-						if( currentPosition.Y < ( mg->getMazeManager()->rows - 1 ) and mg->getMazeManager()->maze[ currentPosition.X ][ currentPosition.Y + 1 ].hasTopLock() ) {
-							pathsToLockedCells.push_back( std::vector< irr::core::position2d< uint_fast8_t > >() );
+						if( currentPosition.Y < ( mg->getMazeManager()->rows - 1 ) and mg->getMazeManager()->maze.hasTopLock( currentPosition.X, currentPosition.Y + 1 ) ) {
+							pathsToLockedCells.push_back( std::vector< irr::core::position2d< coordinate_t > >() );
 							pathsToLockedCells.back().push_back( currentPosition );
-							pathsToLockedCells.back().push_back( irr::core::position2d< uint_fast8_t >( currentPosition.X, currentPosition.Y + 1 ) );
+							pathsToLockedCells.back().push_back( irr::core::position2d< coordinate_t >( currentPosition.X, currentPosition.Y + 1 ) );
 						}
 
 						//See which direction(s) the bot can move
-						if( currentPosition.Y > 0 and effectivelyNoTopWall( currentPosition.X, currentPosition.Y ) and not alreadyVisited( irr::core::position2d< uint_fast8_t >( currentPosition.X, currentPosition.Y - 1 ) ) ) {
+						if( currentPosition.Y > 0 and effectivelyNoTopWall( currentPosition.X, currentPosition.Y ) and not alreadyVisited( irr::core::position2d< coordinate_t >( currentPosition.X, currentPosition.Y - 1 ) ) ) {
 							possibleDirections.push_back( UP );
 						}
-						if( currentPosition.X > 0 and effectivelyNoLeftWall( currentPosition.X, currentPosition.Y ) and not alreadyVisited( irr::core::position2d< uint_fast8_t >( currentPosition.X - 1, currentPosition.Y ) ) ) {
+						if( currentPosition.X > 0 and effectivelyNoLeftWall( currentPosition.X, currentPosition.Y ) and not alreadyVisited( irr::core::position2d< coordinate_t >( currentPosition.X - 1, currentPosition.Y ) ) ) {
 							possibleDirections.push_back( LEFT );
 						}
-						if( currentPosition.Y < (mg->getMazeManager()->rows - 1) and effectivelyNoTopWall( currentPosition.X, currentPosition.Y + 1 ) and not alreadyVisited( irr::core::position2d< uint_fast8_t >( currentPosition.X, currentPosition.Y + 1 ) ) ) {
+						if( currentPosition.Y < (mg->getMazeManager()->rows - 1) and effectivelyNoTopWall( currentPosition.X, currentPosition.Y + 1 ) and not alreadyVisited( irr::core::position2d< coordinate_t >( currentPosition.X, currentPosition.Y + 1 ) ) ) {
 							possibleDirections.push_back( DOWN );
 						}
-						if( currentPosition.X < (mg->getMazeManager()->cols - 1) and effectivelyNoLeftWall( currentPosition.X + 1, currentPosition.Y ) and not alreadyVisited( irr::core::position2d< uint_fast8_t >( currentPosition.X + 1, currentPosition.Y ) ) ) {
+						if( currentPosition.X < (mg->getMazeManager()->cols - 1) and effectivelyNoLeftWall( currentPosition.X + 1, currentPosition.Y ) and not alreadyVisited( irr::core::position2d< coordinate_t >( currentPosition.X + 1, currentPosition.Y ) ) ) {
 							possibleDirections.push_back( RIGHT );
 						}
 					}
@@ -860,7 +870,7 @@ void AI::move() {
 					//If we can't go anywhere new, go back to previous position
 					if( possibleDirections.size() == 0 and pathTaken.size() not_eq 0 and not ( currentPosition.X == mg->getGoal()->getX() and currentPosition.Y == mg->getGoal()->getY() ) ) {
 						pathTaken.pop_back();
-						irr::core::position2d< uint_fast8_t > oldPosition = pathTaken.back();
+						irr::core::position2d< coordinate_t > oldPosition = pathTaken.back();
 						
 						for( decltype( pathsToLockedCells.size() ) o = 0; o < pathsToLockedCells.size(); ++o ) {
 							if( pathsToLockedCells.at( o ).back() not_eq currentPosition ) {
@@ -884,7 +894,7 @@ void AI::move() {
 						direction_t choice = possibleDirections.at( mg->getRandomNumber() % possibleDirections.size() ); //rand() % possibleDirections.size() );
 						switch( choice ) {
 							case UP: {
-								irr::core::position2d< uint_fast8_t > position( currentPosition.X, currentPosition.Y - 1 );
+								irr::core::position2d< coordinate_t > position( currentPosition.X, currentPosition.Y - 1 );
 								pathTaken.push_back( position );
 								for( decltype( pathsToLockedCells.size() ) o = 0; o < pathsToLockedCells.size(); ++o ) {
 									if( pathsToLockedCells.at( o ).back() not_eq position ) {
@@ -896,7 +906,7 @@ void AI::move() {
 								mg->movePlayerOnY( controlsPlayer, -1, false );
 							} break;
 							case DOWN: {
-								irr::core::position2d< uint_fast8_t > position( currentPosition.X, currentPosition.Y + 1 );
+								irr::core::position2d< coordinate_t > position( currentPosition.X, currentPosition.Y + 1 );
 								pathTaken.push_back( position );
 								for( decltype( pathsToLockedCells.size() ) o = 0; o < pathsToLockedCells.size(); ++o ) {
 									if( pathsToLockedCells.at( o ).back() not_eq position ) {
@@ -908,7 +918,7 @@ void AI::move() {
 								mg->movePlayerOnY( controlsPlayer, 1, false );
 							} break;
 							case LEFT: {
-								irr::core::position2d< uint_fast8_t > position( currentPosition.X - 1, currentPosition.Y );
+								irr::core::position2d< coordinate_t > position( currentPosition.X - 1, currentPosition.Y );
 								pathTaken.push_back( position );
 								for( decltype( pathsToLockedCells.size() ) o = 0; o < pathsToLockedCells.size(); ++o ) {
 									if( pathsToLockedCells.at( o ).back() not_eq position ) {
@@ -920,7 +930,7 @@ void AI::move() {
 								mg->movePlayerOnX( controlsPlayer, -1, false );
 							} break;
 							case RIGHT: {
-								irr::core::position2d< uint_fast8_t > position( currentPosition.X + 1, currentPosition.Y );
+								irr::core::position2d< coordinate_t > position( currentPosition.X + 1, currentPosition.Y );
 								pathTaken.push_back( position );
 								for( decltype( pathsToLockedCells.size() ) o = 0; o < pathsToLockedCells.size(); ++o ) {
 									if( pathsToLockedCells.at( o ).back() not_eq position ) {
@@ -944,32 +954,32 @@ void AI::move() {
 				}
 				case ITERATIVE_DEEPENING_DEPTH_FIRST_SEARCH: {
 					
-					irr::core::position2d< uint_fast8_t > currentPosition( mg->getPlayer( controlsPlayer )->getX(), mg->getPlayer( controlsPlayer )->getY() );
+					irr::core::position2d< coordinate_t > currentPosition( mg->getPlayer( controlsPlayer )->getX(), mg->getPlayer( controlsPlayer )->getY() );
 					
 					if( pathTaken.empty() ) {//currentPosition.X == mg->getStart( controlsPlayer )->getX() and currentPosition.Y == mg->getStart( controlsPlayer )->getY() ) {
 						IDDFSDepthLimit += 1;
-						cellsVisited.clear();
+						cellsVisited.clear( mg->getMazeManager()->cols, mg->getMazeManager()->rows );
 						pathTaken.push_back( currentPosition );
 					}
 					
 					if( not alreadyVisited( currentPosition ) ) {
-						cellsVisited.push_back( currentPosition );
+						cellsVisited.insert( currentPosition.X, currentPosition.Y );
 					}
 					
 					std::vector< direction_t > possibleDirections;
 					if( not ( currentPosition.X == mg->getGoal()->getX() and currentPosition.Y == mg->getGoal()->getY() ) ) {
 
 						//See which direction(s) the bot can move
-						if( currentPosition.Y > 0 and effectivelyNoTopWall( currentPosition.X, currentPosition.Y ) and not alreadyVisited( irr::core::position2d< uint_fast8_t >( currentPosition.X, currentPosition.Y - 1 ) ) ) {
+						if( currentPosition.Y > 0 and effectivelyNoTopWall( currentPosition.X, currentPosition.Y ) and not alreadyVisited( irr::core::position2d< coordinate_t >( currentPosition.X, currentPosition.Y - 1 ) ) ) {
 							possibleDirections.push_back( UP );
 						}
-						if( currentPosition.X > 0 and effectivelyNoLeftWall( currentPosition.X, currentPosition.Y ) and not alreadyVisited( irr::core::position2d< uint_fast8_t >( currentPosition.X - 1, currentPosition.Y ) ) ) {
+						if( currentPosition.X > 0 and effectivelyNoLeftWall( currentPosition.X, currentPosition.Y ) and not alreadyVisited( irr::core::position2d< coordinate_t >( currentPosition.X - 1, currentPosition.Y ) ) ) {
 							possibleDirections.push_back( LEFT );
 						}
-						if( currentPosition.Y < (mg->getMazeManager()->rows - 1) and effectivelyNoTopWall( currentPosition.X, currentPosition.Y + 1 ) and not alreadyVisited( irr::core::position2d< uint_fast8_t >( currentPosition.X, currentPosition.Y + 1 ) ) ) {
+						if( currentPosition.Y < (mg->getMazeManager()->rows - 1) and effectivelyNoTopWall( currentPosition.X, currentPosition.Y + 1 ) and not alreadyVisited( irr::core::position2d< coordinate_t >( currentPosition.X, currentPosition.Y + 1 ) ) ) {
 							possibleDirections.push_back( DOWN );
 						}
-						if( currentPosition.X < (mg->getMazeManager()->cols - 1) and effectivelyNoLeftWall( currentPosition.X + 1, currentPosition.Y ) and not alreadyVisited( irr::core::position2d< uint_fast8_t >( currentPosition.X + 1, currentPosition.Y ) ) ) {
+						if( currentPosition.X < (mg->getMazeManager()->cols - 1) and effectivelyNoLeftWall( currentPosition.X + 1, currentPosition.Y ) and not alreadyVisited( irr::core::position2d< coordinate_t >( currentPosition.X + 1, currentPosition.Y ) ) ) {
 							possibleDirections.push_back( RIGHT );
 						}
 					}
@@ -978,10 +988,13 @@ void AI::move() {
 						possibleDirections.clear();
 					}
 
-					//If we can't go anywhere new, go back to previous position
+					//If we can't go anywhere new, go back to previous position. Back at the start, there's no previous position: the next move starts over with a deeper limit.
 					if( possibleDirections.empty() and not pathTaken.empty() and not ( currentPosition.X == mg->getGoal()->getX() and currentPosition.Y == mg->getGoal()->getY() ) ) {
 						pathTaken.pop_back();
-						irr::core::position2d< uint_fast8_t > oldPosition = pathTaken.back();
+						if( pathTaken.empty() ) {
+							break;
+						}
+						irr::core::position2d< coordinate_t > oldPosition = pathTaken.back();
 
 						if( oldPosition.X < currentPosition.X ) {
 							mg->movePlayerOnX( controlsPlayer, -1, false );
@@ -997,22 +1010,22 @@ void AI::move() {
 						direction_t choice = possibleDirections.at( choiceNum );
 						switch( choice ) {
 							case UP: {
-								irr::core::position2d< uint_fast8_t > position( currentPosition.X, currentPosition.Y - 1 );
+								irr::core::position2d< coordinate_t > position( currentPosition.X, currentPosition.Y - 1 );
 								pathTaken.push_back( position );
 								mg->movePlayerOnY( controlsPlayer, -1, false );
 							} break;
 							case DOWN: {
-								irr::core::position2d< uint_fast8_t > position( currentPosition.X, currentPosition.Y + 1 );
+								irr::core::position2d< coordinate_t > position( currentPosition.X, currentPosition.Y + 1 );
 								pathTaken.push_back( position );
 								mg->movePlayerOnY( controlsPlayer, 1, false );
 							} break;
 							case LEFT: {
-								irr::core::position2d< uint_fast8_t > position( currentPosition.X - 1, currentPosition.Y );
+								irr::core::position2d< coordinate_t > position( currentPosition.X - 1, currentPosition.Y );
 								pathTaken.push_back( position );
 								mg->movePlayerOnX( controlsPlayer, -1, false );
 							} break;
 							case RIGHT: {
-								irr::core::position2d< uint_fast8_t > position( currentPosition.X + 1, currentPosition.Y );
+								irr::core::position2d< coordinate_t > position( currentPosition.X + 1, currentPosition.Y );
 								pathTaken.push_back( position );
 								mg->movePlayerOnX( controlsPlayer, 1, false );
 							} break;
@@ -1020,149 +1033,77 @@ void AI::move() {
 					}
 					break;
 				}
-				case RIGHT_HAND_RULE: {
-					
-					if( not alreadyVisited( currentPosition ) ) {
-						cellsVisited.push_back( currentPosition );
-					}
-					
-					switch( hand ) {
-						case RIGHT: {
-							if( currentPosition.Y > 0 and noOriginalTopWall( currentPosition.X, currentPosition.Y ) ) {
-								mg->movePlayerOnY( controlsPlayer, -1, false );
-								hand = DOWN;
-							} else {
-								hand = UP;
-								move();
-							}
-							break;
-						}
-						case UP: {
-							if( currentPosition.X > 0 and noOriginalLeftWall( currentPosition.X, currentPosition.Y ) ) {
-								mg->movePlayerOnX( controlsPlayer, -1, false );
-								hand = RIGHT;
-							} else {
-								hand = LEFT;
-								move();
-							}
-							break;
-						}
-						case LEFT: {
-							if( currentPosition.Y < ( mg->getMazeManager()->rows - 1 ) and noOriginalTopWall( currentPosition.X, currentPosition.Y + 1 ) ) {
-								mg->movePlayerOnY( controlsPlayer, 1, false );
-								hand = UP;
-							} else {
-								hand = DOWN;
-								move();
-							}
-							break;
-						}
-						case DOWN: {
-							if( currentPosition.X < ( mg->getMazeManager()->cols - 1 ) and noOriginalLeftWall( currentPosition.X + 1, currentPosition.Y ) ) {
-								mg->movePlayerOnX( controlsPlayer, 1, false );
-								hand = LEFT;
-							} else {
-								hand = RIGHT;
-								move();
-							}
-							break;
-						}
-					}
-					break;
-				}
+				case RIGHT_HAND_RULE:
 				case LEFT_HAND_RULE: {
-									
+					
 					if( not alreadyVisited( currentPosition ) ) {
-						cellsVisited.push_back( currentPosition );
+						cellsVisited.insert( currentPosition.X, currentPosition.Y );
 					}
 					
-					switch( hand ) {
-						case RIGHT: {
-							if( currentPosition.Y > 0 and noOriginalTopWall( currentPosition.X, currentPosition.Y ) ) {
-								mg->movePlayerOnY( controlsPlayer, -1, false );
-								hand = UP;
-							} else {
-								hand = DOWN;
-								move();
-							}
-							break;
-						}
-						case UP: {
-							if( currentPosition.X > 0 and noOriginalLeftWall( currentPosition.X, currentPosition.Y ) ) {
-								mg->movePlayerOnX( controlsPlayer, -1, false );
-								hand = LEFT;
-							} else {
-								hand = RIGHT;
-								move();
-							}
-							break;
-						}
-						case LEFT: {
-							if( currentPosition.Y < (mg->getMazeManager()->rows - 1) and noOriginalTopWall( currentPosition.X, currentPosition.Y + 1 ) ) {
-								mg->movePlayerOnY( controlsPlayer, 1, false );
-								hand = DOWN;
-							} else {
-								hand = UP;
-								move();
-							}
-							break;
-						}
-						case DOWN: {
-							if( currentPosition.X < (mg->getMazeManager()->cols - 1) and noOriginalLeftWall( currentPosition.X + 1, currentPosition.Y ) ) {
-								mg->movePlayerOnX( controlsPlayer, 1, false );
-								hand = RIGHT;
-							} else {
-								hand = LEFT;
-								move();
-							}
-							break;
+					auto maze = mg->getMazeManager();
+					maze->wallFollower.update( maze->maze );
+					auto cell = maze->maze.index( currentPosition.X, currentPosition.Y );
+					auto pointing = static_cast< WallFollower::direction_t >( hand );
+					uint_fast8_t turns;
+					WallFollower::direction_t moved;
+					if( maze->wallFollower.step( maze->maze, ( algorithm == RIGHT_HAND_RULE ? WallFollower::RIGHT_HAND : WallFollower::LEFT_HAND ), cell, pointing, turns, moved ) ) {
+						nodesExpanded += turns; //Each way with a wall used to mean another call to move()
+						hand = static_cast< direction_t >( pointing );
+						if( moved == WallFollower::UP ) {
+							mg->movePlayerOnY( controlsPlayer, -1, false );
+						} else if( moved == WallFollower::DOWN ) {
+							mg->movePlayerOnY( controlsPlayer, 1, false );
+						} else if( moved == WallFollower::LEFT ) {
+							mg->movePlayerOnX( controlsPlayer, -1, false );
+						} else {
+							mg->movePlayerOnX( controlsPlayer, 1, false );
 						}
 					}
 					break;
 				}
 				
 				case HEURISTIC_DEPTH_FIRST_SEARCH: {
-					irr::core::position2d< uint_fast8_t > currentPosition( mg->getPlayer( controlsPlayer )->getX(), mg->getPlayer( controlsPlayer )->getY() );
+					irr::core::position2d< coordinate_t > currentPosition( mg->getPlayer( controlsPlayer )->getX(), mg->getPlayer( controlsPlayer )->getY() );
 					
 					if( pathTaken.size() == 0 ) { //Ensures that the player's start position is marked as visited
 						pathTaken.push_back( currentPosition );
 					}
 					
 					if( not alreadyVisited( currentPosition ) ) {
-						cellsVisited.push_back( currentPosition );
+						cellsVisited.insert( currentPosition.X, currentPosition.Y );
 					}
 					
 					std::vector< direction_t > possibleDirections;
 					if( not ( currentPosition.X == mg->getGoal()->getX() and currentPosition.Y == mg->getGoal()->getY() ) ) {
 
 						//Check for locks
-						if( mg->getMazeManager()->maze[ currentPosition.X ][ currentPosition.Y ].hasLock() ) {
-							pathsToLockedCells.push_back( std::vector< irr::core::position2d< uint_fast8_t > >() );
+						if( mg->getMazeManager()->maze.hasLock( currentPosition.X, currentPosition.Y ) ) {
+							pathsToLockedCells.push_back( std::vector< irr::core::position2d< coordinate_t > >() );
 							pathsToLockedCells.back().push_back( currentPosition );
 							pathsToLockedCells.back().push_back( currentPosition );
 						}
-						if( currentPosition.X < ( mg->getMazeManager()->cols - 1 ) and mg->getMazeManager()->maze[ currentPosition.X + 1 ][ currentPosition.Y ].hasLeftLock() ) {
-							pathsToLockedCells.push_back( std::vector< irr::core::position2d< uint_fast8_t > >() );
+						if( currentPosition.X < ( mg->getMazeManager()->cols - 1 ) and mg->getMazeManager()->maze.hasLeftLock( currentPosition.X + 1, currentPosition.Y ) ) {
+							pathsToLockedCells.push_back( std::vector< irr::core::position2d< coordinate_t > >() );
 							pathsToLockedCells.back().push_back( currentPosition );
-							pathsToLockedCells.back().push_back( irr::core::position2d< uint_fast8_t >( currentPosition.X + 1, currentPosition.Y ) );
+							pathsToLockedCells.back().push_back( irr::core::position2d< coordinate_t >( currentPosition.X + 1, currentPosition.Y ) );
 						}
-						if( currentPosition.Y < ( mg->getMazeManager()->rows - 1 ) and mg->getMazeManager()->maze[ currentPosition.X ][ currentPosition.Y + 1 ].hasTopLock() ) {
-							pathsToLockedCells.push_back( std::vector< irr::core::position2d< uint_fast8_t > >() );
+						if( currentPosition.Y < ( mg->getMazeManager()->rows - 1 ) and mg->getMazeManager()->maze.hasTopLock( currentPosition.X, currentPosition.Y + 1 ) ) {
+							pathsToLockedCells.push_back( std::vector< irr::core::position2d< coordinate_t > >() );
 							pathsToLockedCells.back().push_back( currentPosition );
-							pathsToLockedCells.back().push_back( irr::core::position2d< uint_fast8_t >( currentPosition.X, currentPosition.Y + 1 ) );
+							pathsToLockedCells.back().push_back( irr::core::position2d< coordinate_t >( currentPosition.X, currentPosition.Y + 1 ) );
 						}
 
 						//See which direction(s) the bot can move
-						if( currentPosition.Y > 0 and effectivelyNoTopWall( currentPosition.X, currentPosition.Y ) and not alreadyVisited( irr::core::position2d< uint_fast8_t >( currentPosition.X, currentPosition.Y - 1 ) ) ) {
+						if( currentPosition.Y > 0 and effectivelyNoTopWall( currentPosition.X, currentPosition.Y ) and not alreadyVisited( irr::core::position2d< coordinate_t >( currentPosition.X, currentPosition.Y - 1 ) ) ) {
 							possibleDirections.push_back( UP );
 						}
-						if( currentPosition.X > 0 and effectivelyNoLeftWall( currentPosition.X, currentPosition.Y ) and not alreadyVisited( irr::core::position2d< uint_fast8_t >( currentPosition.X - 1, currentPosition.Y ) ) ) {
+						if( currentPosition.X > 0 and effectivelyNoLeftWall( currentPosition.X, currentPosition.Y ) and not alreadyVisited( irr::core::position2d< coordinate_t >( currentPosition.X - 1, currentPosition.Y ) ) ) {
 							possibleDirections.push_back( LEFT );
 						}
-						if( currentPosition.Y < (mg->getMazeManager()->rows - 1) and effectivelyNoTopWall( currentPosition.X, currentPosition.Y + 1 ) and not alreadyVisited( irr::core::position2d< uint_fast8_t >( currentPosition.X, currentPosition.Y + 1 ) ) ) {
+						if( currentPosition.Y < (mg->getMazeManager()->rows - 1) and effectivelyNoTopWall( currentPosition.X, currentPosition.Y + 1 ) and not alreadyVisited( irr::core::position2d< coordinate_t >( currentPosition.X, currentPosition.Y + 1 ) ) ) {
 							possibleDirections.push_back( DOWN );
 						}
-						if( currentPosition.X < (mg->getMazeManager()->cols - 1) and effectivelyNoLeftWall( currentPosition.X + 1, currentPosition.Y ) and not alreadyVisited( irr::core::position2d< uint_fast8_t >( currentPosition.X + 1, currentPosition.Y ) ) ) {
+						if( currentPosition.X < (mg->getMazeManager()->cols - 1) and effectivelyNoLeftWall( currentPosition.X + 1, currentPosition.Y ) and not alreadyVisited( irr::core::position2d< coordinate_t >( currentPosition.X + 1, currentPosition.Y ) ) ) {
 							possibleDirections.push_back( RIGHT );
 						}
 					}
@@ -1172,7 +1113,7 @@ void AI::move() {
 					//If we can't go anywhere new, go back to previous position
 					if( possibleDirections.size() == 0 and pathTaken.size() not_eq 0 and not ( currentPosition.X == mg->getGoal()->getX() and currentPosition.Y == mg->getGoal()->getY() ) ) {
 						pathTaken.pop_back();
-						irr::core::position2d< uint_fast8_t > oldPosition = pathTaken.back();
+						irr::core::position2d< coordinate_t > oldPosition = pathTaken.back();
 						
 						for( decltype( pathsToLockedCells.size() ) o = 0; o < pathsToLockedCells.size(); ++o ) {
 							if( pathsToLockedCells.at( o ).back() not_eq currentPosition ) {
@@ -1202,15 +1143,16 @@ void AI::move() {
 						
 						//Second, figure out which one is closest as the crow flies.
 						
+						bool headForGoal = ( noKeysLeft or mg->getNumCollectables() == 0 ); //With nothing left to collect, there's no collectable to head for
 						decltype( mg->getNumCollectables() ) nearestCollectable = 0;
-						uint_fast16_t minDistance = UINT_FAST16_MAX;
-						if( noKeysLeft ) {
+						uint_fast32_t minDistance = UINT_FAST32_MAX;
+						if( headForGoal ) {
 							auto goal = mg->getGoal();
-							minDistance = sqrt( pow( ( int_fast16_t ) currentPosition.X - ( int_fast16_t ) goal->getX(), 2 ) + pow( ( int_fast16_t ) currentPosition.Y - ( int_fast16_t ) goal->getY(), 2 ) );
+							minDistance = sqrt( pow( ( int_fast32_t ) currentPosition.X - ( int_fast32_t ) goal->getX(), 2 ) + pow( ( int_fast32_t ) currentPosition.Y - ( int_fast32_t ) goal->getY(), 2 ) );
 						} else {
 							for( decltype( mg->getNumCollectables() ) c = 0; c < mg->getNumCollectables(); ++c ) {
 								auto collectable = mg->getCollectable( c );
-								decltype( minDistance ) distance = sqrt( pow( ( int_fast16_t ) currentPosition.X - ( int_fast16_t ) collectable->getX(), 2 ) + pow( ( int_fast16_t ) currentPosition.Y - ( int_fast16_t ) collectable->getY(), 2 ) );
+								decltype( minDistance ) distance = sqrt( pow( ( int_fast32_t ) currentPosition.X - ( int_fast32_t ) collectable->getX(), 2 ) + pow( ( int_fast32_t ) currentPosition.Y - ( int_fast32_t ) collectable->getY(), 2 ) );
 								if( distance <= minDistance ) {
 									nearestCollectable = c;
 									minDistance = distance;
@@ -1219,8 +1161,8 @@ void AI::move() {
 						}
 						
 						//Finally, figure out which direction would move us least far away.
-						irr::core::vector2d< uint_fast8_t > destination;
-						if( noKeysLeft ) {
+						irr::core::vector2d< coordinate_t > destination;
+						if( headForGoal ) {
 							auto goal = mg->getGoal();
 							destination.X = goal->getX();
 							destination.Y = goal->getY();
@@ -1229,11 +1171,11 @@ void AI::move() {
 							destination.Y = mg->getCollectable( nearestCollectable )->getY();
 						}
 						
-						minDistance = UINT_FAST16_MAX; //Now we're reusing the minDistance variable to figure out which move will get us least far away
+						minDistance = UINT_FAST32_MAX; //Now we're reusing the minDistance variable to figure out which move will get us least far away
 						for( uint_fast8_t possibility = 0; possibility < possibleDirections.size(); ++possibility ) {
 							switch( possibleDirections.at( possibility ) ) {
 								case UP: {
-									decltype( minDistance ) distance = sqrt( pow( ( int_fast16_t ) currentPosition.X - ( int_fast16_t ) destination.X, 2 ) + pow( ( int_fast16_t ) currentPosition.Y - 1 - ( int_fast16_t ) destination.Y, 2 ) );
+									decltype( minDistance ) distance = sqrt( pow( ( int_fast32_t ) currentPosition.X - ( int_fast32_t ) destination.X, 2 ) + pow( ( int_fast32_t ) currentPosition.Y - 1 - ( int_fast32_t ) destination.Y, 2 ) );
 									if( distance <= minDistance ) {
 										minDistance = distance;
 										choice = UP;
@@ -1241,7 +1183,7 @@ void AI::move() {
 									break;
 								}
 								case DOWN: {
-									decltype( minDistance ) distance = sqrt( pow( ( int_fast16_t ) currentPosition.X - ( int_fast16_t ) destination.X, 2 ) + pow( ( int_fast16_t ) currentPosition.Y + 1 - ( int_fast16_t ) destination.Y, 2 ) );
+									decltype( minDistance ) distance = sqrt( pow( ( int_fast32_t ) currentPosition.X - ( int_fast32_t ) destination.X, 2 ) + pow( ( int_fast32_t ) currentPosition.Y + 1 - ( int_fast32_t ) destination.Y, 2 ) );
 									if( distance <= minDistance ) {
 										minDistance = distance;
 										choice = DOWN;
@@ -1249,7 +1191,7 @@ void AI::move() {
 									break;
 								}
 								case LEFT: {
-									decltype( minDistance ) distance = sqrt( pow( ( int_fast16_t ) currentPosition.X - 1 - ( int_fast16_t ) destination.X, 2 ) + pow( ( int_fast16_t ) currentPosition.Y - ( int_fast16_t ) destination.Y, 2 ) );
+									decltype( minDistance ) distance = sqrt( pow( ( int_fast32_t ) currentPosition.X - 1 - ( int_fast32_t ) destination.X, 2 ) + pow( ( int_fast32_t ) currentPosition.Y - ( int_fast32_t ) destination.Y, 2 ) );
 									if( distance <= minDistance ) {
 										minDistance = distance;
 										choice = LEFT;
@@ -1257,7 +1199,7 @@ void AI::move() {
 									break;
 								}
 								case RIGHT: {
-									decltype( minDistance ) distance = sqrt( pow( ( int_fast16_t ) currentPosition.X + 1 - ( int_fast16_t ) destination.X, 2 ) + pow( ( int_fast16_t ) currentPosition.Y - ( int_fast16_t ) destination.Y, 2 ) );
+									decltype( minDistance ) distance = sqrt( pow( ( int_fast32_t ) currentPosition.X + 1 - ( int_fast32_t ) destination.X, 2 ) + pow( ( int_fast32_t ) currentPosition.Y - ( int_fast32_t ) destination.Y, 2 ) );
 									if( distance <= minDistance ) {
 										minDistance = distance;
 										choice = RIGHT;
@@ -1269,7 +1211,7 @@ void AI::move() {
 						
 						switch( choice ) {
 							case UP: {
-								irr::core::position2d< uint_fast8_t > position( currentPosition.X, currentPosition.Y - 1 );
+								irr::core::position2d< coordinate_t > position( currentPosition.X, currentPosition.Y - 1 );
 								pathTaken.push_back( position );
 								for( decltype( pathsToLockedCells.size() ) o = 0; o < pathsToLockedCells.size(); ++o ) {
 									if( pathsToLockedCells.at( o ).back() not_eq position ) {
@@ -1281,7 +1223,7 @@ void AI::move() {
 								mg->movePlayerOnY( controlsPlayer, -1, false );
 							} break;
 							case DOWN: {
-								irr::core::position2d< uint_fast8_t > position( currentPosition.X, currentPosition.Y + 1 );
+								irr::core::position2d< coordinate_t > position( currentPosition.X, currentPosition.Y + 1 );
 								pathTaken.push_back( position );
 								for( decltype( pathsToLockedCells.size() ) o = 0; o < pathsToLockedCells.size(); ++o ) {
 									if( pathsToLockedCells.at( o ).back() not_eq position ) {
@@ -1293,7 +1235,7 @@ void AI::move() {
 								mg->movePlayerOnY( controlsPlayer, 1, false );
 							} break;
 							case LEFT: {
-								irr::core::position2d< uint_fast8_t > position( currentPosition.X - 1, currentPosition.Y );
+								irr::core::position2d< coordinate_t > position( currentPosition.X - 1, currentPosition.Y );
 								pathTaken.push_back( position );
 								for( decltype( pathsToLockedCells.size() ) o = 0; o < pathsToLockedCells.size(); ++o ) {
 									if( pathsToLockedCells.at( o ).back() not_eq position ) {
@@ -1305,7 +1247,7 @@ void AI::move() {
 								mg->movePlayerOnX( controlsPlayer, -1, false );
 							} break;
 							case RIGHT: {
-								irr::core::position2d< uint_fast8_t > position( currentPosition.X + 1, currentPosition.Y );
+								irr::core::position2d< coordinate_t > position( currentPosition.X + 1, currentPosition.Y );
 								pathTaken.push_back( position );
 								for( decltype( pathsToLockedCells.size() ) o = 0; o < pathsToLockedCells.size(); ++o ) {
 									if( pathsToLockedCells.at( o ).back() not_eq position ) {
@@ -1339,33 +1281,36 @@ void AI::move() {
 	}
 }
 
-bool AI::noOriginalLeftWall( uint_fast8_t x, uint_fast8_t y ) {
-	return( mg->getMazeManager()->maze[ x ][ y ].getOriginalLeft() == MazeCell::NONE or ( mg->getMazeManager()->maze[ x ][ y ].getOriginalLeft() == MazeCell::LOCK and mg->getMazeManager()->maze[ x ][ y ].getLeft() == MazeCell::NONE ) );
-}
-
-bool AI::noOriginalTopWall( uint_fast8_t x, uint_fast8_t y ) {
-	return( mg->getMazeManager()->maze[ x ][ y ].getOriginalTop() == MazeCell::NONE or ( mg->getMazeManager()->maze[ x ][ y ].getOriginalTop() == MazeCell::LOCK and mg->getMazeManager()->maze[ x ][ y ].getTop() == MazeCell::NONE ) );
-}
-
 void AI::reset() {
 	try {
 		noKeysLeft = false;
 		keyImSeeking = UINT_FAST8_MAX;
+		keyRoute.clear();
+		keyRoutePlanned = false;
 		IDDFSDepthLimit = 1;
+		nodesExpanded = 0;
 		hand = RIGHT; //Arbitrarily chosen direction
 		lastTimeMoved = 0;
 		solution.clear();
 		solved = false;
-		pretendCellsVisited.clear();
 		for( decltype( pathsToLockedCells.size() ) i = 0; i < pathsToLockedCells.size(); ++i ) {
 			pathsToLockedCells.at( i ).clear();
 		}
 		pathsToLockedCells.clear();
 		pathTaken.clear();
-		cellsVisited.clear();
+		{ //The constructor calls this before there's a maze
+			coordinate_t cols = 0;
+			coordinate_t rows = 0;
+			if( mg not_eq nullptr ) {
+				cols = mg->getMazeManager()->cols;
+				rows = mg->getMazeManager()->rows;
+			}
+			pretendCellsVisited.clear( cols, rows );
+			cellsVisited.clear( cols, rows );
+		}
 
 		if( startSolved and mg not_eq nullptr ) {
-			findSolution();
+			solveAgain();
 		}
 	} catch( std::exception &e ) {
 		std::wcerr << L"Error in AI::reset(): " << e.what() << std::endl;
@@ -1376,7 +1321,7 @@ void AI::setPlayer( uint_fast8_t newPlayer ) {
 	controlsPlayer = newPlayer;
 }
 
-void AI::setup( MainGame *newGM, bool newStartSolved, algorithm_t newAlgorithm, uint_fast16_t newMovementDelay ) {
+void AI::setup( Game *newGM, bool newStartSolved, algorithm_t newAlgorithm, uint_fast16_t newMovementDelay ) {
 	try {
 		movementDelay = newMovementDelay;
 		mg = newGM;
@@ -1388,6 +1333,20 @@ void AI::setup( MainGame *newGM, bool newStartSolved, algorithm_t newAlgorithm,
 	}
 }
 
+void AI::solveAgain() {
+	try {
+		planNumber += 1;
+		if( mg not_eq nullptr and mg->getBotPlanningPool() not_eq nullptr ) {
+			solved = false;
+			solution.clear(); //move() asks the pool for a new one
+		} else {
+			findSolution();
+		}
+	} catch( std::exception &e ) {
+		std::wcerr << L"Error in AI::solveAgain(): " << e.what() << std::endl;
+	}
+}
+
 std::wstring AI::stringFromAlgorithm( algorithm_t input ) {
 	switch( input ) {
 		case RANDOM_DEPTH_FIRST_SEARCH: {
@@ -1408,6 +1367,9 @@ std::wstring AI::stringFromAlgorithm( algorithm_t input ) {
 		case HEURISTIC_DEPTH_FIRST_SEARCH: {
 			return L"heuristic depth-first search";
 		}
+		case A_STAR: {
+			return L"a*";
+		}
 		default: {
 			return L"Unrecognized algorithm";
 		}
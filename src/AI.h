@@ -30,12 +30,13 @@
 #ifdef HAVE_VECTOR
 	#include <vector>
 #endif //HAVE_VECTOR
+#include "CellSet.h"
 #include "Collectable.h"
 #include "MazeCell.h"
 #include "PreprocessorCommands.h"
 
-//#include "MainGame.h"
-class MainGame; //Avoids circular dependency
+class BotPlanningPool; //Avoids circular dependency
+class Game; //Avoids circular dependency
 
 class AI {
 	public:
@@ -48,7 +49,7 @@ class AI {
 		 */
 		virtual ~AI();
 
-		enum algorithm_t : uint_fast8_t { RANDOM_DEPTH_FIRST_SEARCH, ITERATIVE_DEEPENING_DEPTH_FIRST_SEARCH, RIGHT_HAND_RULE, LEFT_HAND_RULE, DIJKSTRA, HEURISTIC_DEPTH_FIRST_SEARCH, ALGORITHM_DO_NOT_USE };
+		enum algorithm_t : uint_fast8_t { RANDOM_DEPTH_FIRST_SEARCH, ITERATIVE_DEEPENING_DEPTH_FIRST_SEARCH, RIGHT_HAND_RULE, LEFT_HAND_RULE, DIJKSTRA, HEURISTIC_DEPTH_FIRST_SEARCH, A_STAR, ALGORITHM_DO_NOT_USE };
 
 		/**
 		 * Returns the algorithm most closely matching a given string
@@ -69,6 +70,12 @@ class AI {
 		 */
 		bool doneWaiting();
 
+		/**
+		 * Used by cybrinth-sim to compare how much work each algorithm does.
+		 * @return how many cells this bot has looked at, while solving the maze or while deciding where to move next, since the last reset().
+		 */
+		uint_fast64_t getNodesExpanded() const;
+
 		/**
 		 * Used by MainGame to see which player this bot controls.
 		 * @return the number of the player controlled by this AI.
@@ -107,7 +114,7 @@ class AI {
 		 * @param newMovementDelay: The amount of time to wait between moves.
 		 */
 		//void setup( MazeCell ** newMaze, uint_fast8_t newCols, uint_fast8_t newRows, MainGame * newGM, bool newStartSolved, algorithm_t newAlgorithm, uint_fast16_t newMovementDelay );
-		void setup( MainGame * newGM, bool newStartSolved, algorithm_t newAlgorithm, uint_fast16_t newMovementDelay );
+		void setup( Game * newGM, bool newStartSolved, algorithm_t newAlgorithm, uint_fast16_t newMovementDelay );
 		/**
 		 * Given an algorithm, returns a string representation of the algorithm
 		 */
@@ -115,26 +122,47 @@ class AI {
 		
 	protected:
 	private:
+		friend class BotPlanningPool; ///< Copies what the bot knows to a worker thread, and the solution back
+		
 		algorithm_t algorithm;
 		/**
 		 * Used to keep track of whether a given position has really been visited.
 		 * @param position: The position in question.
 		 * @return a Boolean indicating whether this bot has already visited the given position.
 		 */
-		bool alreadyVisited( irr::core::position2d< uint_fast8_t > position );
+		bool alreadyVisited( irr::core::position2d< coordinate_t > position );
 		/**
 		 * Used when pre-solving the maze to keep track of whether we've already 'visited' a given position. Separate from alreadyVisited() because we have not actually visited anywhere yet.
 		 * @param position: The position in question.
 		 * @return a Boolean indicating whether this bot has already 'visited' the given position.
 		 */
-		bool alreadyVisitedPretend( irr::core::position2d< uint_fast8_t > position );
+		bool alreadyVisitedPretend( irr::core::position2d< coordinate_t > position );
+
+		/**
+		 * One entry in findSolutionAStar()'s open set.
+		 */
+		struct AStarNode {
+			uint32_t estimate; ///< Steps taken so far plus the Manhattan distance still to go.
+			uint32_t remaining; ///< Just the Manhattan distance. Of two nodes with the same estimate, the one nearer the target comes out first.
+			uint_fast32_t cell; ///< As returned by MazeGrid::index()
+		};
+		CellSet AStarClosed; ///< Cells findSolutionAStar() has already expanded: the start, the target, and nodes of the MazeManager's JunctionGraph.
+		std::vector< uint_fast32_t > AStarCameFrom; ///< For each cell in AStarReached, the cell it was reached from. Indexed the same way as MazeGrid.
+		std::vector< AStarNode > AStarOpen; ///< A binary heap, kept in order by std::push_heap() and std::pop_heap().
+		CellSet AStarReached; ///< Cells whose entries in AStarCameFrom, AStarSetOffGoing, and AStarStepsTaken belong to the current search. Kept between searches, like the vectors, so that solving again doesn't allocate anything.
+		std::vector< uint8_t > AStarSetOffGoing; ///< For each cell in AStarReached, which way the corridor to it leaves the cell in AStarCameFrom. A JunctionGraph::direction_t.
+		std::vector< uint32_t > AStarStepsTaken; ///< For each cell in AStarReached, the fewest steps found so far from the start.
 
-		std::vector< irr::core::position2d< uint_fast8_t > > cellsVisited; ///< A vector listing all the cells that have been visited so far.
+		CellSet cellsVisited; ///< All the cells that have been visited so far.
+		/**
+		 * Used by the algorithms which head straight for one place at a time. The first time it's called in each maze, it plans which order to pick up the keys in (see KeyOrderPlanner); after that it just goes down the list.
+		 * @return the position of the next key on the list which nobody has picked up yet, or the goal's position once there are none.
+		 */
+		irr::core::position2d< coordinate_t > chooseTarget();
 		uint_fast8_t controlsPlayer; ///< The number of the player controlled by this bot.
 
 		enum direction_t : uint_fast8_t { UP, DOWN, LEFT, RIGHT }; ///< Directions, duh.
 
-		std::vector< std::vector< uint_fast16_t > > DijkstraDistance;
 
 		/**
 		 * A wrapper for the other version of this function.
@@ -142,7 +170,7 @@ class AI {
 		 * @param y: the Y coordinate of the cell in question.
 		 * @return A Boolean indicating whether the player can move up/down through this maze cell's top.
 		 */
-		bool effectivelyNoTopWall( uint_fast8_t x, uint_fast8_t y );
+		bool effectivelyNoTopWall( coordinate_t x, coordinate_t y );
 		/**
 		 * Determines whether the player can move up/down through this maze cell's top.
 		 * @param x: the X coordinate of the cell in question.
@@ -150,14 +178,14 @@ class AI {
 		 * @param canDissolveWalls: A Boolean indicating whether this function should ignore soluble walls (not all walls are soluble).
 		 * @return A Boolean indicating whether the player can move up/down through this maze cell's top.
 		 */
-		bool effectivelyNoTopWall( uint_fast8_t x, uint_fast8_t y, bool canDissolveWalls );
+		bool effectivelyNoTopWall( coordinate_t x, coordinate_t y, bool canDissolveWalls );
 		/**
 		 * A wrapper for the other version of this function.
 		 * @param x: the X coordinate of the cell in question.
 		 * @param y: the Y coordinate of the cell in question.
 		 * @return A Boolean indicating whether the player can move left/right through this maze cell's left.
 		 */
-		bool effectivelyNoLeftWall( uint_fast8_t x, uint_fast8_t y );
+		bool effectivelyNoLeftWall( coordinate_t x, coordinate_t y );
 		/**
 		 * Determines whether the player can move left/right through this maze cell's left.
 		 * @param x: the X coordinate of the cell in question.
@@ -165,74 +193,89 @@ class AI {
 		 * @param canDissolveWalls: A Boolean indicating whether this function should ignore soluble walls (not all walls are soluble).
 		 * @return A Boolean indicating whether the player can move left/right through this maze cell's left.
 		 */
-		bool effectivelyNoLeftWall( uint_fast8_t x, uint_fast8_t y, bool canDissolveWalls );
+		bool effectivelyNoLeftWall( coordinate_t x, coordinate_t y, bool canDissolveWalls );
 
 		/**
 		 * Calls other solution-finding functions depending on the algorithm.
 		 */
 		void findSolution();
 		
+		/**
+		 * Finds a shortest solution using A*, guided by the Manhattan distance to the target. Searches the MazeManager's JunctionGraph rather than every cell, so whole corridors get skipped over in one go; the solution is filled in a cell at a time once the way has been found.
+		 * @param startPosition: the position from which to start searching.
+		 */
+		void findSolutionAStar( irr::core::position2d< coordinate_t > startPosition );
+
 		/**
 		 * @brief Finds a solution using a modified Depth-First search algorithm. Works by calling findSolutionIDDFS() with the max depth possible and the chooseBest argument set to true.
 		 * @param startPosition
 		 */
-		void findSolutionBFS( irr::core::position2d< uint_fast8_t > startPosition );
+		void findSolutionBFS( irr::core::position2d< coordinate_t > startPosition );
 		
 		/**
 		 * Finds a solution using Depth-First Search. Works by calling findSolutionIDDFS() with the max depth possible.
 		 * @param startPosition: the position from which to start searching.
 		 */
-		void findSolutionDFS( irr::core::position2d< uint_fast8_t > startPosition );
+		void findSolutionDFS( irr::core::position2d< coordinate_t > startPosition );
 
 		/**
-		 * Finds a solution using Dijkstra's algorithm
+		 * Finds a solution using Dijkstra's algorithm. Since every step costs the same, that's a breadth-first search, which the MazeManager's DistanceFields does once per target for all bots; following it to the target takes constant time per step.
 		 * @param startPosition: the position from which to start searching.
 		 */
-		void findSolutionDijkstra( irr::core::position2d< uint_fast8_t > startPosition );
+		void findSolutionDijkstra( irr::core::position2d< coordinate_t > startPosition );
 
 		/**
 		 * Finds a solution using the Iterative Deepening Depth-First Search algorithm. Does so by calling the other version of findSolutionIDDFS() over and over again with increasing depth limits.
 		 */
-		void findSolutionIDDFS( irr::core::position2d< uint_fast8_t > startPosition, bool chooseBest = false );
+		void findSolutionIDDFS( irr::core::position2d< coordinate_t > startPosition, bool chooseBest = false );
 		/**
-		 * Finds a solution using the Iterative Deepening Depth-First Search algorithm. Does so by calling the other version of findSolutionIDDFS() over and over again with increasing depth limits.
+		 * Searches every path from startPosition up to depthLimit steps long, setting the solution to the last one found which leads to a key or the goal. Keeps its own stack instead of recursing, so the path so far is shared rather than copied at each step and deep searches can't overflow the call stack.
+		 * @param chooseBest: whether to pick the first step by which way heads most directly toward the nearest collectable (or the goal), rather than at random.
 		 */
-		void findSolutionIDDFS( std::vector< irr::core::position2d< uint_fast8_t > > partialSolution, irr::core::position2d< uint_fast8_t > startPosition, uint_fast16_t depthLimit, bool canDissolveWalls, bool chooseBest = false );
+		void findSolutionIDDFS( irr::core::position2d< coordinate_t > startPosition, uint_fast32_t depthLimit, bool chooseBest );
 
-		MainGame * mg; ///< A pointer to the MainGame.
+		Game * mg; ///< A pointer to the MainGame, or whatever else is running the game.
 
 		direction_t hand; ///< Used in Right Hand Rule and Left Hand Rule
 
-		std::vector< irr::core::position2d< uint_fast8_t > > IDDFSDeadEnds;
-		uint_fast16_t IDDFSDepthLimit; ///< For use only when the bots don't know the solution.
-		bool IDDFSIsDeadEnd( irr::core::position2d< uint_fast8_t > position );
+		CellSet IDDFSDeadEnds;
+		/**
+		 * One level of the IDDFS stack, for the cell at the same place in IDDFSPath.
+		 */
+		struct IDDFSFrame {
+			direction_t directionsLeft[ 4 ]; ///< The ways out of the cell not tried yet, in the order they were found
+			uint_fast8_t numDirectionsLeft;
+			uint_fast32_t depthLeft; ///< How many more steps this iteration may take from the cell
+			bool canDissolveWalls;
+		};
+		std::vector< IDDFSFrame > IDDFSStack;
+		std::vector< irr::core::position2d< coordinate_t > > IDDFSPath; ///< The path from the start to the cell being looked at
+		uint_fast32_t IDDFSDepthLimit; ///< For use only when the bots don't know the solution.
+		bool IDDFSIsDeadEnd( irr::core::position2d< coordinate_t > position );
+
+		uint_fast32_t planNumber; ///< Goes up each time the bot's solution stops being any use, so that solutions asked of a BotPlanningPool before then get thrown away.
 
 		uint_fast8_t keyImSeeking; ///< When a key is found, see if it's this one. If so, look for a new key. Not used if we don't pre-solve the maze.
+		std::vector< irr::core::position2d< coordinate_t > > keyRoute; ///< The keys chooseTarget() still means to pick up, the next one at the back.
+		bool keyRoutePlanned; ///< Whether chooseTarget() has planned keyRoute for this maze yet.
 
 		uint_fast32_t lastTimeMoved; ///< The last time this bot moved.
 
 		uint_fast16_t movementDelay; ///< How long to delay between movements
 
+		uint_fast64_t nodesExpanded; ///< See getNodesExpanded().
+
 		bool noKeysLeft; ///< the IDDFS algorithm uses this to determine whether it should really deepen or just start with the max depth like DFS.
-		/**
-		 * Used by those algorithms which do not yet account for the fact that maze walls can be destroyed. Consider this function deprecated, as it will be removed if all algorithms are updated such that they no longer need it.
-		 * @param x: the X coordinate of the maze cell in question.
-		 * @param y: the Y coordinate of the maze cell in question.
-		 */
-		bool noOriginalLeftWall( uint_fast8_t x, uint_fast8_t y );
-		/**
-		 * Used by those algorithms which do not yet account for the fact that maze walls can be destroyed. Consider this function deprecated, as it will be removed if all algorithms are updated such that they no longer need it.
-		 * @param x: the X coordinate of the maze cell in question.
-		 * @param y: the Y coordinate of the maze cell in question.
-		 */
-		bool noOriginalTopWall( uint_fast8_t x, uint_fast8_t y );
 
-		std::vector< std::vector< irr::core::position2d< uint_fast8_t > > > pathsToLockedCells; ///< The paths from the current position to each locked cell found so far.
-		std::vector< irr::core::position2d< uint_fast8_t > > pathTaken; ///< The path taken so far. Some algorithms use this to backtrack.
-		std::vector< irr::core::position2d< uint_fast8_t > > pretendCellsVisited; ///< Cells 'visited' while pre-solving the maze.
-		std::vector< irr::core::position2d< uint_fast8_t > > pretendCellsUnvisited; ///< Cells 'unvisited' while pre-solving the maze. Used by Dijkstra's algorithm (more convenient than pretendCellsVisited)
+		std::vector< std::vector< irr::core::position2d< coordinate_t > > > pathsToLockedCells; ///< The paths from the current position to each locked cell found so far.
+		std::vector< irr::core::position2d< coordinate_t > > pathTaken; ///< The path taken so far. Some algorithms use this to backtrack.
+		CellSet pretendCellsVisited; ///< Cells 'visited' while pre-solving the maze.
 
-		std::vector< irr::core::position2d< uint_fast8_t > > solution; ///< A list of cells to visit in order to get from start to finish.
+		/**
+		 * Called whenever the solution needs working out again. If the game has a BotPlanningPool, the old solution is dropped and move() asks the pool for a new one; otherwise this calls findSolution() there and then.
+		 */
+		void solveAgain();
+		std::vector< irr::core::position2d< coordinate_t > > solution; ///< A list of cells to visit in order to get from start to finish.
 		bool solved; ///< Indicates whether the maze has been pre-solved.
 		bool startSolved; ///< Indicates whether the maze should be pre-solved.
 };
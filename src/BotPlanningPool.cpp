@@ -0,0 +1,272 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The BotPlanningPool class solves the maze for bots on a few background threads, so that big mazes or lots of bots don't freeze the game while they think. Each request works on its own copy of everything the bot looks at (a snapshot of the walls, the goal, the players, and the collectables), so nothing the game does in the meantime can get in its way. A bot waits where it is until its plan is ready.
+ */
+
+#include "BotPlanningPool.h"
+
+#ifdef HAVE_IOSTREAM
+	#include <iostream>
+#endif //HAVE_IOSTREAM
+#include <algorithm>
+
+BotPlanningPool::BotPlanningPool() {
+	try {
+		stopping = false;
+		uint_fast8_t numWorkers = std::max< unsigned int >( 2, std::thread::hardware_concurrency() ) - 1; //hardware_concurrency() is zero if it can't tell
+		for( decltype( numWorkers ) w = 0; w < numWorkers; ++w ) {
+			workers.push_back( std::thread( &BotPlanningPool::work, this ) );
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in BotPlanningPool::BotPlanningPool(): " << e.what() << std::endl;
+	}
+}
+
+BotPlanningPool::~BotPlanningPool() {
+	try {
+		{
+			std::lock_guard< std::mutex > lock( queueMutex );
+			stopping = true;
+		}
+		queueChanged.notify_all();
+
+		for( auto& worker : workers ) {
+			if( worker.joinable() ) {
+				worker.join();
+			}
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in BotPlanningPool::~BotPlanningPool(): " << e.what() << std::endl;
+	}
+}
+
+bool BotPlanningPool::takePlan( AI& bot ) {
+	try {
+		auto p = bot.controlsPlayer;
+		while( requests.size() <= p ) {
+			requests.push_back( std::unique_ptr< Request >( new Request() ) );
+			requests.back()->state = IDLE;
+		}
+		auto& request = *requests.at( p );
+
+		auto state = request.state.load( std::memory_order_acquire );
+		if( state == WORKING ) {
+			return false;
+		} else if( state == DONE ) {
+			request.state.store( IDLE, std::memory_order_relaxed );
+			if( request.planNumber == bot.planNumber ) {
+				auto& planner = request.planner;
+				bot.solution.swap( planner.solution );
+				bot.solved = planner.solved;
+				bot.startSolved = planner.startSolved;
+				bot.keyImSeeking = planner.keyImSeeking;
+				bot.keyRoute = planner.keyRoute;
+				bot.keyRoutePlanned = planner.keyRoutePlanned;
+				bot.nodesExpanded += planner.nodesExpanded;
+				return true;
+			} //Otherwise something has changed since the bot asked, so ask again
+		}
+
+		Game* mg = bot.mg;
+		auto& maze = mg->getMazeManager()->maze;
+		auto wallsVersion = maze.getWallsVersion(); //Brings the version numbers up to date before the walls get copied, so the workers only ever read the copy
+		auto layoutVersion = maze.getLayoutVersion();
+		if( latestMaze == nullptr or latestMaze->getWallsVersion() not_eq wallsVersion or latestMaze->getLayoutVersion() not_eq layoutVersion ) {
+			latestMaze = std::make_shared< const MazeGrid >( maze );
+		}
+
+		request.planNumber = bot.planNumber;
+		request.maze = latestMaze;
+		request.goalX = mg->getGoal()->getX();
+		request.goalY = mg->getGoal()->getY();
+		request.player.clear();
+		for( decltype( p ) i = 0; i <= p; ++i ) {
+			request.player.push_back( *mg->getPlayer( i ) );
+		}
+		request.stuff.clear();
+		for( decltype( mg->getNumCollectables() ) c = 0; c < mg->getNumCollectables(); ++c ) {
+			request.stuff.push_back( *mg->getCollectable( c ) );
+		}
+		request.seed = mg->getRandomNumber();
+		request.debug = mg->getDebugStatus();
+
+		auto& planner = request.planner;
+		planner.algorithm = bot.algorithm;
+		planner.startSolved = bot.startSolved;
+		planner.controlsPlayer = bot.controlsPlayer;
+		planner.noKeysLeft = bot.noKeysLeft;
+		planner.keyRoute = bot.keyRoute;
+		planner.keyRoutePlanned = bot.keyRoutePlanned;
+		planner.nodesExpanded = 0;
+
+		request.state.store( WORKING, std::memory_order_relaxed ); //The mutex below makes everything above visible to whichever worker takes it
+		{
+			std::lock_guard< std::mutex > lock( queueMutex );
+			queue.push_back( &request );
+		}
+		queueChanged.notify_one();
+		return false;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in BotPlanningPool::takePlan(): " << e.what() << std::endl;
+		return false;
+	}
+}
+
+void BotPlanningPool::work() {
+	try {
+		Snapshot snapshot;
+		while( true ) {
+			Request* request;
+			{
+				std::unique_lock< std::mutex > lock( queueMutex );
+				queueChanged.wait( lock, [ this ]() { return stopping or not queue.empty(); } );
+				if( stopping ) {
+					return;
+				}
+				request = queue.front();
+				queue.pop_front();
+			}
+
+			auto& maze = snapshot.mazeManager.maze;
+			if( maze.getWallsVersion() not_eq request->maze->getWallsVersion() or maze.getLayoutVersion() not_eq request->maze->getLayoutVersion() ) {
+				maze = *request->maze;
+				snapshot.mazeManager.cols = maze.getCols();
+				snapshot.mazeManager.rows = maze.getRows();
+			}
+			snapshot.goal.setX( request->goalX );
+			snapshot.goal.setY( request->goalY );
+			snapshot.player = request->player;
+			snapshot.stuff = request->stuff;
+			snapshot.randomNumberGenerator.seed( request->seed );
+			snapshot.debug = request->debug;
+
+			request->planner.mg = &snapshot;
+			request->planner.findSolution();
+			request->state.store( DONE, std::memory_order_release );
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in BotPlanningPool::work(): " << e.what() << std::endl;
+	}
+}
+
+BotPlanningPool::Snapshot::Snapshot() {
+	try {
+		debug = false;
+		randomSeed = 0;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in BotPlanningPool::Snapshot::Snapshot(): " << e.what() << std::endl;
+	}
+}
+
+BotPlanningPool::Snapshot::~Snapshot() {
+	try {
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in BotPlanningPool::Snapshot::~Snapshot(): " << e.what() << std::endl;
+	}
+}
+
+//Solving only looks at things, so most of these never get called
+void BotPlanningPool::Snapshot::botAlgorithmChanged() {
+}
+
+void BotPlanningPool::Snapshot::drawAll() {
+}
+
+void BotPlanningPool::Snapshot::eraseCollectable( uint_fast8_t item ) {
+	if( item < stuff.size() ) {
+		stuff.erase( stuff.begin() + item );
+	}
+}
+
+BotPlanningPool* BotPlanningPool::Snapshot::getBotPlanningPool() {
+	return nullptr;
+}
+
+Collectable* BotPlanningPool::Snapshot::getCollectable( uint_fast8_t collectable ) {
+	return &stuff.at( collectable );
+}
+
+bool BotPlanningPool::Snapshot::getDebugStatus() {
+	return debug;
+}
+
+Goal* BotPlanningPool::Snapshot::getGoal() {
+	return &goal;
+}
+
+float BotPlanningPool::Snapshot::getLoadingPercentage() {
+	return 100;
+}
+
+MazeManager* BotPlanningPool::Snapshot::getMazeManager() {
+	return &mazeManager;
+}
+
+uint_fast8_t BotPlanningPool::Snapshot::getNumCollectables() {
+	return stuff.size();
+}
+
+Player* BotPlanningPool::Snapshot::getPlayer( uint_fast8_t p ) {
+	return &player.at( p );
+}
+
+std::minstd_rand::result_type BotPlanningPool::Snapshot::getRandomNumber() {
+	return randomNumberGenerator();
+}
+
+std::minstd_rand::result_type BotPlanningPool::Snapshot::getRandomSeed() {
+	return randomSeed;
+}
+
+uint_fast32_t BotPlanningPool::Snapshot::getRealTime() {
+	return 0;
+}
+
+PlayerStart* BotPlanningPool::Snapshot::getStart( uint_fast8_t ) {
+	return nullptr;
+}
+
+bool BotPlanningPool::Snapshot::isConnected() {
+	return false;
+}
+
+void BotPlanningPool::Snapshot::movePlayerOnX( uint_fast8_t, int_fast8_t, bool ) {
+}
+
+void BotPlanningPool::Snapshot::movePlayerOnY( uint_fast8_t, int_fast8_t, bool ) {
+}
+
+void BotPlanningPool::Snapshot::musicSettingChanged() {
+}
+
+void BotPlanningPool::Snapshot::musicVolumeChanged() {
+}
+
+void BotPlanningPool::Snapshot::setLoadingPercentage( float ) {
+}
+
+void BotPlanningPool::Snapshot::setNumBots( uint_fast8_t ) {
+}
+
+void BotPlanningPool::Snapshot::setNumPlayers( uint_fast8_t ) {
+}
+
+void BotPlanningPool::Snapshot::setRandomSeed( std::minstd_rand::result_type newSeed ) {
+	randomSeed = newSeed;
+}
+
+void BotPlanningPool::Snapshot::showMessage( std::wstring, std::wstring ) {
+}
@@ -0,0 +1,138 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The BotPlanningPool class solves the maze for bots on a few background threads, so that big mazes or lots of bots don't freeze the game while they think. Each request works on its own copy of everything the bot looks at (a snapshot of the walls, the goal, the players, and the collectables), so nothing the game does in the meantime can get in its way. A bot waits where it is until its plan is ready.
+ */
+
+#ifndef BOTPLANNINGPOOL_H
+#define BOTPLANNINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#ifdef HAVE_VECTOR
+	#include <vector>
+#endif //HAVE_VECTOR
+#include "AI.h"
+#include "Collectable.h"
+#include "Game.h"
+#include "Goal.h"
+#include "Integers.h"
+#include "MazeGrid.h"
+#include "MazeManager.h"
+#include "Player.h"
+#include "PreprocessorCommands.h"
+
+class BotPlanningPool {
+	public:
+		/**
+		 * Constructor: Starts the worker threads, one fewer than the computer has cores (but at least one), so the game keeps a core to itself.
+		 */
+		BotPlanningPool();
+		/**
+		 * Destructor: Stops the worker threads and waits for them to finish whatever they're working on.
+		 */
+		virtual ~BotPlanningPool();
+
+		/**
+		 * Called by AI::move(), on the game's thread. If the plan the bot asked for is ready, hands it over: the bot gets the solution and everything else findSolution() worked out. Otherwise asks for one, unless one is already on the way. Never waits for the worker threads.
+		 * @return whether a plan was handed over. It can be empty if there was no way to the bot's target.
+		 */
+		bool takePlan( AI& bot );
+	protected:
+	private:
+		/**
+		 * Everything a bot looks at while solving, copied from the real game. Each worker thread has its own, so the distance fields and such in its MazeManager carry over from one request to the next as long as the walls don't change.
+		 */
+		class Snapshot : public Game {
+			public:
+				Snapshot();
+				virtual ~Snapshot();
+
+				void botAlgorithmChanged();
+				void drawAll();
+				void eraseCollectable( uint_fast8_t item );
+				/**
+				 * Returns nullptr, so that bots solving on a worker thread do it there and then.
+				 */
+				BotPlanningPool* getBotPlanningPool();
+				Collectable* getCollectable( uint_fast8_t collectable );
+				bool getDebugStatus();
+				Goal* getGoal();
+				float getLoadingPercentage();
+				MazeManager* getMazeManager();
+				uint_fast8_t getNumCollectables();
+				Player* getPlayer( uint_fast8_t p );
+				std::minstd_rand::result_type getRandomNumber();
+				std::minstd_rand::result_type getRandomSeed();
+				uint_fast32_t getRealTime();
+				PlayerStart* getStart( uint_fast8_t ps );
+				bool isConnected();
+				void movePlayerOnX( uint_fast8_t p, int_fast8_t direction, bool fromServer );
+				void movePlayerOnY( uint_fast8_t p, int_fast8_t direction, bool fromServer );
+				void musicSettingChanged();
+				void musicVolumeChanged();
+				void setLoadingPercentage( float newPercent );
+				void setNumBots( uint_fast8_t newNumBots );
+				void setNumPlayers( uint_fast8_t newNumPlayers );
+				void setRandomSeed( std::minstd_rand::result_type newSeed );
+				void showMessage( std::wstring title, std::wstring message );
+
+				bool debug;
+				Goal goal;
+				MazeManager mazeManager;
+				std::vector< Player > player;
+				std::minstd_rand randomNumberGenerator;
+				std::minstd_rand::result_type randomSeed;
+				std::vector< Collectable > stuff;
+		};
+
+		enum requestState_t : uint_fast8_t { IDLE, WORKING, DONE };
+		/**
+		 * One bot's request for a plan. Only the game's thread touches a request while it's IDLE or DONE, and only a worker thread while it's WORKING, so the plan gets handed back without any locking.
+		 */
+		struct Request {
+			std::atomic< uint_fast8_t > state; ///< A requestState_t
+			uint_fast32_t planNumber; ///< The bot's AI::planNumber when it asked. Plans for an older number are thrown away.
+			AI planner; ///< A copy of the bot's settings and what it knows, which does the solving.
+			std::shared_ptr< const MazeGrid > maze;
+			coordinate_t goalX;
+			coordinate_t goalY;
+			std::vector< Player > player;
+			std::vector< Collectable > stuff;
+			std::minstd_rand::result_type seed; ///< Bots which choose at random get their random numbers from this, drawn from the game's own random number generator.
+			bool debug;
+		};
+		std::vector< std::unique_ptr< Request > > requests; ///< One per player, made the first time a bot controlling that player asks for a plan. Only the game's thread uses this.
+		std::shared_ptr< const MazeGrid > latestMaze; ///< A copy of the walls as of the last request. Every request made until they change again shares it.
+
+		//Everything from here to the end is shared with the worker threads.
+		std::deque< Request* > queue;
+		std::mutex queueMutex;
+		std::condition_variable queueChanged;
+		bool stopping;
+		std::vector< std::thread > workers;
+
+		/**
+		 * A worker thread: takes requests off the queue and solves them, until the pool is destroyed.
+		 */
+		void work();
+};
+
+#endif // BOTPLANNINGPOOL_H
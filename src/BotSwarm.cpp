@@ -0,0 +1,196 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The BotSwarm class runs thousands of extra bots at once, for stress testing and for the screensaver. They don't play: they don't pick anything up or win, they just go around the same route (the start, each key, the goal, and back to the start) by following the MazeManager's shared distance fields. Each bot is only a position, a place on the route, and a time to move next, kept in one array per thing rather than one object per bot, so moving them all is one tight loop and drawing them all is one call to the video driver.
+ */
+
+#include "BotSwarm.h"
+
+#ifdef HAVE_IOSTREAM
+	#include <iostream>
+#endif //HAVE_IOSTREAM
+#include <algorithm>
+#include "Collectable.h"
+#include "colors.h"
+#include "DistanceFields.h"
+#include "MazeManager.h"
+
+BotSwarm::BotSwarm() {
+	try {
+		mg = nullptr;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in BotSwarm::BotSwarm(): " << e.what() << std::endl;
+	}
+}
+
+BotSwarm::~BotSwarm() {
+	try {
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in BotSwarm::~BotSwarm(): " << e.what() << std::endl;
+	}
+}
+
+void BotSwarm::reset( Game* newGame, uint_fast32_t numBots, uint_fast16_t movementDelay ) {
+	try {
+		mg = newGame;
+		route.clear();
+		x.clear();
+		y.clear();
+		nextStop.clear();
+		nextMoveTime.clear();
+
+		auto maze = mg->getMazeManager();
+		if( numBots == 0 or maze->rows == 0 or maze->cols == 0 ) {
+			return;
+		}
+		randomNumberGenerator.seed( mg->getRandomSeed() );
+
+		irr::core::position2d< coordinate_t > start( 0, 0 );
+		if( not maze->playerStart.empty() ) {
+			start = irr::core::position2d< coordinate_t >( maze->playerStart.at( 0 ).getX(), maze->playerStart.at( 0 ).getY() );
+		}
+		std::vector< irr::core::position2d< coordinate_t > > keys;
+		for( decltype( mg->getNumCollectables() ) c = 0; c < mg->getNumCollectables(); ++c ) {
+			auto collectable = mg->getCollectable( c );
+			if( collectable->getType() == Collectable::KEY ) {
+				keys.push_back( irr::core::position2d< coordinate_t >( collectable->getX(), collectable->getY() ) );
+			}
+		}
+		irr::core::position2d< coordinate_t > goal( mg->getGoal()->getX(), mg->getGoal()->getY() );
+
+		route.push_back( start );
+		auto keyOrder = maze->keyOrderPlanner.plan( maze->maze, maze->distanceFields, maze->treeDistances, start, keys, goal );
+		route.insert( route.end(), keyOrder.begin(), keyOrder.end() );
+		route.push_back( goal );
+		routeDistances.resize( route.size() );
+
+		x.resize( numBots );
+		y.resize( numBots );
+		nextStop.resize( numBots );
+		nextMoveTime.resize( numBots );
+
+		//Anywhere that can't reach the start can't reach the rest of the route either, so bots which would start there start at the start instead
+		auto& fromStart = maze->distanceFields.getDistances( maze->maze, start.X, start.Y, true );
+		auto time = mg->getRealTime();
+		for( decltype( numBots ) b = 0; b < numBots; ++b ) {
+			auto cell = randomNumberGenerator() % maze->maze.getNumCells();
+			if( fromStart[ cell ] == DistanceFields::UNREACHABLE ) {
+				x[ b ] = start.X;
+				y[ b ] = start.Y;
+			} else {
+				x[ b ] = cell % maze->cols;
+				y[ b ] = cell / maze->cols;
+			}
+			nextStop[ b ] = randomNumberGenerator() % route.size();
+			nextMoveTime[ b ] = time + randomNumberGenerator() % ( movementDelay + 1 );
+		}
+
+		indices.resize( numBots * 6 );
+		for( decltype( numBots ) b = 0; b < numBots; ++b ) {
+			irr::u32 corner = b * 4;
+			indices[ b * 6 + 0 ] = corner;
+			indices[ b * 6 + 1 ] = corner + 1;
+			indices[ b * 6 + 2 ] = corner + 2;
+			indices[ b * 6 + 3 ] = corner;
+			indices[ b * 6 + 4 ] = corner + 2;
+			indices[ b * 6 + 5 ] = corner + 3;
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in BotSwarm::reset(): " << e.what() << std::endl;
+	}
+}
+
+uint_fast32_t BotSwarm::move( uint_fast16_t movementDelay ) {
+	try {
+		if( x.empty() or route.empty() ) {
+			return 0;
+		}
+		auto maze = mg->getMazeManager();
+		auto& grid = maze->maze;
+
+		//Swarm bots don't carry keys, so locks don't stop them; otherwise every bot whose route went through one would wait at it forever.
+		//Looking up a field can make or patch it, which can move the others, so they're all brought up to date before holding on to any of them.
+		for( decltype( route.size() ) r = 0; r < route.size(); ++r ) {
+			maze->distanceFields.getDistances( grid, route[ r ].X, route[ r ].Y, true );
+		}
+		for( decltype( route.size() ) r = 0; r < route.size(); ++r ) {
+			routeDistances[ r ] = &maze->distanceFields.getDistances( grid, route[ r ].X, route[ r ].Y, true );
+		}
+
+		auto time = mg->getRealTime();
+		uint_fast32_t moved = 0;
+		for( decltype( x.size() ) b = 0; b < x.size(); ++b ) {
+			if( time >= nextMoveTime[ b ] ) {
+				nextMoveTime[ b ] = time + movementDelay;
+				if( DistanceFields::stepDown( grid, *routeDistances[ nextStop[ b ] ], x[ b ], y[ b ], true ) ) {
+					moved += 1;
+				} else { //Either it's there, or it can't get there from here. On to the next stop either way.
+					nextStop[ b ] = ( nextStop[ b ] + 1 ) % route.size();
+				}
+			}
+		}
+		return moved;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in BotSwarm::move(): " << e.what() << std::endl;
+		return 0;
+	}
+}
+
+void BotSwarm::draw( irr::IrrlichtDevice* device, uint_fast16_t cellWidth, uint_fast16_t cellHeight ) {
+	try {
+		if( x.empty() ) {
+			return;
+		}
+		auto driver = device->getVideoDriver();
+		irr::s32 width = std::max< irr::s32 >( 1, cellWidth / 2 );
+		irr::s32 height = std::max< irr::s32 >( 1, cellHeight / 2 );
+		irr::s32 insetX = ( cellWidth - width ) / 2;
+		irr::s32 insetY = ( cellHeight - height ) / 2;
+		auto colorOf = [ this ]( uint_fast32_t b ) {
+			return ( palette.empty() ? WHITE : palette[ b % palette.size() ] );
+		};
+
+		//Irrlicht's own renderers ignore 2D vertex lists, so those get one rectangle per bot instead
+		if( driver->getDriverType() == irr::video::EDT_SOFTWARE or driver->getDriverType() == irr::video::EDT_BURNINGSVIDEO ) {
+			for( decltype( x.size() ) b = 0; b < x.size(); ++b ) {
+				irr::core::position2d< irr::s32 > corner( x[ b ] * cellWidth + insetX, y[ b ] * cellHeight + insetY );
+				driver->draw2DRectangle( colorOf( b ), irr::core::rect< irr::s32 >( corner, irr::core::dimension2d< irr::s32 >( width, height ) ) );
+			}
+			return;
+		}
+
+		vertices.resize( x.size() * 4 );
+		for( decltype( x.size() ) b = 0; b < x.size(); ++b ) {
+			irr::f32 left = x[ b ] * cellWidth + insetX;
+			irr::f32 top = y[ b ] * cellHeight + insetY;
+			auto color = colorOf( b );
+			vertices[ b * 4 + 0 ] = irr::video::S3DVertex( left, top, 0, 0, 0, -1, color, 0, 0 );
+			vertices[ b * 4 + 1 ] = irr::video::S3DVertex( left + width, top, 0, 0, 0, -1, color, 1, 0 );
+			vertices[ b * 4 + 2 ] = irr::video::S3DVertex( left + width, top + height, 0, 0, 0, -1, color, 1, 1 );
+			vertices[ b * 4 + 3 ] = irr::video::S3DVertex( left, top + height, 0, 0, 0, -1, color, 0, 1 );
+		}
+
+		irr::video::SMaterial material; //No texture, so the vertices' colors are what gets drawn
+		material.Lighting = false;
+		driver->setMaterial( material );
+		driver->draw2DVertexPrimitiveList( vertices.data(), vertices.size(), indices.data(), x.size() * 2, irr::video::EVT_STANDARD, irr::scene::EPT_TRIANGLES, irr::video::EIT_32BIT );
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in BotSwarm::draw(): " << e.what() << std::endl;
+	}
+}
+
+void BotSwarm::setPalette( const std::vector< irr::video::SColor >& newPalette ) {
+	palette = newPalette;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The BotSwarm class runs thousands of extra bots at once, for stress testing and for the screensaver. They don't play: they don't pick anything up or win, they just go around the same route (the start, each key, the goal, and back to the start) by following the MazeManager's shared distance fields. Each bot is only a position, a place on the route, and a time to move next, kept in one array per thing rather than one object per bot, so moving them all is one tight loop and drawing them all is one call to the video driver.
+ */
+
+#ifndef BOTSWARM_H
+#define BOTSWARM_H
+
+#ifdef WINDOWS
+    #include <irrlicht.h>
+#else
+    #include <irrlicht/irrlicht.h>
+#endif
+#include <random>
+#ifdef HAVE_VECTOR
+	#include <vector>
+#endif //HAVE_VECTOR
+#include "Game.h"
+#include "Integers.h"
+#include "PreprocessorCommands.h"
+
+class BotSwarm {
+	public:
+		/**
+		 * Constructor: Does nothing. There are no bots until reset() is called.
+		 */
+		BotSwarm();
+		/**
+		 * Destructor: Does nothing.
+		 */
+		virtual ~BotSwarm();
+
+		/**
+		 * Works out the route for the maze the game is playing, and starts the given number of bots off on it, each at a random cell heading for a random stop. Called whenever a new maze starts.
+		 * @param movementDelay: the bots' first moves are spread out over this many milliseconds, so they don't all move at once.
+		 */
+		void reset( Game* newGame, uint_fast32_t numBots, uint_fast16_t movementDelay );
+		/**
+		 * Moves every bot whose turn it is one step toward its next stop.
+		 * @param movementDelay: how many milliseconds each bot waits between moves.
+		 * @return how many bots moved.
+		 */
+		uint_fast32_t move( uint_fast16_t movementDelay );
+		/**
+		 * Draws every bot as a small square in the middle of its cell.
+		 */
+		void draw( irr::IrrlichtDevice* device, uint_fast16_t cellWidth, uint_fast16_t cellHeight );
+		/**
+		 * Sets the colors the bots are drawn in: bot number b gets newPalette[ b % newPalette.size() ]. With no colors, they're drawn white.
+		 */
+		void setPalette( const std::vector< irr::video::SColor >& newPalette );
+		inline uint_fast32_t size() const { return x.size(); }
+	protected:
+	private:
+		Game* mg;
+		std::minstd_rand randomNumberGenerator; ///< Our own, so the swarm doesn't change what the game's random numbers would have been
+
+		/**
+		 * Where the bots go, in order: the first player start, the keys in the order KeyOrderPlanner picks, and the goal. After the goal comes the start again.
+		 */
+		std::vector< irr::core::position2d< coordinate_t > > route;
+		std::vector< const std::vector< uint32_t >* > routeDistances; ///< The distance field for each stop on the route. Looked up once per move() rather than once per bot.
+
+		//One entry per bot
+		std::vector< coordinate_t > x;
+		std::vector< coordinate_t > y;
+		std::vector< uint_fast16_t > nextStop; ///< An index into route
+		std::vector< uint_fast32_t > nextMoveTime; ///< See Game::getRealTime()
+
+		std::vector< irr::video::SColor > palette;
+		std::vector< irr::video::S3DVertex > vertices; ///< Four per bot, remade every time the bots are drawn
+		std::vector< irr::u32 > indices; ///< Six per bot (two triangles), which only change when the number of bots does
+};
+
+#endif // BOTSWARM_H
@@ -0,0 +1,60 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The CellSet class is a set of maze cells, such as the cells a bot has visited. Adding, removing, and checking for a cell all take constant time, and so does emptying the whole set.
+ */
+
+#include "CellSet.h"
+
+#ifdef HAVE_IOSTREAM
+	#include <iostream>
+#endif //HAVE_IOSTREAM
+
+CellSet::CellSet() {
+	try {
+		cols = 0;
+		rows = 0;
+		clearNumber = 1;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in CellSet::CellSet(): " << e.what() << std::endl;
+	}
+}
+
+CellSet::~CellSet() {
+	try {
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in CellSet::~CellSet(): " << e.what() << std::endl;
+	}
+}
+
+void CellSet::clear( coordinate_t newCols, coordinate_t newRows ) {
+	try {
+		if( newCols not_eq cols or newRows not_eq rows ) {
+			cols = newCols;
+			rows = newRows;
+			addedDuring.assign( static_cast< uint_fast32_t >( cols ) * rows, 0 );
+			clearNumber = 1;
+			return;
+		}
+
+		clearNumber += 1;
+		if( clearNumber == 0 ) { //Wrapped around, so cells added long ago could be mistaken for ones added since this clear
+			addedDuring.assign( addedDuring.size(), 0 );
+			clearNumber = 1;
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in CellSet::clear(): " << e.what() << std::endl;
+	}
+}
@@ -0,0 +1,78 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The CellSet class is a set of maze cells, such as the cells a bot has visited. Adding, removing, and checking for a cell all take constant time, and so does emptying the whole set.
+ */
+
+#ifndef CELLSET_H
+#define CELLSET_H
+
+#ifdef HAVE_VECTOR
+	#include <vector>
+#endif //HAVE_VECTOR
+#include "Integers.h"
+#include "PreprocessorCommands.h"
+
+class CellSet {
+	public:
+		/**
+		 * Constructor: makes an empty set which can't hold any cells until clear() gives it a size.
+		 */
+		CellSet();
+		/**
+		 * Destructor: Does nothing.
+		 */
+		virtual ~CellSet();
+
+		/**
+		 * Empties the set and makes it fit a maze of the given size. Only allocates memory if the size has changed.
+		 */
+		void clear( coordinate_t newCols, coordinate_t newRows );
+
+		inline coordinate_t getCols() const { return cols; }
+		inline coordinate_t getRows() const { return rows; }
+
+		/**
+		 * Cells outside the size given to clear() are never in the set.
+		 */
+		inline bool contains( coordinate_t x, coordinate_t y ) const { return x < cols and y < rows and addedDuring[ index( x, y ) ] == clearNumber; }
+		/**
+		 * Cells outside the size given to clear() are ignored.
+		 */
+		inline void insert( coordinate_t x, coordinate_t y ) {
+			if( x < cols and y < rows ) {
+				addedDuring[ index( x, y ) ] = clearNumber;
+			}
+		}
+		inline void erase( coordinate_t x, coordinate_t y ) {
+			if( x < cols and y < rows ) {
+				addedDuring[ index( x, y ) ] = 0;
+			}
+		}
+	protected:
+	private:
+		inline uint_fast32_t index( coordinate_t x, coordinate_t y ) const { return static_cast< uint_fast32_t >( y ) * cols + x; }
+
+		coordinate_t cols;
+		coordinate_t rows;
+
+		/**
+		 * Same idea as Reachability's searchNumber: a cell is in the set if its entry in addedDuring equals clearNumber, so clear() only has to change clearNumber. Two bytes per cell keep the set small enough for every bot to have its own on the largest mazes; the entries only need zeroing every 65,535 clears.
+		 */
+		uint16_t clearNumber;
+		std::vector< uint16_t > addedDuring;
+};
+
+#endif // CELLSET_H
@@ -0,0 +1,201 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The DistanceFields class knows how many steps it takes to get from any cell in the maze to each target (a key, acid, or the goal). Each target's distances get worked out once, with one breadth-first search, and are shared by every bot heading there. When walls get dissolved or unlocked, each field is patched up from the opened walls outward instead of being searched again, so it only costs as much as the number of cells which got closer. Following a field to its target takes constant time per step.
+ */
+
+#include "DistanceFields.h"
+
+#ifdef HAVE_IOSTREAM
+	#include <iostream>
+#endif //HAVE_IOSTREAM
+
+const uint32_t DistanceFields::UNREACHABLE;
+
+DistanceFields::DistanceFields() {
+	try {
+		cellsSearched = 0;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in DistanceFields::DistanceFields(): " << e.what() << std::endl;
+	}
+}
+
+DistanceFields::~DistanceFields() {
+	try {
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in DistanceFields::~DistanceFields(): " << e.what() << std::endl;
+	}
+}
+
+uint32_t DistanceFields::distance( const MazeGrid& maze, coordinate_t fromX, coordinate_t fromY, coordinate_t targetX, coordinate_t targetY, bool throughLocks ) {
+	try {
+		if( fromX >= maze.getCols() or fromY >= maze.getRows() or targetX >= maze.getCols() or targetY >= maze.getRows() ) {
+			return UNREACHABLE;
+		}
+		return fieldFor( maze, targetX, targetY, throughLocks ).distance[ maze.index( fromX, fromY ) ];
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in DistanceFields::distance(): " << e.what() << std::endl;
+		return UNREACHABLE;
+	}
+}
+
+const DistanceFields::Field& DistanceFields::fieldFor( const MazeGrid& maze, coordinate_t targetX, coordinate_t targetY, bool throughLocks ) {
+	auto target = maze.index( targetX, targetY );
+	auto layoutVersion = maze.getLayoutVersion(); //Before getWallChanges() gets looked at, since a new layout clears them
+	auto wallsVersion = maze.getWallsVersion();
+
+	decltype( fields.size() ) f = 0;
+	while( f < fields.size() and not ( fields[ f ].target == target and fields[ f ].throughLocks == throughLocks and fields[ f ].layoutVersion == layoutVersion ) ) {
+		++f;
+	}
+	if( f < fields.size() ) {
+		auto& field = fields[ f ];
+		if( field.wallsVersion == wallsVersion or repair( maze, field ) ) {
+			field.wallsVersion = wallsVersion;
+			return field;
+		}
+	} else {
+		//Not made yet. Reuse a field made for an earlier maze, if there is one, rather than holding on to it forever.
+		f = 0;
+		while( f < fields.size() and fields[ f ].layoutVersion == layoutVersion ) {
+			++f;
+		}
+		if( f == fields.size() ) {
+			fields.push_back( Field() );
+		}
+	}
+
+	auto& field = fields[ f ];
+	field.target = target;
+	field.wallsVersion = wallsVersion;
+	field.layoutVersion = layoutVersion;
+	field.wallChangesApplied = maze.getWallChanges().size();
+	field.throughLocks = throughLocks;
+	field.distance.assign( maze.getNumCells(), UNREACHABLE );
+
+	//Breadth-first from the target outward. Walls look the same from both sides, so the distance from the target to a cell is the distance from that cell to the target.
+	queue.clear();
+	queue.reserve( maze.getNumCells() );
+	field.distance[ target ] = 0;
+	queue.push_back( target );
+	spread( maze, field );
+
+	return field;
+}
+
+bool DistanceFields::repair( const MazeGrid& maze, Field& field ) {
+	auto& changes = maze.getWallChanges();
+	queue.clear();
+
+	auto relax = [ & ]( uint_fast32_t from, uint_fast32_t to ) {
+		if( field.distance[ from ] not_eq UNREACHABLE and field.distance[ from ] + 1 < field.distance[ to ] ) {
+			field.distance[ to ] = field.distance[ from ] + 1;
+			queue.push_back( to );
+		}
+	};
+
+	for( ; field.wallChangesApplied < changes.size(); ++field.wallChangesApplied ) {
+		auto& change = changes[ field.wallChangesApplied ];
+		if( ( change.left and change.x == 0 ) or ( not change.left and change.y == 0 ) ) { //The maze's outer border
+			continue;
+		}
+		if( not isOpen( change.left ? maze.getLeft( change.x, change.y ) : maze.getTop( change.x, change.y ), field.throughLocks ) ) {
+			return false;
+		}
+		auto here = maze.index( change.x, change.y );
+		auto there = ( change.left ? here - 1 : here - maze.getCols() );
+		relax( here, there );
+		relax( there, here );
+	}
+
+	//A cell can end up in the queue more than once if two opened walls both bring it closer; the second time it just doesn't change anything around it.
+	spread( maze, field );
+	return true;
+}
+
+void DistanceFields::spread( const MazeGrid& maze, Field& field ) {
+	auto cols = maze.getCols();
+	auto rows = maze.getRows();
+
+	auto reach = [ & ]( uint_fast32_t cell, uint32_t distance ) {
+		if( distance < field.distance[ cell ] ) {
+			field.distance[ cell ] = distance;
+			queue.push_back( cell );
+		}
+	};
+
+	for( decltype( queue.size() ) i = 0; i < queue.size(); ++i ) {
+		uint_fast32_t cell = queue[ i ];
+		coordinate_t x = cell % cols;
+		coordinate_t y = cell / cols;
+		uint32_t next = field.distance[ cell ] + 1;
+
+		if( y > 0 and isOpen( maze.getTop( x, y ), field.throughLocks ) ) {
+			reach( cell - cols, next );
+		}
+		if( y < rows - 1 and isOpen( maze.getTop( x, y + 1 ), field.throughLocks ) ) {
+			reach( cell + cols, next );
+		}
+		if( x > 0 and isOpen( maze.getLeft( x, y ), field.throughLocks ) ) {
+			reach( cell - 1, next );
+		}
+		if( x < cols - 1 and isOpen( maze.getLeft( x + 1, y ), field.throughLocks ) ) {
+			reach( cell + 1, next );
+		}
+	}
+	cellsSearched += queue.size();
+}
+
+uint_fast64_t DistanceFields::getCellsSearched() const {
+	return cellsSearched;
+}
+
+const std::vector< uint32_t >& DistanceFields::getDistances( const MazeGrid& maze, coordinate_t targetX, coordinate_t targetY, bool throughLocks ) {
+	return fieldFor( maze, targetX, targetY, throughLocks ).distance;
+}
+
+bool DistanceFields::stepToward( const MazeGrid& maze, coordinate_t& x, coordinate_t& y, coordinate_t targetX, coordinate_t targetY, bool throughLocks ) {
+	try {
+		if( x >= maze.getCols() or y >= maze.getRows() or targetX >= maze.getCols() or targetY >= maze.getRows() ) {
+			return false;
+		}
+
+		return stepDown( maze, fieldFor( maze, targetX, targetY, throughLocks ).distance, x, y, throughLocks );
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in DistanceFields::stepToward(): " << e.what() << std::endl;
+		return false;
+	}
+}
+
+bool DistanceFields::stepDown( const MazeGrid& maze, const std::vector< uint32_t >& distance, coordinate_t& x, coordinate_t& y, bool throughLocks ) {
+	auto here = distance[ maze.index( x, y ) ];
+	if( here == 0 or here == UNREACHABLE ) {
+		return false;
+	}
+
+	//In a maze where nothing has been dissolved there's only one way to go; after that, any neighbor one step closer is on a shortest path.
+	if( y > 0 and isOpen( maze.getTop( x, y ), throughLocks ) and distance[ maze.index( x, y - 1 ) ] == here - 1 ) {
+		y -= 1;
+	} else if( x > 0 and isOpen( maze.getLeft( x, y ), throughLocks ) and distance[ maze.index( x - 1, y ) ] == here - 1 ) {
+		x -= 1;
+	} else if( y < maze.getRows() - 1 and isOpen( maze.getTop( x, y + 1 ), throughLocks ) and distance[ maze.index( x, y + 1 ) ] == here - 1 ) {
+		y += 1;
+	} else if( x < maze.getCols() - 1 and isOpen( maze.getLeft( x + 1, y ), throughLocks ) and distance[ maze.index( x + 1, y ) ] == here - 1 ) {
+		x += 1;
+	} else {
+		return false; //Can't happen unless the field is out of date, which fieldFor() prevents
+	}
+	return true;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The DistanceFields class knows how many steps it takes to get from any cell in the maze to each target (a key, acid, or the goal). Each target's distances get worked out once, with one breadth-first search, and are shared by every bot heading there. When walls get dissolved or unlocked, each field is patched up from the opened walls outward instead of being searched again, so it only costs as much as the number of cells which got closer. Following a field to its target takes constant time per step.
+ */
+
+#ifndef DISTANCEFIELDS_H
+#define DISTANCEFIELDS_H
+
+#ifdef HAVE_VECTOR
+	#include <vector>
+#endif //HAVE_VECTOR
+#include "Integers.h"
+#include "MazeGrid.h"
+#include "PreprocessorCommands.h"
+
+class DistanceFields {
+	public:
+		/**
+		 * Constructor: Does nothing. Fields get made the first time they're asked for.
+		 */
+		DistanceFields();
+		/**
+		 * Destructor: Does nothing.
+		 */
+		virtual ~DistanceFields();
+
+		static const uint32_t UNREACHABLE = UINT32_MAX;
+
+		/**
+		 * Returns how many steps it takes to get from (fromX,fromY) to (targetX,targetY) without going through walls or locks, or UNREACHABLE.
+		 * @param throughLocks: whether to count locks as open, as they will be once all the keys have been found.
+		 */
+		uint32_t distance( const MazeGrid& maze, coordinate_t fromX, coordinate_t fromY, coordinate_t targetX, coordinate_t targetY, bool throughLocks = false );
+		/**
+		 * Finds the neighbor of (x,y) which is one step closer to the target.
+		 * @param throughLocks: as with distance().
+		 * @return false if (x,y) is the target or can't reach it, in which case x and y are left alone.
+		 */
+		bool stepToward( const MazeGrid& maze, coordinate_t& x, coordinate_t& y, coordinate_t targetX, coordinate_t targetY, bool throughLocks = false );
+		/**
+		 * Returns the whole field for a target: how many steps it takes to get there from each cell (indexed the same way as MazeGrid), or UNREACHABLE. For callers stepping lots of things toward the same few targets, who don't want to look the field up again for every step. It stays good until another field has to be made or patched, which can move it.
+		 */
+		const std::vector< uint32_t >& getDistances( const MazeGrid& maze, coordinate_t targetX, coordinate_t targetY, bool throughLocks = false );
+		/**
+		 * Like stepToward(), but using distances already returned by getDistances().
+		 */
+		static bool stepDown( const MazeGrid& maze, const std::vector< uint32_t >& distance, coordinate_t& x, coordinate_t& y, bool throughLocks = false );
+		/**
+		 * Returns how many cells have been searched to make fields, ever. Used by AI to count nodes expanded.
+		 */
+		uint_fast64_t getCellsSearched() const;
+	protected:
+	private:
+		struct Field {
+			uint_fast32_t target; ///< As returned by MazeGrid::index()
+			uint_fast64_t wallsVersion; ///< See MazeGrid::getWallsVersion()
+			uint_fast64_t layoutVersion; ///< See MazeGrid::getLayoutVersion()
+			std::vector< MazeGrid::WallChange >::size_type wallChangesApplied; ///< How much of MazeGrid::getWallChanges() has been patched in already
+			bool throughLocks;
+			std::vector< uint32_t > distance; ///< One per cell, indexed the same way as MazeGrid
+		};
+		/**
+		 * There's usually only a handful of targets at a time, so they're just searched in order. Fields made for an earlier maze get reused for new ones.
+		 */
+		std::vector< Field > fields;
+		std::vector< uint_fast32_t > queue;
+		uint_fast64_t cellsSearched;
+
+		/**
+		 * Returns the field for the given target, making it if it's missing or patching it if it's out of date.
+		 */
+		const Field& fieldFor( const MazeGrid& maze, coordinate_t targetX, coordinate_t targetY, bool throughLocks );
+		/**
+		 * Brings a field up to date with the walls changed since it was last made or patched. Opening a wall can only make cells closer, so only the cells which get closer are looked at: those beside the opened walls, then outward from them for as long as distances keep dropping.
+		 * @return false if a wall was put up instead, which can make cells farther away; the field has to be made over in that case.
+		 */
+		bool repair( const MazeGrid& maze, Field& field );
+		/**
+		 * Goes through the queue, giving each cell's open neighbors one more than the cell's distance if that's shorter than what they had, and adding those to the queue in turn.
+		 */
+		void spread( const MazeGrid& maze, Field& field );
+		static inline bool isOpen( MazeCell::border_t wall, bool throughLocks ) {
+			return wall == MazeCell::NONE or ( throughLocks and wall == MazeCell::LOCK );
+		}
+};
+
+#endif // DISTANCEFIELDS_H
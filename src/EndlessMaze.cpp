@@ -0,0 +1,207 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The EndlessMaze class makes a maze that never ends, for the screensaver and for leaving bots running for a long time. It uses Eller's algorithm, which builds a maze one row at a time and only needs to remember the row it's working on. The maze is cut into segments, each of which gets played as one level: the exit at the bottom of each segment leads to the entrance at the top of the next. Segments are generated ahead of time on a background thread, and thrown away once they've been played, so memory use stays the same no matter how long the game runs.
+ */
+
+#include "EndlessMaze.h"
+
+#include <algorithm>
+#ifdef HAVE_IOSTREAM
+	#include <iostream>
+#endif //HAVE_IOSTREAM
+
+EndlessMaze::EndlessMaze( coordinate_t newCols, std::minstd_rand::result_type seed, uint_fast8_t newSegmentsAhead ) {
+	try {
+		cols = newCols;
+		random.seed( seed );
+		nextEntryX = random() % cols;
+
+		setLabel.resize( cols );
+		parent.resize( cols );
+		firstWithLabel.assign( cols * 2, UINT_FAST32_MAX );
+		membersSeen.resize( cols );
+		chosenToGoDown.resize( cols );
+
+		segmentsAhead = std::max< decltype( segmentsAhead ) >( 1, newSegmentsAhead );
+		stopping = false;
+		worker = std::thread( &EndlessMaze::work, this ); //Last, so that everything the thread uses is already set up
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in EndlessMaze::EndlessMaze(): " << e.what() << std::endl;
+	}
+}
+
+EndlessMaze::~EndlessMaze() {
+	try {
+		{
+			std::lock_guard< std::mutex > lock( readyMutex );
+			stopping = true;
+		}
+		readyChanged.notify_all();
+
+		if( worker.joinable() ) {
+			worker.join();
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in EndlessMaze::~EndlessMaze(): " << e.what() << std::endl;
+	}
+}
+
+uint_fast32_t EndlessMaze::findRoot( uint_fast32_t column ) {
+	while( parent[ column ] not_eq column ) {
+		parent[ column ] = parent[ parent[ column ] ];
+		column = parent[ column ];
+	}
+	return column;
+}
+
+void EndlessMaze::generateSegment( Segment& segment ) {
+	try {
+		segment.rows = cols + ( random() % 5 ); //Same proportions as the mazes made by MazeManager::makeRandomLevel()
+		segment.entryX = nextEntryX;
+		segment.cells.assign( static_cast< uint_fast32_t >( cols ) * segment.rows, 0 );
+
+		//Every cell in the first row starts out in a set of its own
+		for( decltype( cols ) x = 0; x < cols; ++x ) {
+			setLabel[ x ] = cols + x;
+		}
+
+		for( decltype( segment.rows ) y = 0; y < segment.rows; ++y ) {
+			uint8_t* row = &segment.cells[ static_cast< uint_fast32_t >( y ) * cols ];
+			bool lastRow = ( y == segment.rows - 1 );
+
+			//Cells with the same label are already connected through the rows above
+			for( decltype( cols ) x = 0; x < cols; ++x ) {
+				if( firstWithLabel[ setLabel[ x ] ] == UINT_FAST32_MAX ) {
+					firstWithLabel[ setLabel[ x ] ] = x;
+				}
+				parent[ x ] = firstWithLabel[ setLabel[ x ] ];
+			}
+			for( decltype( cols ) x = 0; x < cols; ++x ) {
+				firstWithLabel[ setLabel[ x ] ] = UINT_FAST32_MAX;
+			}
+
+			//Randomly join neighboring cells that aren't connected yet. The last row joins all of them, so nothing is left cut off.
+			for( decltype( cols ) x = 1; x < cols; ++x ) {
+				uint_fast32_t leftRoot = findRoot( x - 1 );
+				uint_fast32_t rightRoot = findRoot( x );
+				if( leftRoot not_eq rightRoot and ( lastRow or random() % 2 == 0 ) ) {
+					parent[ rightRoot ] = leftRoot;
+					row[ x ] or_eq LEFT_OPEN;
+				}
+			}
+
+			if( not lastRow ) {
+				//Every set needs at least one way down, or it would be cut off from the rest of the maze. Pick one cell from each set (every member has the same chance), plus some more at random.
+				for( decltype( cols ) x = 0; x < cols; ++x ) {
+					membersSeen[ x ] = 0;
+				}
+				for( decltype( cols ) x = 0; x < cols; ++x ) {
+					uint_fast32_t root = findRoot( x );
+					membersSeen[ root ] += 1;
+					if( random() % membersSeen[ root ] == 0 ) {
+						chosenToGoDown[ root ] = x;
+					}
+				}
+
+				uint8_t* nextRow = row + cols;
+				for( decltype( cols ) x = 0; x < cols; ++x ) {
+					uint_fast32_t root = findRoot( x );
+					if( chosenToGoDown[ root ] == x or random() % 2 == 0 ) {
+						nextRow[ x ] or_eq TOP_OPEN;
+						setLabel[ x ] = root;
+					} else {
+						setLabel[ x ] = cols + x;
+					}
+				}
+			}
+		}
+
+		segment.exitX = random() % cols;
+		nextEntryX = segment.exitX;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in EndlessMaze::generateSegment(): " << e.what() << std::endl;
+	}
+}
+
+coordinate_t EndlessMaze::getCols() const {
+	return cols;
+}
+
+coordinate_t EndlessMaze::getNextSegmentRows() {
+	try {
+		std::unique_lock< std::mutex > lock( readyMutex );
+		readyChanged.wait( lock, [ this ]() { return not ready.empty(); } );
+		return ready.front().rows;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in EndlessMaze::getNextSegmentRows(): " << e.what() << std::endl;
+		return 0;
+	}
+}
+
+void EndlessMaze::takeSegment( MazeGrid& maze, coordinate_t& entryX, coordinate_t& exitX ) {
+	try {
+		Segment segment;
+		{
+			std::unique_lock< std::mutex > lock( readyMutex );
+			readyChanged.wait( lock, [ this ]() { return not ready.empty(); } );
+			segment = std::move( ready.front() );
+			ready.pop_front();
+		}
+		readyChanged.notify_all(); //Room for the background thread to make another one
+
+		entryX = segment.entryX;
+		exitX = segment.exitX;
+
+		for( decltype( segment.rows ) y = 0; y < segment.rows and y < maze.getRows(); ++y ) {
+			for( decltype( cols ) x = 0; x < cols and x < maze.getCols(); ++x ) {
+				uint8_t cell = segment.cells[ static_cast< uint_fast32_t >( y ) * cols + x ];
+				if( cell bitand LEFT_OPEN ) {
+					maze.setOriginalLeft( x, y, MazeCell::NONE );
+				}
+				if( cell bitand TOP_OPEN ) {
+					maze.setOriginalTop( x, y, MazeCell::NONE );
+				}
+			}
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in EndlessMaze::takeSegment(): " << e.what() << std::endl;
+	}
+}
+
+void EndlessMaze::work() {
+	try {
+		while( true ) {
+			{
+				std::unique_lock< std::mutex > lock( readyMutex );
+				readyChanged.wait( lock, [ this ]() { return stopping or ready.size() < segmentsAhead; } );
+				if( stopping ) {
+					return;
+				}
+			}
+
+			Segment segment;
+			generateSegment( segment ); //Outside the lock, so the game never waits on this unless it has run out of segments
+
+			{
+				std::lock_guard< std::mutex > lock( readyMutex );
+				ready.push_back( std::move( segment ) );
+			}
+			readyChanged.notify_all();
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in EndlessMaze::work(): " << e.what() << std::endl;
+	}
+}
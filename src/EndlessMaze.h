@@ -0,0 +1,104 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The EndlessMaze class makes a maze that never ends, for the screensaver and for leaving bots running for a long time. It uses Eller's algorithm, which builds a maze one row at a time and only needs to remember the row it's working on. The maze is cut into segments, each of which gets played as one level: the exit at the bottom of each segment leads to the entrance at the top of the next. Segments are generated ahead of time on a background thread, and thrown away once they've been played, so memory use stays the same no matter how long the game runs.
+ */
+
+#ifndef ENDLESSMAZE_H
+#define ENDLESSMAZE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <thread>
+#ifdef HAVE_VECTOR
+	#include <vector>
+#endif //HAVE_VECTOR
+#include "Integers.h"
+#include "MazeGrid.h"
+#include "PreprocessorCommands.h"
+
+class EndlessMaze {
+	public:
+		/**
+		 * Constructor: Starts generating segments on a background thread.
+		 * @param newCols: How wide the maze is. Every segment is this wide.
+		 * @param seed: The random seed. The same seed and width always make the same segments.
+		 * @param newSegmentsAhead: How many segments to have ready before the background thread stops and waits for some to be used.
+		 */
+		EndlessMaze( coordinate_t newCols, std::minstd_rand::result_type seed, uint_fast8_t newSegmentsAhead );
+		/**
+		 * Destructor: Stops the background thread and waits for it to finish.
+		 */
+		virtual ~EndlessMaze();
+
+		coordinate_t getCols() const;
+		/**
+		 * Returns how many rows the next segment has. Waits for the background thread if the segment isn't ready yet, which should only happen if segments are being used up faster than they can be generated.
+		 */
+		coordinate_t getNextSegmentRows();
+		/**
+		 * Knocks down walls in the given maze to match the next segment, then forgets the segment. The maze must already be getCols() by getNextSegmentRows() with every wall in place.
+		 * @param entryX: Set to the column where the segment's entrance is (in the top row). This is the same as the previous segment's exitX.
+		 * @param exitX: Set to the column where the segment's exit is (in the bottom row).
+		 */
+		void takeSegment( MazeGrid& maze, coordinate_t& entryX, coordinate_t& exitX );
+	protected:
+	private:
+		enum cellFlag_t : uint8_t { LEFT_OPEN = 1, TOP_OPEN = 2 };
+		struct Segment {
+			coordinate_t rows;
+			coordinate_t entryX;
+			coordinate_t exitX;
+			std::vector< uint8_t > cells; //Row-major, cellFlag_t bits
+		};
+
+		coordinate_t cols;
+
+		//Everything from here to the mutex is only used by the background thread.
+		std::minstd_rand random;
+		coordinate_t nextEntryX;
+		/**
+		 * Eller's algorithm only needs to know which set each cell in the current row belongs to. Labels below cols are sets carried down from the row above; labels from cols up are new sets, one per column.
+		 */
+		std::vector< uint_fast32_t > setLabel;
+		std::vector< uint_fast32_t > parent; //Union-find over the columns of the current row
+		std::vector< uint_fast32_t > firstWithLabel;
+		std::vector< uint_fast32_t > membersSeen;
+		std::vector< uint_fast32_t > chosenToGoDown;
+
+		/**
+		 * Finds the root of a column's set, halving the path along the way.
+		 */
+		uint_fast32_t findRoot( uint_fast32_t column );
+		/**
+		 * Generates a whole segment with Eller's algorithm. The last row joins all its sets together, so each segment is a perfect maze on its own.
+		 */
+		void generateSegment( Segment& segment );
+		/**
+		 * The background thread: generates segments until there are segmentsAhead of them ready, then waits until one is taken.
+		 */
+		void work();
+
+		std::deque< Segment > ready;
+		uint_fast8_t segmentsAhead;
+		std::mutex readyMutex;
+		std::condition_variable readyChanged;
+		bool stopping;
+		std::thread worker;
+};
+
+#endif // ENDLESSMAZE_H
@@ -0,0 +1,91 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The Game class is everything the AI, Player, MazeManager, and SettingsManager classes need from whatever is running the game. MainGame is the real game, with a window, music, and networking; HeadlessGame has none of those and is used by cybrinth-sim to run bot tournaments.
+ */
+
+#ifndef GAME_H
+#define GAME_H
+
+#include <random>
+#ifdef HAVE_STRING
+	#include <string>
+#endif //HAVE_STRING
+#include "Collectable.h"
+#include "Goal.h"
+#include "Integers.h"
+#include "PlayerStart.h"
+#include "PreprocessorCommands.h"
+
+class BotPlanningPool; //Avoids circular dependency
+class MazeManager; //Avoids circular dependency
+class Player; //Avoids circular dependency
+
+class Game {
+	public:
+		virtual ~Game() {}
+
+		/**
+		 * Called by SettingsManager when the bots' algorithm has changed, in case anything showing the settings needs updating.
+		 */
+		virtual void botAlgorithmChanged() = 0;
+		/**
+		 * Called by MazeManager while it makes a maze, so the loading screen can be redrawn.
+		 */
+		virtual void drawAll() = 0;
+		/**
+		 * Removes one item from stuff.
+		 */
+		virtual void eraseCollectable( uint_fast8_t item ) = 0;
+		/**
+		 * Returns the thread pool bots should solve the maze on, or nullptr if they should solve it straight away whenever they need to.
+		 */
+		virtual BotPlanningPool* getBotPlanningPool() = 0;
+		virtual Collectable* getCollectable( uint_fast8_t collectable ) = 0;
+		virtual bool getDebugStatus() = 0;
+		virtual Goal* getGoal() = 0;
+		virtual float getLoadingPercentage() = 0;
+		virtual MazeManager* getMazeManager() = 0;
+		virtual uint_fast8_t getNumCollectables() = 0;
+		virtual Player* getPlayer( uint_fast8_t p ) = 0;
+		virtual std::minstd_rand::result_type getRandomNumber() = 0;
+		virtual std::minstd_rand::result_type getRandomSeed() = 0;
+		/**
+		 * Returns a time in milliseconds which keeps counting even while the game is paused. Used by bots to wait between moves.
+		 */
+		virtual uint_fast32_t getRealTime() = 0;
+		virtual PlayerStart* getStart( uint_fast8_t ps ) = 0;
+		/**
+		 * Returns true if we're connected to other computers, in which case everybody has to be able to make the same maze from the same random seed.
+		 */
+		virtual bool isConnected() = 0;
+		virtual void movePlayerOnX( uint_fast8_t p, int_fast8_t direction, bool fromServer ) = 0;
+		virtual void movePlayerOnY( uint_fast8_t p, int_fast8_t direction, bool fromServer ) = 0;
+		/**
+		 * Called by SettingsManager to say the playMusic setting has been changed.
+		 */
+		virtual void musicSettingChanged() = 0;
+		virtual void musicVolumeChanged() = 0;
+		virtual void setLoadingPercentage( float newPercent ) = 0;
+		virtual void setNumBots( uint_fast8_t newNumBots ) = 0;
+		virtual void setNumPlayers( uint_fast8_t newNumPlayers ) = 0;
+		virtual void setRandomSeed( std::minstd_rand::result_type newSeed ) = 0;
+		/**
+		 * Tells the user something, such as whether a maze got saved.
+		 */
+		virtual void showMessage( std::wstring title, std::wstring message ) = 0;
+};
+
+#endif // GAME_H
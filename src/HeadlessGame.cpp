@@ -0,0 +1,418 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The HeadlessGame class plays mazes with nothing but bots in them: no window, no music, no network. It follows the same rules as MainGame (the same mazes from the same seeds, acid, keys and locks, the goal) so that cybrinth-sim can find out how the bots would do in the real game. Each HeadlessGame is independent of any other, so several can be run at once on different threads.
+ */
+
+#include "HeadlessGame.h"
+#include "CustomException.h"
+#include "StringConverter.h"
+
+#include <algorithm>
+#ifdef HAVE_IOSTREAM
+	#include <iostream>
+#endif //HAVE_IOSTREAM
+
+HeadlessGame::HeadlessGame() {
+	try {
+		startTime = std::chrono::steady_clock::now();
+		numKeysFound = 0;
+		numLocks = 0;
+		setRandomSeed( 0 );
+
+		settingsManager.setPointers( nullptr, this, &mazeManager, nullptr, nullptr, nullptr );
+		mazeManager.setPointers( this, &settingsManager );
+		mazeManager.showProgress = false; //There's no loading screen to update
+
+		settingsManager.setPlayMusic( false );
+		settingsManager.botMovementDelay = 0;
+		settingsManager.setNumPlayers( 1 );
+		settingsManager.setNumBots( 1 );
+	} catch( std::exception &e ) {
+		std::wcerr << L"Error in HeadlessGame::HeadlessGame(): " << e.what() << std::endl;
+	}
+}
+
+HeadlessGame::~HeadlessGame() {
+	try {
+	} catch( std::exception &e ) {
+		std::wcerr << L"Error in HeadlessGame::~HeadlessGame(): " << e.what() << std::endl;
+	}
+}
+
+//Nothing shows the settings, so there's nothing to update
+void HeadlessGame::botAlgorithmChanged() {
+}
+
+//There's nothing to draw on
+void HeadlessGame::drawAll() {
+}
+
+//Removes one item from stuff
+void HeadlessGame::eraseCollectable( uint_fast8_t item ) {
+	try {
+		if( item < stuff.size() ) {
+			stuff.erase( stuff.begin() + item );
+			for( decltype( player.size() ) p = 0; p < player.size(); ++p ) {
+				if( player.at( p ).hasItem() and player.at( p ).getItem() > item ) {
+					player.at( p ).giveItem( player.at( p ).getItem() - 1, player.at( p ).getItemType() );
+				}
+			}
+		}
+	} catch( std::exception &e ) {
+		std::wcerr << L"Error in HeadlessGame::eraseCollectable(): " << e.what() << std::endl;
+	}
+}
+
+BotPlanningPool* HeadlessGame::getBotPlanningPool() {
+	return nullptr;
+}
+
+Collectable* HeadlessGame::getCollectable( uint_fast8_t collectable ) {
+	try {
+		return &stuff.at( collectable );
+	} catch( std::exception &e ) {
+		std::wcerr << L"Error in HeadlessGame::getCollectable(): " << e.what() << std::endl;
+		return nullptr;
+	}
+}
+
+bool HeadlessGame::getDebugStatus() {
+	return settingsManager.debug;
+}
+
+Goal* HeadlessGame::getGoal() {
+	return &goal;
+}
+
+float HeadlessGame::getLoadingPercentage() {
+	return 0;
+}
+
+MazeManager* HeadlessGame::getMazeManager() {
+	return &mazeManager;
+}
+
+uint_fast8_t HeadlessGame::getNumCollectables() {
+	return stuff.size();
+}
+
+Player* HeadlessGame::getPlayer( uint_fast8_t p ) {
+	try {
+		return &player.at( p );
+	} catch( std::exception &e ) {
+		std::wcerr << L"Error in HeadlessGame::getPlayer(): " << e.what() << std::endl;
+		return nullptr;
+	}
+}
+
+std::minstd_rand::result_type HeadlessGame::getRandomNumber() {
+	return randomNumberGenerator();
+}
+
+std::minstd_rand::result_type HeadlessGame::getRandomSeed() {
+	return randomSeed;
+}
+
+//Milliseconds since this object was made
+uint_fast32_t HeadlessGame::getRealTime() {
+	return std::chrono::duration_cast< std::chrono::milliseconds >( std::chrono::steady_clock::now() - startTime ).count();
+}
+
+PlayerStart* HeadlessGame::getStart( uint_fast8_t ps ) {
+	try {
+		return &playerStart.at( ps );
+	} catch( std::exception &e ) {
+		std::wcerr << L"Error in HeadlessGame::getStart(): " << e.what() << std::endl;
+		return nullptr;
+	}
+}
+
+bool HeadlessGame::isConnected() {
+	return false;
+}
+
+void HeadlessGame::movePlayerCommon( uint_fast8_t p ) {
+	mazeManager.maze.setVisited( player.at( p ).getX(), player.at( p ).getY(), true );
+	if( player.at( p ).stepsTakenThisMaze % 2 == 0 ) {
+		mazeManager.maze.setVisitorColor( player.at( p ).getX(), player.at( p ).getY(), player.at( p ).getColorTwo() );
+	} else {
+		mazeManager.maze.setVisitorColor( player.at( p ).getX(), player.at( p ).getY(), player.at( p ).getColorOne() );
+	}
+	mazeManager.makeCellsVisible( player.at( p ).getX(), player.at( p ).getY() );
+}
+
+//Same rules as MainGame::movePlayerOnX(): acid dissolves any wall except acid-proof ones and locks, and the player only moves if there's no wall in the way
+void HeadlessGame::movePlayerOnX( uint_fast8_t p, int_fast8_t direction, bool ) {
+	try {
+		if( p >= player.size() or mazeManager.cols == 0 ) {
+			StringConverter sc;
+			throw CustomException( L"Player " + sc.toStdWString( p ) + L" does not exist or the maze is empty" );
+		}
+
+		auto x = player.at( p ).getX();
+		auto y = player.at( p ).getY();
+		if( direction < 0 ) {
+			if( x > 0 ) {
+				auto wall = mazeManager.maze.getLeft( x, y );
+				if( player.at( p ).hasItem() and player.at( p ).getItemType() == Collectable::ACID and wall not_eq MazeCell::ACIDPROOF and wall not_eq MazeCell::LOCK and wall not_eq MazeCell::NONE ) {
+					player.at( p ).removeItem();
+					mazeManager.maze.setLeft( x, y, MazeCell::NONE );
+				}
+
+				if( mazeManager.maze.getLeft( x, y ) == MazeCell::NONE ) {
+					player.at( p ).moveX( -1 );
+				}
+			}
+		} else {
+			if( x < mazeManager.cols - 1 ) {
+				auto wall = mazeManager.maze.getLeft( x + 1, y );
+				if( player.at( p ).hasItem() and player.at( p ).getItemType() == Collectable::ACID and wall not_eq MazeCell::ACIDPROOF and wall not_eq MazeCell::LOCK and wall not_eq MazeCell::NONE ) {
+					player.at( p ).removeItem();
+					mazeManager.maze.setLeft( x + 1, y, MazeCell::NONE );
+				}
+
+				if( mazeManager.maze.getLeft( x + 1, y ) == MazeCell::NONE ) {
+					player.at( p ).moveX( 1 );
+				}
+			}
+		}
+
+		movePlayerCommon( p );
+	} catch( std::exception &e ) {
+		std::wcerr << L"Error in HeadlessGame::movePlayerOnX(): " << e.what() << std::endl;
+	}
+}
+
+//Same rules as MainGame::movePlayerOnY()
+void HeadlessGame::movePlayerOnY( uint_fast8_t p, int_fast8_t direction, bool ) {
+	try {
+		if( p >= player.size() or mazeManager.rows == 0 ) {
+			StringConverter sc;
+			throw CustomException( L"Player " + sc.toStdWString( p ) + L" does not exist or the maze is empty" );
+		}
+
+		auto x = player.at( p ).getX();
+		auto y = player.at( p ).getY();
+		if( direction < 0 ) {
+			if( y > 0 ) {
+				auto wall = mazeManager.maze.getTop( x, y );
+				if( player.at( p ).hasItem() and player.at( p ).getItemType() == Collectable::ACID and wall not_eq MazeCell::ACIDPROOF and wall not_eq MazeCell::LOCK and wall not_eq MazeCell::NONE ) {
+					player.at( p ).removeItem();
+					mazeManager.maze.setTop( x, y, MazeCell::NONE );
+				}
+
+				if( mazeManager.maze.getTop( x, y ) == MazeCell::NONE ) {
+					player.at( p ).moveY( -1 );
+				}
+			}
+		} else {
+			if( y < mazeManager.rows - 1 ) {
+				auto wall = mazeManager.maze.getTop( x, y + 1 );
+				if( player.at( p ).hasItem() and player.at( p ).getItemType() == Collectable::ACID and wall not_eq MazeCell::ACIDPROOF and wall not_eq MazeCell::LOCK and wall not_eq MazeCell::NONE ) {
+					player.at( p ).removeItem();
+					mazeManager.maze.setTop( x, y + 1, MazeCell::NONE );
+				}
+
+				if( mazeManager.maze.getTop( x, y + 1 ) == MazeCell::NONE ) {
+					player.at( p ).moveY( 1 );
+				}
+			}
+		}
+
+		movePlayerCommon( p );
+	} catch( std::exception &e ) {
+		std::wcerr << L"Error in HeadlessGame::movePlayerOnY(): " << e.what() << std::endl;
+	}
+}
+
+//No music to play
+void HeadlessGame::musicSettingChanged() {
+}
+
+void HeadlessGame::musicVolumeChanged() {
+}
+
+void HeadlessGame::newMaze( std::minstd_rand::result_type newRandomSeed, coordinate_t newCols, coordinate_t newRows ) {
+	try {
+		stuff.clear();
+		numKeysFound = 0;
+		for( decltype( player.size() ) p = 0; p < player.size(); ++p ) {
+			playerStart.at( p ).reset();
+			player.at( p ).reset();
+		}
+		mazeManager.maze.clearVisited();
+
+		setRandomSeed( newRandomSeed );
+		mazeManager.setRandomSeed( newRandomSeed );
+		if( newCols > 0 and newRows > 0 ) {
+			mazeManager.makeRandomLevelOfSize( newCols, newRows );
+		} else {
+			mazeManager.makeRandomLevel();
+		}
+		randomNumberGenerator = mazeManager.getRandomNumberGenerator(); //Carry on from where the maze left off, same as MainGame does
+
+		//Same as MainGame::takeLevelFromMazeManager(), minus the textures
+		goal.setX( mazeManager.goalX );
+		goal.setY( mazeManager.goalY );
+		numLocks = mazeManager.numLocks;
+		stuff = mazeManager.stuff;
+		for( decltype( player.size() ) p = 0; p < player.size() and p < mazeManager.playerStart.size(); ++p ) {
+			playerStart.at( p ).setPos( mazeManager.playerStart.at( p ).getX(), mazeManager.playerStart.at( p ).getY() );
+			playerStart.at( p ).distanceFromExit = mazeManager.playerStart.at( p ).distanceFromExit;
+			player.at( p ).setPos( playerStart.at( p ).getX(), playerStart.at( p ).getY() );
+
+			mazeManager.maze.setVisited( playerStart.at( p ).getX(), playerStart.at( p ).getY(), true );
+			mazeManager.maze.setVisitorColor( playerStart.at( p ).getX(), playerStart.at( p ).getY(), player.at( p ).getColorTwo() );
+			mazeManager.makeCellsVisible( playerStart.at( p ).getX(), playerStart.at( p ).getY() );
+		}
+
+		//Bots which know the solution work it out here, so this counts as thinking time
+		botThinkingTime.assign( bot.size(), std::chrono::nanoseconds::zero() );
+		for( decltype( bot.size() ) b = 0; b < bot.size(); ++b ) {
+			auto started = std::chrono::steady_clock::now();
+			bot.at( b ).setup( this, settingsManager.botsKnowSolution, settingsManager.getBotAlgorithm(), settingsManager.botMovementDelay );
+			if( numLocks == 0 ) {
+				bot.at( b ).allKeysFound(); //Lets the bot know it doesn't need to search for keys
+			}
+			botThinkingTime.at( b ) += std::chrono::steady_clock::now() - started;
+		}
+	} catch( std::exception &e ) {
+		std::wcerr << L"Error in HeadlessGame::newMaze(): " << e.what() << std::endl;
+	}
+}
+
+void HeadlessGame::pickUpCollectables() {
+	try {
+		for( decltype( player.size() ) p = 0; p < player.size(); ++p ) {
+			for( decltype( stuff.size() ) s = 0; s < stuff.size(); ++s ) {
+				if( not stuff.at( s ).owned and player.at( p ).getX() == stuff.at( s ).getX() and player.at( p ).getY() == stuff.at( s ).getY() ) {
+					switch( stuff.at( s ).getType() ) {
+						case Collectable::ACID: {
+							player.at( p ).giveItem( s, stuff.at( s ).getType() );
+							break;
+						}
+						case Collectable::KEY: {
+							++numKeysFound;
+							player.at( p ).keysCollectedThisMaze += 1;
+							eraseCollectable( s );
+
+							if( numKeysFound >= numLocks ) {
+								mazeManager.maze.removeLocks();
+							}
+
+							//Bots which know the solution may have to find a new one now, which counts as thinking time
+							for( decltype( bot.size() ) b = 0; b < bot.size(); ++b ) {
+								auto started = std::chrono::steady_clock::now();
+								if( numKeysFound >= numLocks ) {
+									bot.at( b ).allKeysFound();
+								} else {
+									bot.at( b ).keyFound( s );
+								}
+								botThinkingTime.at( b ) += std::chrono::steady_clock::now() - started;
+							}
+							break;
+						}
+						default:
+							break;
+					}
+				}
+			}
+		}
+	} catch( std::exception &e ) {
+		std::wcerr << L"Error in HeadlessGame::pickUpCollectables(): " << e.what() << std::endl;
+	}
+}
+
+std::vector< HeadlessGame::BotResult > HeadlessGame::play( uint_fast64_t maxTurns ) {
+	std::vector< BotResult > results( bot.size() );
+	try {
+		if( maxTurns == 0 ) {
+			uint_fast64_t cells = static_cast< uint_fast64_t >( mazeManager.cols ) * mazeManager.rows;
+			maxTurns = cells * cells;
+		}
+
+		bool allAtGoal = false;
+		for( decltype( maxTurns ) turn = 0; turn < maxTurns and not allAtGoal; ++turn ) {
+			allAtGoal = true;
+			for( decltype( bot.size() ) b = 0; b < bot.size(); ++b ) {
+				if( not bot.at( b ).atGoal() ) {
+					auto started = std::chrono::steady_clock::now();
+					bot.at( b ).move();
+					botThinkingTime.at( b ) += std::chrono::steady_clock::now() - started;
+					allAtGoal = false;
+				}
+			}
+
+			pickUpCollectables();
+		}
+
+		for( decltype( bot.size() ) b = 0; b < bot.size(); ++b ) {
+			results.at( b ).reachedGoal = bot.at( b ).atGoal();
+			results.at( b ).steps = player.at( bot.at( b ).getPlayer() ).stepsTakenThisMaze;
+			results.at( b ).nodesExpanded = bot.at( b ).getNodesExpanded();
+			results.at( b ).thinkingTime = botThinkingTime.at( b );
+		}
+	} catch( std::exception &e ) {
+		std::wcerr << L"Error in HeadlessGame::play(): " << e.what() << std::endl;
+	}
+	return results;
+}
+
+void HeadlessGame::setLoadingPercentage( float ) {
+}
+
+//Bots control the last players, same as in MainGame
+void HeadlessGame::setNumBots( uint_fast8_t newNumBots ) {
+	try {
+		newNumBots = std::min< decltype( newNumBots ) >( newNumBots, player.size() );
+		bot.resize( newNumBots );
+		botThinkingTime.assign( newNumBots, std::chrono::nanoseconds::zero() );
+
+		for( decltype( player.size() ) p = 0; p < player.size(); ++p ) {
+			player.at( p ).isHuman = ( p < player.size() - newNumBots );
+		}
+		for( decltype( newNumBots ) b = 0; b < newNumBots; ++b ) {
+			bot.at( b ).setPlayer( player.size() - newNumBots + b );
+		}
+	} catch( std::exception &e ) {
+		std::wcerr << L"Error in HeadlessGame::setNumBots(): " << e.what() << std::endl;
+	}
+}
+
+void HeadlessGame::setNumPlayers( uint_fast8_t newNumPlayers ) {
+	try {
+		player.resize( newNumPlayers );
+		playerStart.resize( newNumPlayers );
+
+		for( decltype( newNumPlayers ) p = 0; p < newNumPlayers; ++p ) {
+			player.at( p ).setPlayerNumber( p );
+			player.at( p ).setMG( this );
+		}
+
+		setNumBots( bot.size() );
+	} catch( std::exception &e ) {
+		std::wcerr << L"Error in HeadlessGame::setNumPlayers(): " << e.what() << std::endl;
+	}
+}
+
+void HeadlessGame::setRandomSeed( std::minstd_rand::result_type newSeed ) {
+	randomSeed = newSeed;
+	randomNumberGenerator.seed( randomSeed );
+}
+
+void HeadlessGame::showMessage( std::wstring title, std::wstring message ) {
+	std::wcout << title << L": " << message << std::endl;
+}
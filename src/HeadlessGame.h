@@ -0,0 +1,134 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The HeadlessGame class plays mazes with nothing but bots in them: no window, no music, no network. It follows the same rules as MainGame (the same mazes from the same seeds, acid, keys and locks, the goal) so that cybrinth-sim can find out how the bots would do in the real game. Each HeadlessGame is independent of any other, so several can be run at once on different threads.
+ */
+
+#ifndef HEADLESSGAME_H
+#define HEADLESSGAME_H
+
+#include <chrono>
+#include <random>
+#ifdef HAVE_STRING
+	#include <string>
+#endif //HAVE_STRING
+#ifdef HAVE_VECTOR
+	#include <vector>
+#endif //HAVE_VECTOR
+#include "AI.h"
+#include "Collectable.h"
+#include "Game.h"
+#include "Goal.h"
+#include "Integers.h"
+#include "MazeManager.h"
+#include "Player.h"
+#include "PlayerStart.h"
+#include "PreprocessorCommands.h"
+#include "SettingsManager.h"
+
+class HeadlessGame : public Game {
+	public:
+		/**
+		 * Constructor: Sets up one player, which is a bot. Change the number of players and bots through settingsManager.
+		 */
+		HeadlessGame();
+		/**
+		 * Destructor: Does nothing.
+		 */
+		virtual ~HeadlessGame();
+
+		/**
+		 * What happened to one bot in one maze.
+		 */
+		struct BotResult {
+			bool reachedGoal;
+			uint_fast64_t steps; ///< How many moves the bot's player made.
+			uint_fast64_t nodesExpanded; ///< See AI::getNodesExpanded().
+			std::chrono::nanoseconds thinkingTime; ///< Time spent in the bot's own code (solving the maze and deciding where to move), not counting time spent moving the player.
+		};
+
+		void botAlgorithmChanged();
+		void drawAll();
+		void eraseCollectable( uint_fast8_t item );
+		/**
+		 * Returns nullptr: bots here solve the maze straight away, so that the same seed always gives the same game.
+		 */
+		BotPlanningPool* getBotPlanningPool();
+		Collectable* getCollectable( uint_fast8_t collectable );
+		bool getDebugStatus();
+		Goal* getGoal();
+		float getLoadingPercentage();
+		MazeManager* getMazeManager();
+		uint_fast8_t getNumCollectables();
+		Player* getPlayer( uint_fast8_t p );
+		std::minstd_rand::result_type getRandomNumber();
+		std::minstd_rand::result_type getRandomSeed();
+		uint_fast32_t getRealTime();
+		PlayerStart* getStart( uint_fast8_t ps );
+		bool isConnected();
+		void movePlayerOnX( uint_fast8_t p, int_fast8_t direction, bool fromServer );
+		void movePlayerOnY( uint_fast8_t p, int_fast8_t direction, bool fromServer );
+		void musicSettingChanged();
+		void musicVolumeChanged();
+		/**
+		 * Makes the maze that MainGame would make from the same seed and settings, and gets the bots ready to solve it using the "bots' solving algorithm" and "bots know the solution" settings.
+		 * @param newCols, newRows: If given, the maze is exactly this size instead (see MazeManager::makeRandomLevelOfSize()).
+		 */
+		void newMaze( std::minstd_rand::result_type newRandomSeed, coordinate_t newCols = 0, coordinate_t newRows = 0 );
+		/**
+		 * Lets the bots loose on the maze made by newMaze(). Each turn, every bot which hasn't reached the goal moves once, same as in each frame of MainGame::run().
+		 * @param maxTurns: Bots which still haven't reached the goal after this many turns give up. Zero means the number of cells in the maze, squared.
+		 * @return One result per bot.
+		 */
+		std::vector< BotResult > play( uint_fast64_t maxTurns );
+		void setLoadingPercentage( float newPercent );
+		void setNumBots( uint_fast8_t newNumBots );
+		void setNumPlayers( uint_fast8_t newNumPlayers );
+		void setRandomSeed( std::minstd_rand::result_type newSeed );
+		void showMessage( std::wstring title, std::wstring message );
+
+		SettingsManager settingsManager;
+	protected:
+	private:
+		std::vector< AI > bot;
+		std::vector< std::chrono::nanoseconds > botThinkingTime; ///< One per bot, since the last newMaze().
+
+		Goal goal;
+
+		MazeManager mazeManager;
+
+		/**
+		 * Anything that should be done when a player moves, whichever axis they move on. Same as MainGame::movePlayerCommon().
+		 */
+		void movePlayerCommon( uint_fast8_t p );
+
+		uint_fast8_t numKeysFound;
+		uint_fast8_t numLocks;
+
+		/**
+		 * Gives acid to, and takes keys for, any players standing on them. Same as the part of MainGame::run() which does this.
+		 */
+		void pickUpCollectables();
+		std::vector< Player > player;
+		std::vector< PlayerStart > playerStart;
+
+		std::minstd_rand randomNumberGenerator;
+		std::minstd_rand::result_type randomSeed;
+
+		std::chrono::steady_clock::time_point startTime;
+		std::vector< Collectable > stuff;
+};
+
+#endif // HEADLESSGAME_H
@@ -82,4 +82,15 @@
 	#define __int64_t_defined
 #endif
 
+//! The type used for maze coordinates and maze dimensions, everywhere from MazeManager to the network code. It must be unsigned and at least 16 bits wide. Define WIDE_COORDINATES when compiling to get 32-bit coordinates.
+#if defined WIDE_COORDINATES
+	typedef uint_fast32_t coordinate_t;
+	//! The largest usable coordinate. This can be smaller than the largest value coordinate_t can hold, since the fast types may be wider than asked for.
+	#define COORDINATE_MAX UINT32_MAX
+#else
+	typedef uint_fast16_t coordinate_t;
+	//! The largest usable coordinate. This can be smaller than the largest value coordinate_t can hold, since the fast types may be wider than asked for.
+	#define COORDINATE_MAX UINT16_MAX
+#endif
+
 #endif // INTEGERS_H_INCLUDED
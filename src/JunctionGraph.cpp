@@ -0,0 +1,169 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The JunctionGraph class is the maze with its corridors squashed flat. Most cells in a maze have exactly two openings, so there's only one way through them; the graph's nodes are the other cells (junctions and dead ends), and each edge is a whole corridor, weighted by its length. Searching the graph instead of the cells means looking at far fewer places.
+ */
+
+#include "JunctionGraph.h"
+
+#ifdef HAVE_IOSTREAM
+	#include <iostream>
+#endif //HAVE_IOSTREAM
+
+const uint32_t JunctionGraph::NOT_A_NODE;
+
+JunctionGraph::JunctionGraph() {
+	try {
+		layoutVersion = 0;
+		wallChangesApplied = 0;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in JunctionGraph::JunctionGraph(): " << e.what() << std::endl;
+	}
+}
+
+JunctionGraph::~JunctionGraph() {
+	try {
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in JunctionGraph::~JunctionGraph(): " << e.what() << std::endl;
+	}
+}
+
+uint32_t JunctionGraph::addNode( uint_fast32_t cell ) {
+	Node node;
+	node.cell = cell;
+	for( uint_fast8_t d = 0; d < NUM_DIRECTIONS; ++d ) {
+		node.neighbor[ d ] = NOT_A_NODE;
+		node.length[ d ] = 0;
+	}
+	nodes.push_back( node );
+	nodeOf[ cell ] = nodes.size() - 1;
+	return nodeOf[ cell ];
+}
+
+void JunctionGraph::connect( const MazeGrid& maze, uint32_t node ) {
+	for( uint_fast8_t d = 0; d < NUM_DIRECTIONS; ++d ) {
+		auto direction = static_cast< direction_t >( d );
+		if( isOpen( maze, nodes[ node ].cell, direction ) ) {
+			uint32_t steps;
+			auto end = follow( maze, nodes[ node ].cell, direction, nodes[ node ].cell, steps );
+			link( node, static_cast< direction_t >( d ), nodeOf[ end ], direction, steps );
+		} else {
+			nodes[ node ].neighbor[ d ] = NOT_A_NODE;
+			nodes[ node ].length[ d ] = 0;
+		}
+	}
+}
+
+void JunctionGraph::link( uint32_t from, direction_t leaving, uint32_t to, direction_t arriving, uint32_t length ) {
+	nodes[ from ].neighbor[ leaving ] = to;
+	nodes[ from ].length[ leaving ] = length;
+	auto back = static_cast< direction_t >( ( arriving + 2 ) % NUM_DIRECTIONS );
+	nodes[ to ].neighbor[ back ] = from;
+	nodes[ to ].length[ back ] = length;
+}
+
+uint_fast32_t JunctionGraph::follow( const MazeGrid& maze, uint_fast32_t cell, direction_t& direction, uint_fast32_t stopAt, uint32_t& steps, std::vector< irr::core::position2d< coordinate_t > >* path ) const {
+	auto start = cell;
+	steps = 0;
+	while( true ) {
+		cell = step( maze, cell, direction );
+		steps += 1;
+		if( path not_eq nullptr ) {
+			path->push_back( irr::core::position2d< coordinate_t >( cell % maze.getCols(), cell / maze.getCols() ) );
+		}
+		if( cell == stopAt or cell == start or nodeOf[ cell ] not_eq NOT_A_NODE ) {
+			return cell;
+		}
+
+		//Anything that isn't a node has exactly two ways out, and one of them is the way we came in
+		auto cameFrom = static_cast< direction_t >( ( direction + 2 ) % NUM_DIRECTIONS );
+		uint_fast8_t d = 0;
+		while( d == cameFrom or not isOpen( maze, cell, static_cast< direction_t >( d ) ) ) {
+			++d;
+		}
+		direction = static_cast< direction_t >( d );
+	}
+}
+
+bool JunctionGraph::isOpen( const MazeGrid& maze, uint_fast32_t cell, direction_t direction ) const {
+	coordinate_t x = cell % maze.getCols();
+	coordinate_t y = cell / maze.getCols();
+	if( direction == UP ) {
+		return y > 0 and maze.getTop( x, y ) == MazeCell::NONE;
+	} else if( direction == LEFT ) {
+		return x > 0 and maze.getLeft( x, y ) == MazeCell::NONE;
+	} else if( direction == DOWN ) {
+		return y < maze.getRows() - 1 and maze.getTop( x, y + 1 ) == MazeCell::NONE;
+	} else {
+		return x < maze.getCols() - 1 and maze.getLeft( x + 1, y ) == MazeCell::NONE;
+	}
+}
+
+void JunctionGraph::rebuild( const MazeGrid& maze ) {
+	nodes.clear();
+	nodeOf.assign( maze.getNumCells(), NOT_A_NODE );
+
+	for( decltype( maze.getNumCells() ) cell = 0; cell < maze.getNumCells(); ++cell ) {
+		uint_fast8_t ways = 0;
+		for( uint_fast8_t d = 0; d < NUM_DIRECTIONS; ++d ) {
+			if( isOpen( maze, cell, static_cast< direction_t >( d ) ) ) {
+				ways += 1;
+			}
+		}
+		if( ways not_eq 2 ) {
+			addNode( cell );
+		}
+	}
+
+	//Walk each corridor once, filling in both ends. Loops with no junctions on them never get walked, but nothing can get into one of those anyway.
+	for( decltype( nodes.size() ) n = 0; n < nodes.size(); ++n ) {
+		for( uint_fast8_t d = 0; d < NUM_DIRECTIONS; ++d ) {
+			auto direction = static_cast< direction_t >( d );
+			if( nodes[ n ].neighbor[ d ] == NOT_A_NODE and isOpen( maze, nodes[ n ].cell, direction ) ) {
+				uint32_t steps;
+				auto end = follow( maze, nodes[ n ].cell, direction, nodes[ n ].cell, steps );
+				link( n, static_cast< direction_t >( d ), nodeOf[ end ], direction, steps );
+			}
+		}
+	}
+}
+
+void JunctionGraph::update( const MazeGrid& maze ) {
+	try {
+		auto& changes = maze.getWallChanges();
+		if( maze.getLayoutVersion() not_eq layoutVersion or nodeOf.size() not_eq maze.getNumCells() ) {
+			layoutVersion = maze.getLayoutVersion();
+			rebuild( maze );
+			wallChangesApplied = changes.size();
+			return;
+		}
+
+		//Both cells beside each changed wall become nodes, so every corridor which went through the wall (or goes through it now) ends at one of them. Reconnecting those two nodes fixes up both ends of each such corridor.
+		for( ; wallChangesApplied < changes.size(); ++wallChangesApplied ) {
+			auto& change = changes[ wallChangesApplied ];
+			if( ( change.left and change.x == 0 ) or ( not change.left and change.y == 0 ) ) { //The maze's outer border
+				continue;
+			}
+			auto here = maze.index( change.x, change.y );
+			auto there = ( change.left ? here - 1 : here - maze.getCols() );
+			auto hereNode = ( nodeOf[ here ] == NOT_A_NODE ? addNode( here ) : nodeOf[ here ] );
+			auto thereNode = ( nodeOf[ there ] == NOT_A_NODE ? addNode( there ) : nodeOf[ there ] );
+			connect( maze, hereNode );
+			connect( maze, thereNode );
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in JunctionGraph::update(): " << e.what() << std::endl;
+	}
+}
@@ -0,0 +1,127 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The JunctionGraph class is the maze with its corridors squashed flat. Most cells in a maze have exactly two openings, so there's only one way through them; the graph's nodes are the other cells (junctions and dead ends), and each edge is a whole corridor, weighted by its length. Searching the graph instead of the cells means looking at far fewer places.
+ */
+
+#ifndef JUNCTIONGRAPH_H
+#define JUNCTIONGRAPH_H
+
+#ifdef WINDOWS
+    #include <irrlicht.h>
+#else
+    #include <irrlicht/irrlicht.h>
+#endif
+#ifdef HAVE_VECTOR
+	#include <vector>
+#endif //HAVE_VECTOR
+#include "Integers.h"
+#include "MazeGrid.h"
+#include "PreprocessorCommands.h"
+
+class JunctionGraph {
+	public:
+		/**
+		 * Constructor: Does nothing. The graph gets made the first time update() is called.
+		 */
+		JunctionGraph();
+		/**
+		 * Destructor: Does nothing.
+		 */
+		virtual ~JunctionGraph();
+
+		static const uint32_t NOT_A_NODE = UINT32_MAX;
+		/**
+		 * In the order the bots look around. Turning a direction around is adding two, modulo NUM_DIRECTIONS.
+		 */
+		enum direction_t : uint_fast8_t { UP, LEFT, DOWN, RIGHT, NUM_DIRECTIONS };
+
+		/**
+		 * Makes the graph match the maze's walls. After a new maze, that means starting over; after walls have been dissolved or unlocked, only the cells beside those walls become nodes and only the corridors through them get looked at again. Does nothing if the walls haven't changed.
+		 */
+		void update( const MazeGrid& maze );
+
+		/**
+		 * Returns the node at the given cell (as returned by MazeGrid::index()), or NOT_A_NODE if the cell is in the middle of a corridor.
+		 */
+		inline uint32_t nodeAt( uint_fast32_t cell ) const { return nodeOf[ cell ]; }
+		inline uint_fast32_t getCell( uint32_t node ) const { return nodes[ node ].cell; }
+		/**
+		 * Returns the node at the other end of the corridor leaving the given node in the given direction, or NOT_A_NODE if there's a wall that way. A corridor can lead back to the node it started from.
+		 */
+		inline uint32_t getNeighbor( uint32_t node, direction_t direction ) const { return nodes[ node ].neighbor[ direction ]; }
+		/**
+		 * Returns how many steps long the corridor leaving the given node in the given direction is.
+		 */
+		inline uint32_t getLength( uint32_t node, direction_t direction ) const { return nodes[ node ].length[ direction ]; }
+		inline uint_fast32_t getNumNodes() const { return nodes.size(); }
+
+		/**
+		 * Walks from a cell in the given direction, then along the corridor, until reaching a node, the cell stopAt, or the cell it started from (which only happens in a loop with no junctions on it).
+		 * @param direction: which way to set off. Set to the way the last step went.
+		 * @param steps: set to how many steps were taken.
+		 * @param path: if not null, every cell walked into is added to the end of it.
+		 * @return the cell where the walk stopped.
+		 */
+		uint_fast32_t follow( const MazeGrid& maze, uint_fast32_t cell, direction_t& direction, uint_fast32_t stopAt, uint32_t& steps, std::vector< irr::core::position2d< coordinate_t > >* path = nullptr ) const;
+		/**
+		 * Returns whether a player can walk from the cell in the given direction without going through a wall or lock.
+		 */
+		bool isOpen( const MazeGrid& maze, uint_fast32_t cell, direction_t direction ) const;
+	protected:
+	private:
+		struct Node {
+			uint32_t cell; ///< As returned by MazeGrid::index()
+			uint32_t neighbor[ NUM_DIRECTIONS ];
+			uint32_t length[ NUM_DIRECTIONS ];
+		};
+		std::vector< Node > nodes;
+		std::vector< uint32_t > nodeOf; ///< One per cell, indexed the same way as MazeGrid
+
+		uint_fast64_t layoutVersion; ///< See MazeGrid::getLayoutVersion()
+		std::vector< MazeGrid::WallChange >::size_type wallChangesApplied; ///< How much of MazeGrid::getWallChanges() has been patched in already
+
+		/**
+		 * Makes the cell a node, without connecting it to anything yet.
+		 */
+		uint32_t addNode( uint_fast32_t cell );
+		/**
+		 * Connects a node to whatever is at the end of each of its corridors, and those back to it.
+		 */
+		void connect( const MazeGrid& maze, uint32_t node );
+		/**
+		 * Records a corridor at both of its ends.
+		 * @param leaving: the way the corridor leaves from.
+		 * @param arriving: the way the corridor's last step goes, into to.
+		 */
+		void link( uint32_t from, direction_t leaving, uint32_t to, direction_t arriving, uint32_t length );
+		void rebuild( const MazeGrid& maze );
+		/**
+		 * Returns the cell one step away in the given direction. The caller has to make sure there is one.
+		 */
+		inline uint_fast32_t step( const MazeGrid& maze, uint_fast32_t cell, direction_t direction ) const {
+			if( direction == UP ) {
+				return cell - maze.getCols();
+			} else if( direction == LEFT ) {
+				return cell - 1;
+			} else if( direction == DOWN ) {
+				return cell + maze.getCols();
+			} else {
+				return cell + 1;
+			}
+		}
+};
+
+#endif // JUNCTIONGRAPH_H
@@ -0,0 +1,197 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The KeyOrderPlanner class decides which order to pick up the keys in, so that a bot's whole trip from where it starts, past every key, and on to the goal takes as few steps as possible. The distances between keys come from the MazeManager's TreeDistances without any searching, unless the maze has loops in it; then they come from its DistanceFields, one breadth-first search per key plus one for the goal. With only a few keys every order gets considered (the Held-Karp algorithm); with lots of them, a nearest-first route is improved until no reversed stretch of it would be any shorter (2-opt).
+ */
+
+#include "KeyOrderPlanner.h"
+
+#ifdef HAVE_IOSTREAM
+	#include <iostream>
+#endif //HAVE_IOSTREAM
+#include <algorithm>
+
+const uint_fast8_t KeyOrderPlanner::MAX_KEYS_FOR_BEST_ORDER;
+
+KeyOrderPlanner::KeyOrderPlanner() {
+	try {
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in KeyOrderPlanner::KeyOrderPlanner(): " << e.what() << std::endl;
+	}
+}
+
+KeyOrderPlanner::~KeyOrderPlanner() {
+	try {
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in KeyOrderPlanner::~KeyOrderPlanner(): " << e.what() << std::endl;
+	}
+}
+
+uint_fast64_t KeyOrderPlanner::leg( int_fast32_t from, int_fast32_t to ) const {
+	//Sums of these can't overflow, so a route through somewhere unreachable just comes out longer than any other
+	if( from < 0 ) {
+		return fromStart[ order[ to ] ];
+	} else if( static_cast< decltype( order.size() ) >( to ) == order.size() ) {
+		return toGoal[ order[ from ] ];
+	} else {
+		return between[ order[ from ] * reachableKeys.size() + order[ to ] ];
+	}
+}
+
+std::vector< irr::core::position2d< coordinate_t > > KeyOrderPlanner::plan( const MazeGrid& maze, DistanceFields& fields, TreeDistances& tree, irr::core::position2d< coordinate_t > start, const std::vector< irr::core::position2d< coordinate_t > >& keys, irr::core::position2d< coordinate_t > goal ) {
+	std::vector< irr::core::position2d< coordinate_t > > route;
+	try {
+		//In a maze with no loops, the tree knows every distance already; otherwise each key costs a search
+		tree.update( maze );
+		auto distance = [ & ]( irr::core::position2d< coordinate_t > from, irr::core::position2d< coordinate_t > to, bool throughLocks ) {
+			if( tree.isTree() ) {
+				return tree.distance( maze.index( from.X, from.Y ), maze.index( to.X, to.Y ), throughLocks );
+			}
+			return fields.distance( maze, from.X, from.Y, to.X, to.Y, throughLocks );
+		};
+
+		reachableKeys.clear();
+		fromStart.clear();
+		for( decltype( keys.size() ) k = 0; k < keys.size(); ++k ) {
+			auto steps = distance( start, keys[ k ], false );
+			if( steps not_eq DistanceFields::UNREACHABLE ) {
+				reachableKeys.push_back( keys[ k ] );
+				fromStart.push_back( steps );
+			}
+		}
+
+		auto numKeys = reachableKeys.size();
+		between.assign( numKeys * numKeys, 0 );
+		toGoal.resize( numKeys );
+		for( decltype( numKeys ) to = 0; to < numKeys; ++to ) {
+			for( decltype( numKeys ) from = 0; from < numKeys; ++from ) {
+				between[ from * numKeys + to ] = distance( reachableKeys[ from ], reachableKeys[ to ], false );
+			}
+		}
+		for( decltype( numKeys ) from = 0; from < numKeys; ++from ) {
+			toGoal[ from ] = distance( reachableKeys[ from ], goal, true );
+		}
+
+		if( numKeys <= MAX_KEYS_FOR_BEST_ORDER ) {
+			planBestOrder();
+		} else {
+			planGoodOrder();
+		}
+
+		for( decltype( order.size() ) i = 0; i < order.size(); ++i ) {
+			route.push_back( reachableKeys[ order[ i ] ] );
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in KeyOrderPlanner::plan(): " << e.what() << std::endl;
+	}
+	return route;
+}
+
+void KeyOrderPlanner::planBestOrder() {
+	auto numKeys = reachableKeys.size();
+	order.clear();
+	if( numKeys == 0 ) {
+		return;
+	}
+
+	uint_fast32_t allKeys = ( static_cast< uint_fast32_t >( 1 ) << numKeys ) - 1;
+	fewestSteps.resize( ( allKeys + 1 ) * numKeys ); //Entries for keys not in their own set never get looked at, so they can be left as they are
+	cameFrom.resize( ( allKeys + 1 ) * numKeys );
+
+	//Taking a key out of a set always makes a smaller number, so going through the sets in numerical order fills in everything each one is built from before it. All the keys can be reached from the start, so they can all be reached from each other too.
+	for( uint_fast32_t set = 1; set <= allKeys; ++set ) {
+		for( decltype( numKeys ) last = 0; last < numKeys; ++last ) {
+			auto lastBit = static_cast< uint_fast32_t >( 1 ) << last;
+			if( ( set bitand lastBit ) == 0 ) {
+				continue;
+			}
+
+			auto without = set bitand compl lastBit;
+			if( without == 0 ) {
+				fewestSteps[ set * numKeys + last ] = fromStart[ last ];
+				continue;
+			}
+
+			uint32_t best = DistanceFields::UNREACHABLE;
+			auto walks = &fewestSteps[ without * numKeys ];
+			auto toLast = &between[ last * numKeys ]; //Walls look the same from both sides, so this is also the distance from each key to last
+			for( decltype( numKeys ) previous = 0; previous < numKeys; ++previous ) {
+				if( ( without bitand ( static_cast< uint_fast32_t >( 1 ) << previous ) ) not_eq 0 and walks[ previous ] + toLast[ previous ] < best ) {
+					best = walks[ previous ] + toLast[ previous ];
+					cameFrom[ set * numKeys + last ] = previous;
+				}
+			}
+			fewestSteps[ set * numKeys + last ] = best;
+		}
+	}
+
+	decltype( numKeys ) last = 0;
+	uint_fast64_t best = UINT_FAST64_MAX;
+	for( decltype( numKeys ) k = 0; k < numKeys; ++k ) {
+		uint_fast64_t steps = static_cast< uint_fast64_t >( fewestSteps[ allKeys * numKeys + k ] ) + toGoal[ k ];
+		if( steps < best ) {
+			best = steps;
+			last = k;
+		}
+	}
+
+	order.resize( numKeys );
+	auto set = allKeys;
+	for( auto i = numKeys; i > 0; --i ) {
+		order[ i - 1 ] = last;
+		auto previous = cameFrom[ set * numKeys + last ];
+		set = set bitand compl ( static_cast< uint_fast32_t >( 1 ) << last );
+		last = previous;
+	}
+}
+
+void KeyOrderPlanner::planGoodOrder() {
+	auto numKeys = reachableKeys.size();
+	order.clear();
+
+	std::vector< bool > visited( numKeys, false );
+	for( decltype( numKeys ) i = 0; i < numKeys; ++i ) {
+		decltype( numKeys ) nearest = 0;
+		uint32_t nearestSteps = UINT32_MAX;
+		for( decltype( numKeys ) k = 0; k < numKeys; ++k ) {
+			auto steps = ( order.empty() ? fromStart[ k ] : between[ order.back() * numKeys + k ] );
+			if( not visited[ k ] and steps < nearestSteps ) {
+				nearest = k;
+				nearestSteps = steps;
+			}
+		}
+		visited[ nearest ] = true;
+		order.push_back( nearest );
+	}
+
+	//Walking a stretch of the route backwards takes just as many steps as walking it forwards, so reversing it only changes the two legs at its ends
+	int_fast32_t routeLength = order.size();
+	bool improved = true;
+	while( improved ) {
+		improved = false;
+		for( int_fast32_t first = 0; first < routeLength; ++first ) {
+			for( int_fast32_t last = first + 1; last < routeLength; ++last ) {
+				auto before = leg( first - 1, first ) + leg( last, last + 1 );
+				std::swap( order[ first ], order[ last ] ); //So that leg() sees the ends of the reversed stretch where they would be
+				auto after = leg( first - 1, first ) + leg( last, last + 1 );
+				std::swap( order[ first ], order[ last ] );
+				if( after < before ) {
+					std::reverse( order.begin() + first, order.begin() + last + 1 );
+					improved = true;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,85 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The KeyOrderPlanner class decides which order to pick up the keys in, so that a bot's whole trip from where it starts, past every key, and on to the goal takes as few steps as possible. The distances between keys come from the MazeManager's TreeDistances without any searching, unless the maze has loops in it; then they come from its DistanceFields, one breadth-first search per key plus one for the goal. With only a few keys every order gets considered (the Held-Karp algorithm); with lots of them, a nearest-first route is improved until no reversed stretch of it would be any shorter (2-opt).
+ */
+
+#ifndef KEYORDERPLANNER_H
+#define KEYORDERPLANNER_H
+
+#ifdef WINDOWS
+    #include <irrlicht.h>
+#else
+    #include <irrlicht/irrlicht.h>
+#endif
+#ifdef HAVE_VECTOR
+	#include <vector>
+#endif //HAVE_VECTOR
+#include "DistanceFields.h"
+#include "Integers.h"
+#include "MazeGrid.h"
+#include "PreprocessorCommands.h"
+#include "TreeDistances.h"
+
+class KeyOrderPlanner {
+	public:
+		/**
+		 * Constructor: Does nothing.
+		 */
+		KeyOrderPlanner();
+		/**
+		 * Destructor: Does nothing.
+		 */
+		virtual ~KeyOrderPlanner();
+
+		/**
+		 * With more keys than this, trying every order takes too much time and memory (the table grows as 2^keys), so plan() settles for a good order instead of the best one.
+		 */
+		static const uint_fast8_t MAX_KEYS_FOR_BEST_ORDER = 16;
+
+		/**
+		 * Works out which order to visit the keys in on the way from start to goal.
+		 * @param keys: where the keys are. The order doesn't matter.
+		 * @return the keys' positions in the order to visit them. Keys which can't be reached from start are left out.
+		 */
+		std::vector< irr::core::position2d< coordinate_t > > plan( const MazeGrid& maze, DistanceFields& fields, TreeDistances& tree, irr::core::position2d< coordinate_t > start, const std::vector< irr::core::position2d< coordinate_t > >& keys, irr::core::position2d< coordinate_t > goal );
+	protected:
+	private:
+		std::vector< irr::core::position2d< coordinate_t > > reachableKeys;
+		std::vector< uint32_t > fromStart; ///< One per reachable key
+		std::vector< uint32_t > between; ///< One per pair of reachable keys, indexed [ from * reachableKeys.size() + to ]
+		std::vector< uint32_t > toGoal; ///< One per reachable key, counting locks as open since they will be by then
+		std::vector< uint_fast32_t > order; ///< Indices into reachableKeys
+
+		std::vector< uint32_t > fewestSteps; ///< The Held-Karp table: for each set of keys (as a bitmask) and each key in it, the shortest walk from the start through all of them which ends at that key. Indexed [ set * reachableKeys.size() + last ].
+		std::vector< uint_fast8_t > cameFrom; ///< For each entry in fewestSteps, the key visited just before the last one
+
+		/**
+		 * Fills in order with the shortest route, by trying every order at once: each entry in fewestSteps is built from the entries for the same set minus its last key.
+		 */
+		void planBestOrder();
+		/**
+		 * Fills in order by always heading for the nearest key next, then reverses stretches of the route for as long as doing so makes it shorter.
+		 */
+		void planGoodOrder();
+		/**
+		 * The number of steps between two stops on the route: the start, a key, or the goal.
+		 * @param from: an index into order, or -1 for the start.
+		 * @param to: an index into order, or order.size() for the goal.
+		 */
+		uint_fast64_t leg( int_fast32_t from, int_fast32_t to ) const;
+};
+
+#endif // KEYORDERPLANNER_H
@@ -146,6 +146,24 @@ void MainGame::allPlayersReady( bool tf ) {
 	}
 }
 
+/**
+ * Dijkstra's algorithm and A* only work if bots know the solution beforehand, so the settings screen mustn't let anyone uncheck that box while it's chosen.
+ */
+void MainGame::botAlgorithmChanged() {
+	try {
+		if( not isNull( settingsScreen.botsKnowSolutionCheckBox ) ) {
+			if( settingsManager.getBotAlgorithm() == AI::DIJKSTRA or settingsManager.getBotAlgorithm() == AI::A_STAR ) {
+				settingsScreen.botsKnowSolutionCheckBox->setChecked( true );
+				settingsScreen.botsKnowSolutionCheckBox->setEnabled( false );
+			} else {
+				settingsScreen.botsKnowSolutionCheckBox->setEnabled( true );
+			}
+		}
+	} catch( std::exception &e ) {
+		std::wcerr << L"Error in MainGame::botAlgorithmChanged(): " << e.what() << std::endl;
+	}
+}
+
 /**
  * Draws everything onto the screen. Calls other draw functions, including those of objects.
  */
@@ -200,16 +218,16 @@ void MainGame::drawAll() {
 				
 				//Draws player trails ("footprints")
 				if( settingsManager.markTrails ) {
-					for( decltype( mazeManager.cols ) x = 0; x < mazeManager.cols; ++x ) { //It's inefficient to do this here and have similar nested loops below drawing the walls, but I want these drawn before the players, and the players drawn before the walls.
-						for( decltype( mazeManager.rows ) y = 0; y < mazeManager.rows; ++y ) {
-							if( mazeManager.maze[ x ][ y ].visited ) {
+					for( decltype( mazeManager.rows ) y = 0; y < mazeManager.rows; ++y ) { //It's inefficient to do this here and have similar nested loops below drawing the walls, but I want these drawn before the players, and the players drawn before the walls.
+						for( decltype( mazeManager.cols ) x = 0; x < mazeManager.cols; ++x ) { //Row by row, since that's the order MazeGrid stores cells in
+							if( mazeManager.maze.isVisited( x, y ) ) {
 								auto dotSize = cellWidth / 5;
 								
 								if( dotSize < 1 ) { //No point drawing these if they're less than a pixel big!
 									dotSize = 1;
 								}
 								
-								driver->draw2DRectangle( mazeManager.maze[ x ][ y ].getVisitorColor() , irr::core::rect< irr::s32 >( irr::core::position2d< irr::s32 >(( x * cellWidth ) + ( 0.5 * cellWidth ) - ( 0.5 * dotSize ), ( y * cellHeight ) + ( 0.5 * cellHeight ) - ( 0.5 * dotSize ) ), irr::core::dimension2d< irr::s32 >( dotSize, dotSize ) ) );
+								driver->draw2DRectangle( mazeManager.maze.getVisitorColor( x, y ) , irr::core::rect< irr::s32 >( irr::core::position2d< irr::s32 >(( x * cellWidth ) + ( 0.5 * cellWidth ) - ( 0.5 * dotSize ), ( y * cellHeight ) + ( 0.5 * cellHeight ) - ( 0.5 * dotSize ) ), irr::core::dimension2d< irr::s32 >( dotSize, dotSize ) ) );
 							}
 						}
 					}
@@ -219,6 +237,9 @@ void MainGame::drawAll() {
 					playerStart.at( ps ).draw( device, cellWidth, cellHeight );
 				}
 				
+				//The swarm goes underneath everybody who's actually playing
+				swarm.draw( device, cellWidth, cellHeight );
+				
 				//Drawing bots before human players makes it easier to play against large numbers of bots
 				for( decltype( settingsManager.getNumBots() ) i = 0; i < settingsManager.getNumBots(); ++i ) {
 					player.at( bot.at( i ).getPlayer() ).draw( device, cellWidth, cellHeight );
@@ -1409,6 +1430,20 @@ void MainGame::drawStats( uint_fast32_t textY ) {
 	}
 }
 
+/**
+ * Waits for the next maze to finish (if one is being made ahead of time) and throws it away.
+ */
+void MainGame::discardNextMaze() {
+	try {
+		if( nextMazeThread.joinable() ) {
+			nextMazeThread.join();
+		}
+		nextMaze.reset();
+	} catch ( std::exception &error ) {
+		std::wcerr << L"Error in discardNextMaze(): " << error.what() << std::endl;
+	}
+}
+
 /**
  * Removes one item from stuff.
  */
@@ -1434,6 +1469,13 @@ void MainGame::eraseCollectable( uint_fast8_t item ) {
 	}
 }
 
+/**
+ * Lets bots solve the maze on other threads, so the game doesn't freeze while they think.
+ */
+BotPlanningPool* MainGame::getBotPlanningPool() {
+	return &botPlanningPool;
+}
+
 /**
  * Lets other objects get a pointer to one of the collectables, probably to see if a player has touched one.
  * @param uint_fast8_t collectable: The number of the item desired.
@@ -1648,6 +1690,13 @@ std::minstd_rand::result_type MainGame::getRandomSeed() {
 	return randomSeed;
 }
 
+/**
+ * Lets objects see what time it is, even while the game is paused.
+ **/
+uint_fast32_t MainGame::getRealTime() {
+	return timer->getRealTime();
+}
+
 /**
  * Lets objects see what the screen size is.
  **/
@@ -1710,6 +1759,7 @@ void MainGame::initializeVariables( bool runAsScreenSaver ) {
 	scores = L"Scores: ";
 	scoresTotal = L"Total scores: ";
 	mazeManager.setPointers( this, &settingsManager );
+	nextMazeSeed = 0;
 	settingsManager.isServer = false;
 	antiAliasFonts = true;
 	currentExitConfirmation = 0;
@@ -1729,6 +1779,13 @@ void MainGame::initializeVariables( bool runAsScreenSaver ) {
 	enableController = false; //This gets set in setControls(), but only if that function gets called.
 }
 
+/**
+ * Lets other objects know whether this is a network game.
+ */
+bool MainGame::isConnected() {
+	return network.getConnectionStatus();
+}
+
 /**
  * Checks whether a pointer is equal to any of the values likely to represent null.
  * Arguments:
@@ -2400,7 +2457,7 @@ void MainGame::loadProTips() {
 
 
 /**
- * @brief Loads the random seed (used to generate mazes) from a file
+ * @brief Loads the random seed (used to generate mazes) from a file, along with the maze size, maze generator, and growing tree selection it was saved with. Turns off endless mazes, since those can't be saved.
  * @param src: the file to load
  * @return whether the file was read successfully
  */
@@ -2423,7 +2480,21 @@ bool MainGame::loadSeedFromFile( boost::filesystem::path src ) {
 			if( file.is_open() ) {
 				decltype( randomSeed ) newRandomSeed;
 				file >> newRandomSeed;
+				
+				//Files saved by older versions only have the seed, so they get made with the current preferences
+				coordinate_t newMazeSize;
+				if( file >> newMazeSize ) {
+					settingsManager.setMazeSize( newMazeSize );
+				}
+				uint_fast16_t newGenerator;
+				uint_fast16_t newPolicy;
+				if( file >> newGenerator >> newPolicy ) {
+					//Anything out of range becomes the DO_NOT_USE value, which the settings manager turns into the default, rather than wrapping around to some other generator
+					settingsManager.setMazeGenerator( static_cast< MazeGenerator::algorithm_t >( std::min< uint_fast16_t >( newGenerator, MazeGenerator::ALGORITHM_DO_NOT_USE ) ) );
+					settingsManager.setGrowingTreePolicy( static_cast< MazeGenerator::policy_t >( std::min< uint_fast16_t >( newPolicy, MazeGenerator::POLICY_DO_NOT_USE ) ) );
+				}
 				file.close();
+				settingsManager.setEndlessMazes( false ); //Endless mazes never get saved, and with them on the seed would be ignored
 				setRandomSeed( newRandomSeed );
 				return true;
 			} else {
@@ -2579,6 +2650,8 @@ MainGame::~MainGame() {
 			std::wcout << L"MainGame destructor called" << std::endl;
 		}
 		
+		discardNextMaze(); //Before anything it uses goes away
+		
 		if( not isNull( loadMazeDialog ) ) {
 			delete loadMazeDialog;
 		}
@@ -2664,6 +2737,7 @@ MainGame::MainGame( std::wstring fileToLoad = L"", bool runAsScreenSaver = false
 			setControls();
 		} else {
 			settingsManager.setPlayMusic( false );
+			settingsManager.setEndlessMazes( true ); //Nobody's watching the loading screen
 			
 			if( settingsManager.getNumBots() == 0 ) {
 				settingsManager.setNumBots( 1 );
@@ -2971,11 +3045,11 @@ void MainGame::makeMusicList() {
  * --- p: The player to move
  */
  void MainGame::movePlayerCommon( uint_fast8_t p ) {
-	mazeManager.maze[ player.at( p ).getX() ][ player.at( p ).getY() ].visited = true;
+	mazeManager.maze.setVisited( player.at( p ).getX(), player.at( p ).getY(), true );
 	if( player.at( p ).stepsTakenThisMaze % 2 == 0 ) {
-		mazeManager.maze[ player.at( p ).getX() ][ player.at( p ).getY() ].setVisitorColor( player.at( p ).getColorTwo() );
+		mazeManager.maze.setVisitorColor( player.at( p ).getX(), player.at( p ).getY(), player.at( p ).getColorTwo() );
 	} else {
-		mazeManager.maze[ player.at( p ).getX() ][ player.at( p ).getY() ].setVisitorColor( player.at( p ).getColorOne() );
+		mazeManager.maze.setVisitorColor( player.at( p ).getX(), player.at( p ).getY(), player.at( p ).getColorOne() );
 	}
 	mazeManager.makeCellsVisible( player.at( p ).getX(), player.at( p ).getY() );
 }
@@ -2996,21 +3070,21 @@ void MainGame::movePlayerOnX( uint_fast8_t p, int_fast8_t direction, bool fromSe
 		
 		if( settingsManager.getNumPlayers() > p and mazeManager.cols > 0 ) {
 			if( direction < 0 ) {
-				if( player.at( p ).hasItem() and player.at( p ).getItemType() == Collectable::ACID and player.at( p ).getX() > 0 and mazeManager.maze[ player.at( p ).getX() ][ player.at( p ).getY() ].getLeft() not_eq MazeCell::ACIDPROOF and mazeManager.maze[ player.at( p ).getX() ][ player.at( p ).getY() ].getLeft() not_eq MazeCell::LOCK  and mazeManager.maze[ player.at( p ).getX() ][ player.at( p ).getY() ].getLeft() not_eq MazeCell::NONE ) {
+				if( player.at( p ).hasItem() and player.at( p ).getItemType() == Collectable::ACID and player.at( p ).getX() > 0 and mazeManager.maze.getLeft( player.at( p ).getX(), player.at( p ).getY() ) not_eq MazeCell::ACIDPROOF and mazeManager.maze.getLeft( player.at( p ).getX(), player.at( p ).getY() ) not_eq MazeCell::LOCK  and mazeManager.maze.getLeft( player.at( p ).getX(), player.at( p ).getY() ) not_eq MazeCell::NONE ) {
 					player.at( p ).removeItem();
-					mazeManager.maze[ player.at( p ).getX() ][ player.at( p ).getY() ].setLeft( MazeCell::NONE );
+					mazeManager.maze.setLeft( player.at( p ).getX(), player.at( p ).getY(), MazeCell::NONE );
 				}
 
-				if( player.at( p ).getX() > 0 and mazeManager.maze[ player.at( p ).getX() ][ player.at( p ).getY() ].getLeft() == MazeCell::NONE ) {
+				if( player.at( p ).getX() > 0 and mazeManager.maze.getLeft( player.at( p ).getX(), player.at( p ).getY() ) == MazeCell::NONE ) {
 					player.at( p ).moveX( -1 );
 				}
 			} else {
-				if( player.at( p ).hasItem() and player.at( p ).getItemType() == Collectable::ACID and player.at( p ).getX() < ( mazeManager.cols - 1 ) and mazeManager.maze[ player.at( p ).getX() + 1 ][ player.at( p ).getY() ].getLeft() not_eq MazeCell::ACIDPROOF and mazeManager.maze[ player.at( p ).getX() + 1 ][ player.at( p ).getY() ].getLeft() not_eq MazeCell::LOCK and mazeManager.maze[ player.at( p ).getX() + 1 ][ player.at( p ).getY() ].getLeft() not_eq MazeCell::NONE ) {
+				if( player.at( p ).hasItem() and player.at( p ).getItemType() == Collectable::ACID and player.at( p ).getX() < ( mazeManager.cols - 1 ) and mazeManager.maze.getLeft( player.at( p ).getX() + 1, player.at( p ).getY() ) not_eq MazeCell::ACIDPROOF and mazeManager.maze.getLeft( player.at( p ).getX() + 1, player.at( p ).getY() ) not_eq MazeCell::LOCK and mazeManager.maze.getLeft( player.at( p ).getX() + 1, player.at( p ).getY() ) not_eq MazeCell::NONE ) {
 					player.at( p ).removeItem();
-					mazeManager.maze[ player.at( p ).getX() + 1 ][ player.at( p ).getY() ].setLeft( MazeCell::NONE );
+					mazeManager.maze.setLeft( player.at( p ).getX() + 1, player.at( p ).getY(), MazeCell::NONE );
 				}
 
-				if( player.at( p ).getX() < ( mazeManager.cols - 1 ) and mazeManager.maze[ player.at( p ).getX() + 1 ][ player.at( p ).getY() ].getLeft() == MazeCell::NONE ) {
+				if( player.at( p ).getX() < ( mazeManager.cols - 1 ) and mazeManager.maze.getLeft( player.at( p ).getX() + 1, player.at( p ).getY() ) == MazeCell::NONE ) {
 					player.at( p ).moveX( 1 );
 				}
 			}
@@ -3048,21 +3122,21 @@ void MainGame::movePlayerOnY( uint_fast8_t p, int_fast8_t direction, bool fromSe
 		
 		if( settingsManager.getNumPlayers() > p and mazeManager.rows > 0 ) {
 			if( direction < 0 ) {
-				if( player.at( p ).hasItem() and player.at( p ).getItemType() == Collectable::ACID and player.at( p ).getY() > 0 and mazeManager.maze[ player.at( p ).getX() ][ player.at( p ).getY() ].getTop() not_eq MazeCell::ACIDPROOF and mazeManager.maze[ player.at( p ).getX() ][ player.at( p ).getY() ].getTop() not_eq MazeCell::LOCK and mazeManager.maze[ player.at( p ).getX() ][ player.at( p ).getY() ].getTop() not_eq MazeCell::NONE ) {
+				if( player.at( p ).hasItem() and player.at( p ).getItemType() == Collectable::ACID and player.at( p ).getY() > 0 and mazeManager.maze.getTop( player.at( p ).getX(), player.at( p ).getY() ) not_eq MazeCell::ACIDPROOF and mazeManager.maze.getTop( player.at( p ).getX(), player.at( p ).getY() ) not_eq MazeCell::LOCK and mazeManager.maze.getTop( player.at( p ).getX(), player.at( p ).getY() ) not_eq MazeCell::NONE ) {
 					player.at( p ).removeItem();
-					mazeManager.maze[ player.at( p ).getX() ][ player.at( p ).getY() ].setTop( MazeCell::NONE );
+					mazeManager.maze.setTop( player.at( p ).getX(), player.at( p ).getY(), MazeCell::NONE );
 				}
 
-				if( player.at( p ).getY() > 0 and mazeManager.maze[ player.at( p ).getX() ][ player.at( p ).getY() ].getTop() == MazeCell::NONE ) {
+				if( player.at( p ).getY() > 0 and mazeManager.maze.getTop( player.at( p ).getX(), player.at( p ).getY() ) == MazeCell::NONE ) {
 					player.at( p ).moveY( -1 );
 				}
 			} else {
-				if( player.at( p ).hasItem() and player.at( p ).getItemType() == Collectable::ACID and player.at( p ).getY() < ( mazeManager.rows - 1 ) and mazeManager.maze[ player.at( p ).getX() ][ player.at( p ).getY() + 1 ].getTop() not_eq MazeCell::ACIDPROOF and mazeManager.maze[ player.at( p ).getX() ][ player.at( p ).getY() + 1 ].getTop() not_eq MazeCell::LOCK and mazeManager.maze[ player.at( p ).getX() ][ player.at( p ).getY() + 1 ].getTop() not_eq MazeCell::NONE ) {
+				if( player.at( p ).hasItem() and player.at( p ).getItemType() == Collectable::ACID and player.at( p ).getY() < ( mazeManager.rows - 1 ) and mazeManager.maze.getTop( player.at( p ).getX(), player.at( p ).getY() + 1 ) not_eq MazeCell::ACIDPROOF and mazeManager.maze.getTop( player.at( p ).getX(), player.at( p ).getY() + 1 ) not_eq MazeCell::LOCK and mazeManager.maze.getTop( player.at( p ).getX(), player.at( p ).getY() + 1 ) not_eq MazeCell::NONE ) {
 					player.at( p ).removeItem();
-					mazeManager.maze[ player.at( p ).getX() ][ player.at( p ).getY() + 1 ].setTop( MazeCell::NONE );
+					mazeManager.maze.setTop( player.at( p ).getX(), player.at( p ).getY() + 1, MazeCell::NONE );
 				}
 
-				if( player.at( p ).getY() < ( mazeManager.rows - 1 ) and mazeManager.maze[ player.at( p ).getX() ][ player.at( p ).getY() + 1 ].getTop() == MazeCell::NONE ) {
+				if( player.at( p ).getY() < ( mazeManager.rows - 1 ) and mazeManager.maze.getTop( player.at( p ).getX(), player.at( p ).getY() + 1 ) == MazeCell::NONE ) {
 					player.at( p ).moveY( 1 );
 				}
 			}
@@ -3150,6 +3224,11 @@ void MainGame::newMaze() {
 		
 		if( firstMaze ) {
 			newMaze( randomSeed );
+		} else if( nextMaze ) { //Already picked and hopefully already made
+			if( nextMazeThread.joinable() ) { //If the seed is being screened, it isn't picked until the thread is done
+				nextMazeThread.join();
+			}
+			newMaze( nextMazeSeed );
 		} else {
 			newMaze( getRandomNumber() );
 		}
@@ -3197,10 +3276,31 @@ void MainGame::newMaze( std::minstd_rand::result_type newRandomSeed ) {
 		resetThings();
 		setRandomSeed( newRandomSeed );
 		
-		mazeManager.makeRandomLevel();
+		bool madeAhead = false;
+		if( nextMaze ) {
+			if( nextMazeThread.joinable() ) {
+				nextMazeThread.join();
+			}
+			madeAhead = ( nextMazeSeed == newRandomSeed and nextMaze->madeWithSettings( mazeManager.getCurrentSettings() ) );
+			if( madeAhead ) {
+				mazeManager.swapLevel( *nextMaze );
+				mazeManager.printDebugLog(); //Saved up by the other thread
+			}
+			nextMaze.reset();
+		}
 		
-		cellWidth = ( viewportSize.Width ) / mazeManager.cols;
-		cellHeight = ( viewportSize.Height ) / mazeManager.rows;
+		if( madeAhead ) {
+			loadingDelay = 0; //The whole point of making the maze ahead of time is to not keep anyone waiting
+		} else {
+			mazeManager.setRandomSeed( newRandomSeed );
+			mazeManager.makeRandomLevel();
+		}
+		
+		randomNumberGenerator = mazeManager.getRandomNumberGenerator(); //Carry on from where the maze left off, as if we'd made it ourselves
+		takeLevelFromMazeManager();
+		
+		cellWidth = std::max< decltype( cellWidth ) >( 1, ( viewportSize.Width ) / mazeManager.cols ); //Mazes can have more cells than the screen has pixels. They won't look good, but at least the cells won't have zero size.
+		cellHeight = std::max< decltype( cellHeight ) >( 1, ( viewportSize.Height ) / mazeManager.rows );
 		for( decltype( settingsManager.getNumBots() ) b = 0; b < settingsManager.getNumBots(); ++b ) {
 			bot.at( b ).setup( this, settingsManager.botsKnowSolution, settingsManager.getBotAlgorithm(), settingsManager.botMovementDelay );
 		}
@@ -3211,8 +3311,19 @@ void MainGame::newMaze( std::minstd_rand::result_type newRandomSeed ) {
 			}
 		}
 		
+		{
+			std::vector< irr::video::SColor > palette;
+			for( uint_fast8_t c = 1; c < NUMCOLORS; ++c ) { //Color 0 is black, which wouldn't show up against most backgrounds
+				palette.push_back( getColorBasedOnNum( c ) );
+			}
+			swarm.setPalette( palette );
+			swarm.reset( this, settingsManager.getSwarmSize(), settingsManager.botMovementDelay );
+		}
+		
 		setLoadingPercentage( 100 );
 		
+		startMakingNextMaze();
+		
 		if( not isScreenSaver ) {
 			network.ImReadyToPlay();
 		}
@@ -3348,8 +3459,8 @@ bool MainGame::OnEvent( const irr::SEvent& event ) {
 								}*/
 
 								viewportSize.set( screenSize.Width - ( screenSize.Width / sideDisplaySizeDenominator ), screenSize.Height - 1 );
-								cellWidth = ( viewportSize.Width ) / mazeManager.cols;
-								cellHeight = ( viewportSize.Height ) / mazeManager.rows;
+								cellWidth = std::max< decltype( cellWidth ) >( 1, ( viewportSize.Width ) / mazeManager.cols );
+								cellHeight = std::max< decltype( cellHeight ) >( 1, ( viewportSize.Height ) / mazeManager.rows );
 								loadFonts();
 								
 								menuManager.setPositions( screenSize.Height );
@@ -3784,6 +3895,8 @@ void MainGame::resetThings() {
 		//The delay exists so that people can admire the logo artwork or read the pro tips on the loading screen. Actual loading happens in the blink of an eye on my computer.
 		if( not haveShownLogo ) {
 			loadingDelay = 6000;
+		} else if( settingsManager.getEndlessMazes() ) { //The point of endless mazes is to go straight from one to the next
+			loadingDelay = 0;
 		} else {
 			loadingDelay = 1000 + ( getRandomNumber() % 5000 ); //Adds some randomness just to make it seem less artificial.
 		}
@@ -3850,11 +3963,7 @@ void MainGame::resetThings() {
 			stuff.at( i ).loadTexture( device );
 		}
 		
-		for( decltype( mazeManager.cols ) x = 0; x < mazeManager.cols; ++x ) {
-			for( decltype( mazeManager.rows ) y = 0; y < mazeManager.rows; ++y ) {
-				mazeManager.maze[ x ][ y ].visited = false;
-			}
-		}
+		mazeManager.maze.clearVisited();
 		
 		won = false;
 		backgroundSceneManager->clear();
@@ -3949,6 +4058,9 @@ uint_fast8_t MainGame::run() {
 							}
 						}
 					}
+					if( currentScreen == MAINSCREEN ) {
+						swarm.move( settingsManager.botMovementDelay );
+					}
 					
 					device->getCursorControl()->setVisible( currentScreen not_eq MAINSCREEN or settingsManager.debug );
 					drawAll();
@@ -3974,11 +4086,7 @@ uint_fast8_t MainGame::run() {
 										//stuff.erase( stuff.begin() + s );
 
 										if( numKeysFound >= numLocks ) {
-											for( decltype( mazeManager.cols ) c = 0; c < mazeManager.cols; ++c ) {
-												for( decltype( mazeManager.rows ) r = 0; r < mazeManager.rows; ++r ) {
-													mazeManager.maze[ c ][ r ].removeLocks();
-												}
-											}
+											mazeManager.maze.removeLocks();
 
 											for( decltype( settingsManager.getNumBots() ) b = 0; b < settingsManager.getNumBots(); ++b ) {
 												bot.at( b ).allKeysFound();
@@ -6236,6 +6344,13 @@ void MainGame::showLoadMazeDialog() {
 	loadMazeDialog->addFileFilter( mazeManager.getFileTypeName(), mazeManager.getFileTypeExtension(), driver->getTexture( L"Images/icon.png" ) );
 }
 
+/**
+ * Pops up a message box.
+ */
+void MainGame::showMessage( std::wstring title, std::wstring message ) {
+	gui->addMessageBox( title.c_str(), message.c_str() );
+}
+
 /**
  * Creates a file selection dialog for saving the maze
  */
@@ -6265,6 +6380,80 @@ void MainGame::startLoadingScreen() {
 	}
 }
 
+/**
+ * Picks the seed for the next maze and starts making it on another thread, so it's ready as soon as this one is won.
+ */
+void MainGame::startMakingNextMaze() {
+	try {
+		discardNextMaze();
+		
+		//Clients make whatever maze the server tells them to. Endless mazes are already made ahead of time by EndlessMaze. Mazes loaded from a file get made again from the same seed.
+		if( not settingsManager.isServer or settingsManager.getEndlessMazes() or firstMaze ) {
+			return;
+		}
+		
+		nextMazeSeed = getRandomNumber();
+		nextMaze.reset( new MazeManager() );
+		nextMaze->showProgress = false;
+		MazeManager::LevelSettings levelSettings = mazeManager.getCurrentSettings(); //A copy, so that the thread never reads the settings while the settings screen might be changing them
+		MazeManager* maker = nextMaze.get();
+		
+		if( settingsManager.getTargetDifficulty().isSet() ) {
+			MazeDifficulty target = settingsManager.getTargetDifficulty(); //A copy, for the same reason
+			SeedScreener* screener = &seedScreener;
+			std::minstd_rand::result_type* seed = &nextMazeSeed; //Only read again once the thread has been joined
+			nextMazeThread = std::thread( [ maker, levelSettings, target, screener, seed ]() {
+				*seed = screener->screen( levelSettings, target, *seed, *maker );
+				if( levelSettings.debug ) {
+					maker->debugLog << L"Screened " << screener->getCandidatesTried() << L" seeds for the next maze and picked " << *seed << L": " << MazeDifficulty::toString( screener->getDifficulty() ) << std::endl;
+				}
+			} );
+		} else {
+			nextMaze->setRandomSeed( nextMazeSeed );
+			nextMazeThread = std::thread( [ maker, levelSettings ]() {
+				maker->makeRandomLevel( levelSettings );
+			} );
+		}
+	} catch ( std::exception &error ) {
+		std::wcerr << L"Error in startMakingNextMaze(): " << error.what() << std::endl;
+		nextMaze.reset();
+	}
+}
+
+/**
+ * Copies the level just made by mazeManager into goal, stuff, playerStart, etc. and loads the collectables' textures.
+ */
+void MainGame::takeLevelFromMazeManager() {
+	try {
+		goal.setX( mazeManager.goalX );
+		goal.setY( mazeManager.goalY );
+		numLocks = mazeManager.numLocks;
+		
+		stuff = mazeManager.stuff;
+		for( decltype( stuff.size() ) i = 0; i < stuff.size(); ++i ) {
+			stuff.at( i ).setColorMode( settingsManager.colorMode );
+			stuff.at( i ).loadTexture( device );
+		}
+		
+		for( decltype( settingsManager.getNumPlayers() ) p = 0; p < settingsManager.getNumPlayers() and p < mazeManager.playerStart.size(); ++p ) {
+			playerStart.at( p ).setPos( mazeManager.playerStart.at( p ).getX(), mazeManager.playerStart.at( p ).getY() );
+			playerStart.at( p ).distanceFromExit = mazeManager.playerStart.at( p ).distanceFromExit;
+			player.at( p ).setPos( playerStart.at( p ).getX(), playerStart.at( p ).getY() );
+			
+			mazeManager.maze.setVisited( playerStart.at( p ).getX(), playerStart.at( p ).getY(), true );
+			mazeManager.maze.setVisitorColor( playerStart.at( p ).getX(), playerStart.at( p ).getY(), player.at( p ).getColorTwo() );
+			mazeManager.makeCellsVisible( playerStart.at( p ).getX(), playerStart.at( p ).getY() );
+		}
+		
+		if( numLocks > 0 ) {
+			timer->stop();
+			timer->setTime( 0 );
+		}
+	} catch ( std::exception &error ) {
+		std::wcerr << L"Error in takeLevelFromMazeManager(): " << error.what() << std::endl;
+	}
+}
+
 /**
  * Takes a screenshot and saves it to a time-stamped png file.
  */
@@ -20,9 +20,12 @@
 #define GAMEMANAGER_H
 
 #include "AI.h"
+#include "BotPlanningPool.h"
+#include "BotSwarm.h"
 #include "Collectable.h"
 #include "FileSelectorDialog.h"
 #include "FontManager.h"
+#include "Game.h"
 #include "Goal.h"
 #include "GUIFreetypeFont.h"
 #include "ImageModifier.h"
@@ -34,6 +37,7 @@
 #include "Player.h"
 #include "PlayerStart.h"
 #include "PreprocessorCommands.h"
+#include "SeedScreener.h"
 #include "SettingsManager.h"
 #include "SettingsScreen.h"
 #include "SpellChecker.h"
@@ -41,18 +45,20 @@
 #include "SystemSpecificsManager.h"
 
 #include <irrlicht/irrlicht.h>
+#include <memory>
 #include <random>
 #include <SDL_mixer.h>
 #ifdef HAVE_STRING
 	#include <string>
 #endif //HAVE_STRING
+#include <thread>
 #ifdef HAVE_VECTOR
 	#include <vector>
 #endif //HAVE_VECTOR
 
 //using boost::asio::ip::tcp;
 
-class MainGame : public irr::IEventReceiver {
+class MainGame : public irr::IEventReceiver, public Game {
 	public:
 		//Functions----------------------------------
 		MainGame( std::wstring fileToLoad, bool runAsScreenSaver );
@@ -61,11 +67,14 @@ class MainGame : public irr::IEventReceiver {
 		void adjustImageColors( irr::video::IImage* image );
 		void allPlayersReady( bool tf );
 		
+		void botAlgorithmChanged(); //Called by settingsManager so the settings screen can show whether the new algorithm needs to know the solution.
+		
 		void displayExitConfirmation();
 		void drawAll(); //Public because it's called by MazeManager. Otherwise the loading screen wouldn't get drawn during maze generation.
 		
 		void eraseCollectable( uint_fast8_t item );
 		
+		BotPlanningPool* getBotPlanningPool();
 		Collectable* getCollectable( uint_fast8_t collectable );
 		irr::video::SColor getColorBasedOnNum( uint_fast8_t num );
 		bool getDebugStatus();
@@ -80,9 +89,11 @@ class MainGame : public irr::IEventReceiver {
 		Player* getPlayer( uint_fast8_t p );
 		std::minstd_rand::result_type getRandomNumber(); //C++'s rand() function can very between platforms or compilers; for consistency, therefore, we use a specific one of C++11's random number generators.
 		std::minstd_rand::result_type getRandomSeed();
+		uint_fast32_t getRealTime();
 		irr::core::dimension2d< irr::u32 > getScreenSize();
 		PlayerStart* getStart( uint_fast8_t ps );
 		
+		bool isConnected();
 		bool isNull( void* ptr );
 		
 		void movePlayerOnX( uint_fast8_t p, int_fast8_t direction, bool fromServer );
@@ -113,10 +124,12 @@ class MainGame : public irr::IEventReceiver {
 		void setObjectColorBasedOnNum( Object* object, uint_fast8_t num );
 		void setRandomSeed( std::minstd_rand::result_type newSeed );
 		void showLoadMazeDialog();
+		void showMessage( std::wstring title, std::wstring message );
 		void showSaveMazeDialog();
 		
 		//Non-functions----------------------------------
 		std::vector< AI > bot;
+		BotPlanningPool botPlanningPool; ///< Where bots which know the solution work it out. See getBotPlanningPool().
 		
 		enum screen_t : uint_fast8_t { MAINSCREEN, LOADINGSCREEN, MENUSCREEN, SETTINGSSCREEN, WAITINGFORPLAYERSSCREEN };
 		screen_t currentScreen;
@@ -139,6 +152,7 @@ class MainGame : public irr::IEventReceiver {
 		SettingsScreen settingsScreen;
 		StringConverter stringConverter;
 		std::vector< Collectable > stuff;
+		BotSwarm swarm; ///< See the "swarm bots" preference.
 		
 		irr::ITimer* timer;
 		uint_fast16_t timeStartedLoading;
@@ -154,6 +168,11 @@ class MainGame : public irr::IEventReceiver {
 		void drawSidebarText();
 		void drawStats( uint_fast32_t textY );
 		
+		/**
+		 * Waits for the next maze to finish (if one is being made ahead of time) and throws it away.
+		 */
+		void discardNextMaze();
+		
 		void initializeVariables( bool runAsScreenSaver );
 		
 		void loadClockFont();
@@ -178,7 +197,15 @@ class MainGame : public irr::IEventReceiver {
 		void setupDriver();
 		void setupMusicStuff();
 		void startLoadingScreen();
-		
+		/**
+		 * Picks the seed for the next maze and starts making it on another thread, so it's ready as soon as this one is won.
+		 */
+		void startMakingNextMaze();
+		
+		/**
+		 * Copies the level just made by mazeManager into goal, stuff, playerStart, etc. and loads the collectables' textures.
+		 */
+		void takeLevelFromMazeManager();
 		void takeScreenShot();
 		
 		//Booleans----------------------------------
@@ -267,6 +294,11 @@ class MainGame : public irr::IEventReceiver {
 		std::vector< ControlMapping > controls;
 		
 		MazeManager mazeManager;
+		/**
+		 * The next maze, made on nextMazeThread while this one is being played. Null when no maze is being made ahead of time (for example in network games, where the server decides what the next maze is).
+		 */
+		std::unique_ptr< MazeManager > nextMaze;
+		SeedScreener seedScreener; ///< Picks nextMazeSeed when the "target difficulty" preference is set. Only used on nextMazeThread.
 		
 		ImageModifier resizer;
 		SpellChecker spellChecker;
@@ -323,6 +355,8 @@ class MainGame : public irr::IEventReceiver {
 		size_t currentProTip;
 		std::minstd_rand randomNumberGenerator;
 		std::minstd_rand::result_type randomSeed;
+		std::minstd_rand::result_type nextMazeSeed;
+		std::thread nextMazeThread;
 		enum background_t : uint_fast8_t { ORIGINAL_STARFIELD, ROTATING_STARFIELD, IMAGES, STAR_TRAILS, PLAIN_COLOR, NUMBER_OF_BACKGROUNDS };
 		enum user_event_t : uint_fast8_t { USER_EVENT_WINDOW_RESIZE };
 };
@@ -0,0 +1,162 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The MazeDifficulty class describes how hard a maze is: how far it is from the start to the goal, how much of the maze is dead ends, how many ways on there are from each cell, and how many keys there are. It's used both to measure a maze and, as the "target difficulty" preference, to say what sort of maze is wanted.
+ */
+
+#include "MazeDifficulty.h"
+#include "MazeManager.h"
+
+#include <algorithm>
+#include <cmath>
+#ifdef HAVE_IOSTREAM
+	#include <iostream>
+#endif //HAVE_IOSTREAM
+#include <sstream>
+#ifdef HAVE_VECTOR
+	#include <vector>
+#endif //HAVE_VECTOR
+
+const float MazeDifficulty::ANY = -1.0f;
+
+MazeDifficulty::MazeDifficulty() {
+	try {
+		solutionLength = ANY;
+		deadEndRatio = ANY;
+		branchingFactor = ANY;
+		keys = ANY;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeDifficulty::MazeDifficulty(): " << e.what() << std::endl;
+	}
+}
+
+MazeDifficulty::~MazeDifficulty() {
+	try {
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeDifficulty::~MazeDifficulty(): " << e.what() << std::endl;
+	}
+}
+
+bool MazeDifficulty::isSet() const {
+	return ( solutionLength >= 0 or deadEndRatio >= 0 or branchingFactor >= 0 or keys >= 0 );
+}
+
+bool MazeDifficulty::isClose( float measured, float target, float allowed ) {
+	return ( target < 0 or std::fabs( measured - target ) <= allowed );
+}
+
+bool MazeDifficulty::isWithin( const MazeDifficulty& target, float tolerance ) const {
+	//Whole numbers can't be off by a fraction of a step, so the allowance gets rounded down for them
+	return ( isClose( solutionLength, target.solutionLength, std::floor( target.solutionLength * tolerance ) )
+		and isClose( deadEndRatio, target.deadEndRatio, target.deadEndRatio * tolerance )
+		and isClose( branchingFactor, target.branchingFactor, target.branchingFactor * tolerance )
+		and isClose( keys, target.keys, std::floor( target.keys * tolerance ) ) );
+}
+
+float MazeDifficulty::missBy( const MazeDifficulty& target ) const {
+	float miss = 0;
+	auto add = [ &miss ]( float measured, float wanted ) {
+		if( wanted >= 0 ) {
+			miss += std::fabs( measured - wanted ) / std::max( wanted, 1.0f ); //A target of zero keys would otherwise divide by zero
+		}
+	};
+	add( solutionLength, target.solutionLength );
+	add( deadEndRatio, target.deadEndRatio );
+	add( branchingFactor, target.branchingFactor );
+	add( keys, target.keys );
+	return miss;
+}
+
+void MazeDifficulty::measure( const MazeManager& level ) {
+	try {
+		const auto& maze = level.maze;
+		auto cols = maze.getCols();
+		auto rows = maze.getRows();
+
+		//Locks count as passages, since every one of them gets opened eventually. Each cell's top and left are its share of the passages, so one pass finds them all.
+		auto isPassage = []( MazeCell::border_t wall ) {
+			return ( wall == MazeCell::NONE or wall == MazeCell::LOCK );
+		};
+		std::vector< uint_fast8_t > waysOut( maze.getNumCells(), 0 );
+		for( decltype( rows ) y = 0; y < rows; ++y ) {
+			for( decltype( cols ) x = 0; x < cols; ++x ) {
+				auto cell = maze.index( x, y );
+				if( x > 0 and isPassage( maze.getLeft( x, y ) ) ) {
+					waysOut[ cell ] += 1;
+					waysOut[ cell - 1 ] += 1;
+				}
+				if( y > 0 and isPassage( maze.getTop( x, y ) ) ) {
+					waysOut[ cell ] += 1;
+					waysOut[ cell - cols ] += 1;
+				}
+			}
+		}
+
+		uint_fast32_t deadEnds = 0;
+		uint_fast32_t throughCells = 0; //Cells with more than one way out
+		uint_fast32_t waysOn = 0;
+		for( decltype( waysOut.size() ) cell = 0; cell < waysOut.size(); ++cell ) {
+			if( waysOut[ cell ] == 1 ) {
+				deadEnds += 1;
+			} else if( waysOut[ cell ] > 1 ) {
+				throughCells += 1;
+				waysOn += waysOut[ cell ] - 1;
+			}
+		}
+
+		solutionLength = ( level.playerStart.empty() ? 0 : level.playerStart[ 0 ].distanceFromExit );
+		deadEndRatio = ( waysOut.empty() ? 0 : static_cast< float >( deadEnds ) / waysOut.size() );
+		branchingFactor = ( throughCells == 0 ? 0 : static_cast< float >( waysOn ) / throughCells );
+		keys = level.numLocks;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeDifficulty::measure(): " << e.what() << std::endl;
+	}
+}
+
+MazeDifficulty MazeDifficulty::fromString( std::wstring input ) {
+	MazeDifficulty result;
+	std::wistringstream words( input );
+	float* measures[] = { &result.solutionLength, &result.deadEndRatio, &result.branchingFactor, &result.keys };
+
+	std::wstring word;
+	for( uint_fast8_t m = 0; m < 4 and words >> word; ++m ) {
+		if( word == L"any" ) {
+			continue;
+		}
+		try {
+			*measures[ m ] = std::max( 0.0f, std::stof( word ) );
+		} catch ( std::exception &e ) {
+			std::wcerr << L"Error in MazeDifficulty::fromString(): \"" << word << L"\" is not a number or \"any\" (" << e.what() << L"). Using \"any\"." << std::endl;
+		}
+	}
+
+	return result;
+}
+
+std::wstring MazeDifficulty::toString( const MazeDifficulty& difficulty ) {
+	std::wostringstream result;
+	const float measures[] = { difficulty.solutionLength, difficulty.deadEndRatio, difficulty.branchingFactor, difficulty.keys };
+	for( uint_fast8_t m = 0; m < 4; ++m ) {
+		if( m > 0 ) {
+			result << L" ";
+		}
+		if( measures[ m ] < 0 ) {
+			result << L"any";
+		} else {
+			result << measures[ m ];
+		}
+	}
+	return result.str();
+}
@@ -0,0 +1,90 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The MazeDifficulty class describes how hard a maze is: how far it is from the start to the goal, how much of the maze is dead ends, how many ways on there are from each cell, and how many keys there are. It's used both to measure a maze and, as the "target difficulty" preference, to say what sort of maze is wanted.
+ */
+
+#ifndef MAZEDIFFICULTY_H
+#define MAZEDIFFICULTY_H
+
+#ifdef HAVE_STRING
+	#include <string>
+#endif //HAVE_STRING
+#include "Integers.h"
+#include "PreprocessorCommands.h"
+
+class MazeManager; //Avoids circular dependency, since MazeManager includes SettingsManager which includes this
+
+class MazeDifficulty {
+	public:
+		/**
+		 * Constructor: Every measure is ANY.
+		 */
+		MazeDifficulty();
+		/**
+		 * Destructor: Does nothing.
+		 */
+		virtual ~MazeDifficulty();
+
+		/**
+		 * A target measure that doesn't matter. Measured values are never negative.
+		 */
+		static const float ANY;
+
+		/**
+		 * How many steps it is from the first player's start to the goal, not counting detours for keys.
+		 */
+		float solutionLength;
+		/**
+		 * The fraction of cells with only one way out.
+		 */
+		float deadEndRatio;
+		/**
+		 * The average number of ways on from a cell, not counting the way in, over the cells that aren't dead ends. A maze of nothing but corridors has a branching factor of 1.
+		 */
+		float branchingFactor;
+		float keys;
+
+		/**
+		 * Returns whether any measure is something other than ANY.
+		 */
+		bool isSet() const;
+		/**
+		 * Returns whether every measure which target cares about is within the given fraction of it (0.1 means 10%). Measures that can only be whole numbers, like keys, have to match exactly unless the target is large enough for the fraction to come to one or more.
+		 */
+		bool isWithin( const MazeDifficulty& target, float tolerance ) const;
+		/**
+		 * Returns how far off this is from target, adding up the relative difference in each measure target cares about. Used to pick the closest maze when none is within tolerance.
+		 */
+		float missBy( const MazeDifficulty& target ) const;
+		/**
+		 * Measures the level most recently made by the given MazeManager, in one pass over the maze.
+		 */
+		void measure( const MazeManager& level );
+
+		/**
+		 * Reads a difficulty as written by toString(): solution length, dead end ratio, branching factor, and keys, separated by spaces. Any of them can be "any", and any left off the end count as "any".
+		 */
+		static MazeDifficulty fromString( std::wstring input );
+		static std::wstring toString( const MazeDifficulty& difficulty );
+	protected:
+	private:
+		/**
+		 * Returns whether measured is no more than allowed away from target, or target is ANY.
+		 */
+		static bool isClose( float measured, float target, float allowed );
+};
+
+#endif // MAZEDIFFICULTY_H
@@ -0,0 +1,727 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The MazeGenerator class turns a grid full of walls into a perfect maze (one with exactly one path between any two cells). It contains the maze generation algorithms.
+ */
+
+#include "MazeGenerator.h"
+#include "SpellChecker.h"
+
+#include <deque>
+#ifdef HAVE_IOSTREAM
+	#include <iostream>
+#endif //HAVE_IOSTREAM
+
+MazeGenerator::algorithm_t MazeGenerator::algorithmFromString( std::wstring input ) {
+	std::vector< std::wstring > possibleChoices = { stringFromAlgorithm( DEPTH_FIRST_SEARCH ), stringFromAlgorithm( KRUSKAL ), stringFromAlgorithm( WILSON ), stringFromAlgorithm( PRIM ), stringFromAlgorithm( GROWING_TREE ) };
+
+	std::wstring choice;
+	{
+		SpellChecker spellChecker;
+		choice = possibleChoices.at( spellChecker.indexOfClosestString( input, possibleChoices ) );
+	}
+
+	algorithm_t result = ALGORITHM_DO_NOT_USE;
+
+	if( choice == possibleChoices.at( 0 ) ) {
+		result = DEPTH_FIRST_SEARCH;
+	} else if( choice == possibleChoices.at( 1 ) ) {
+		result = KRUSKAL;
+	} else if( choice == possibleChoices.at( 2 ) ) {
+		result = WILSON;
+	} else if( choice == possibleChoices.at( 3 ) ) {
+		result = PRIM;
+	} else if( choice == possibleChoices.at( 4 ) ) {
+		result = GROWING_TREE;
+	}
+
+	return result;
+}
+
+void MazeGenerator::cellDone() {
+	cellsDone += 1;
+	if( progressCallback and ( cellsDone bitand 0xFF ) == 0 ) { //Checking the clock is cheap, but not so cheap that we want to do it for every cell
+		auto now = std::chrono::steady_clock::now();
+		if( now - lastProgressReport >= std::chrono::milliseconds( 1000 / progressUpdatesPerSecond ) ) {
+			lastProgressReport = now;
+			progressCallback( static_cast< float >( cellsDone ) / totalCells );
+		}
+	}
+}
+
+void MazeGenerator::findDeadEnds( const MazeGrid& maze ) {
+	try {
+		auto cols = maze.getCols();
+		auto rows = maze.getRows();
+		std::vector< uint_fast32_t > columnStart( cols + 1, 0 ); //Where each column's dead ends go in the list. Counted one column along at first, then added up.
+		for( decltype( rows ) y = 0; y < rows; ++y ) {
+			for( decltype( cols ) x = 0; x < cols; ++x ) {
+				if( passages[ maze.index( x, y ) ] == 1 ) {
+					columnStart[ x + 1 ] += 1;
+				}
+			}
+		}
+		for( decltype( cols ) x = 0; x < cols; ++x ) {
+			columnStart[ x + 1 ] += columnStart[ x ];
+		}
+
+		//The rows are gone through in order, so each column's dead ends end up top to bottom
+		deadEnds.resize( columnStart[ cols ] );
+		for( decltype( rows ) y = 0; y < rows; ++y ) {
+			for( decltype( cols ) x = 0; x < cols; ++x ) {
+				if( passages[ maze.index( x, y ) ] == 1 ) {
+					deadEnds[ columnStart[ x ]++ ] = maze.index( x, y );
+				}
+			}
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGenerator::findDeadEnds(): " << e.what() << std::endl;
+	}
+}
+
+void MazeGenerator::findFarthest( MazeGrid& maze, coordinate_t startX, coordinate_t startY ) {
+	try {
+		std::vector< uint_fast32_t > distance( maze.getNumCells(), UINT_FAST32_MAX );
+		std::vector< irr::core::position2d< coordinate_t > > queue;
+		queue.reserve( maze.getNumCells() );
+
+		distance.at( maze.index( startX, startY ) ) = 0;
+		queue.push_back( irr::core::position2d< coordinate_t >( startX, startY ) );
+
+		for( decltype( queue.size() ) head = 0; head < queue.size(); ++head ) {
+			coordinate_t x = queue[ head ].X;
+			coordinate_t y = queue[ head ].Y;
+			uint_fast32_t currentDistance = distance[ maze.index( x, y ) ];
+
+			if( currentDistance >= farthestDistance ) {
+				farthestX = x;
+				farthestY = y;
+				farthestDistance = currentDistance;
+			}
+
+			for( uint_fast8_t direction = 0; direction < 4; ++direction ) {
+				coordinate_t neighborX;
+				coordinate_t neighborY;
+				if( getNeighbor( maze, x, y, direction, neighborX, neighborY ) and distance[ maze.index( neighborX, neighborY ) ] == UINT_FAST32_MAX ) {
+					bool open;
+					switch( direction ) {
+						case 0: {
+							open = ( maze.getLeft( x, y ) == MazeCell::NONE );
+							break;
+						}
+						case 1: {
+							open = ( maze.getLeft( neighborX, neighborY ) == MazeCell::NONE );
+							break;
+						}
+						case 2: {
+							open = ( maze.getTop( x, y ) == MazeCell::NONE );
+							break;
+						}
+						default: {
+							open = ( maze.getTop( neighborX, neighborY ) == MazeCell::NONE );
+							break;
+						}
+					}
+
+					if( open ) {
+						distance[ maze.index( neighborX, neighborY ) ] = currentDistance + 1;
+						queue.push_back( irr::core::position2d< coordinate_t >( neighborX, neighborY ) );
+					}
+				}
+			}
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGenerator::findFarthest(): " << e.what() << std::endl;
+	}
+}
+
+void MazeGenerator::generate( MazeGrid& maze, coordinate_t startX, coordinate_t startY ) {
+	try {
+		passages.assign( maze.getNumCells(), 0 );
+		deadEnds.clear();
+		if( maze.empty() ) {
+			return;
+		}
+
+		totalCells = maze.getNumCells();
+		cellsDone = 0;
+		lastProgressReport = std::chrono::steady_clock::now();
+		farthestX = startX;
+		farthestY = startY;
+		farthestDistance = 0;
+		maze.clearVisited();
+
+		switch( algorithm ) {
+			case KRUSKAL: {
+				generateKruskal( maze );
+				break;
+			}
+			case WILSON: {
+				generateWilson( maze, startX, startY );
+				break;
+			}
+			case PRIM: {
+				generatePrim( maze, startX, startY );
+				break;
+			}
+			case GROWING_TREE: {
+				generateGrowingTree( maze, startX, startY );
+				break;
+			}
+			default: {
+				generateDepthFirst( maze, startX, startY );
+				break;
+			}
+		}
+
+		if( algorithm not_eq DEPTH_FIRST_SEARCH ) { //Depth-first search keeps track of the farthest cell as it goes; the others don't know distances until they're done
+			findFarthest( maze, startX, startY );
+		}
+		findDeadEnds( maze );
+
+		if( progressCallback ) {
+			progressCallback( 1 );
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGenerator::generate(): " << e.what() << std::endl;
+	}
+}
+
+void MazeGenerator::generateDepthFirst( MazeGrid& maze, coordinate_t startX, coordinate_t startY ) {
+	try {
+		coordinate_t cols = maze.getCols();
+		coordinate_t rows = maze.getRows();
+
+		//The cells we've walked through to get to where we are. The back of the stack is the current cell, and the size of the stack tells us how far we are from the start.
+		std::vector< irr::core::position2d< coordinate_t > > path;
+
+		//Mark a cell as part of the maze and see whether it's the farthest we've gotten from the start
+		auto enterCell = [ & ]( coordinate_t x, coordinate_t y ) {
+			maze.setVisited( x, y, true );
+			path.push_back( irr::core::position2d< coordinate_t >( x, y ) );
+			uint_fast32_t depth = path.size() - 1;
+
+			if( depth >= farthestDistance ) {
+				farthestX = x;
+				farthestY = y;
+				farthestDistance = depth;
+			}
+
+			cellDone();
+		};
+
+		enterCell( startX, startY );
+
+		while( not path.empty() ) {
+			coordinate_t x = path.back().X;
+			coordinate_t y = path.back().Y;
+			bool movedOn = false;
+
+			switch( randomNumber() % 4 ) { //4 = number of directions (up, down, left, right)
+				case 0: //Left
+					if( x > 0 and not maze.isVisited( x - 1, y ) ) {
+						knockDownWall( maze, x, y, 0 );
+						enterCell( x - 1, y );
+						movedOn = true;
+					}
+					break;
+				case 1: //Right
+					if( x < cols - 1 and not maze.isVisited( x + 1, y ) ) {
+						knockDownWall( maze, x, y, 1 );
+						enterCell( x + 1, y );
+						movedOn = true;
+					}
+					break;
+				case 2: //Up
+					if( y > 0 and not maze.isVisited( x, y - 1 ) ) {
+						knockDownWall( maze, x, y, 2 );
+						enterCell( x, y - 1 );
+						movedOn = true;
+					}
+					break;
+				case 3: //Down
+					if( y < rows - 1 and not maze.isVisited( x, y + 1 ) ) {
+						knockDownWall( maze, x, y, 3 );
+						enterCell( x, y + 1 );
+						movedOn = true;
+					}
+					break;
+			}
+
+			//A freshly entered cell always gets at least one random number, just like it did when this was recursive. Otherwise, back up until we find a cell which still has unvisited neighbors.
+			if( not movedOn ) {
+				while( not path.empty() ) {
+					x = path.back().X;
+					y = path.back().Y;
+					if( ( x > 0 and not maze.isVisited( x - 1, y ) )
+							or ( x < cols - 1 and not maze.isVisited( x + 1, y ) )
+							or ( y > 0 and not maze.isVisited( x, y - 1 ) )
+							or ( y < rows - 1 and not maze.isVisited( x, y + 1 ) ) ) {
+						break;
+					}
+					path.pop_back();
+				}
+			}
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGenerator::generateDepthFirst(): " << e.what() << std::endl;
+	}
+}
+
+void MazeGenerator::generateGrowingTree( MazeGrid& maze, coordinate_t startX, coordinate_t startY ) {
+	try {
+		//A deque because the OLDEST policy takes cells from the front
+		std::deque< irr::core::position2d< coordinate_t > > active;
+
+		maze.setVisited( startX, startY, true );
+		active.push_back( irr::core::position2d< coordinate_t >( startX, startY ) );
+		cellDone();
+
+		while( not active.empty() ) {
+			decltype( active.size() ) chosen;
+			switch( policy ) {
+				case RANDOM: {
+					chosen = randomBelow( active.size() );
+					break;
+				}
+				case OLDEST: {
+					chosen = 0;
+					break;
+				}
+				case NEWEST_OR_RANDOM: {
+					if( randomBelow( 2 ) == 0 ) {
+						chosen = active.size() - 1;
+					} else {
+						chosen = randomBelow( active.size() );
+					}
+					break;
+				}
+				default: {
+					chosen = active.size() - 1;
+					break;
+				}
+			}
+
+			coordinate_t x = active[ chosen ].X;
+			coordinate_t y = active[ chosen ].Y;
+
+			uint_fast8_t unvisitedDirections[ 4 ];
+			uint_fast8_t numUnvisited = 0;
+			for( uint_fast8_t direction = 0; direction < 4; ++direction ) {
+				coordinate_t neighborX;
+				coordinate_t neighborY;
+				if( getNeighbor( maze, x, y, direction, neighborX, neighborY ) and not maze.isVisited( neighborX, neighborY ) ) {
+					unvisitedDirections[ numUnvisited ] = direction;
+					numUnvisited += 1;
+				}
+			}
+
+			if( numUnvisited == 0 ) { //Nowhere left to grow from this cell
+				if( chosen == active.size() - 1 ) {
+					active.pop_back();
+				} else if( chosen == 0 ) {
+					active.pop_front();
+				} else {
+					active[ chosen ] = active.back();
+					active.pop_back();
+				}
+			} else {
+				uint_fast8_t direction = unvisitedDirections[ randomBelow( numUnvisited ) ];
+				coordinate_t neighborX;
+				coordinate_t neighborY;
+				getNeighbor( maze, x, y, direction, neighborX, neighborY );
+				knockDownWall( maze, x, y, direction );
+				maze.setVisited( neighborX, neighborY, true );
+				active.push_back( irr::core::position2d< coordinate_t >( neighborX, neighborY ) );
+				cellDone();
+			}
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGenerator::generateGrowingTree(): " << e.what() << std::endl;
+	}
+}
+
+void MazeGenerator::generateKruskal( MazeGrid& maze ) {
+	try {
+		coordinate_t cols = maze.getCols();
+		coordinate_t rows = maze.getRows();
+
+		//Each wall between two cells is numbered 2 * (index of the cell above or to the left) plus 0 for the wall to its right or 1 for the wall below it
+		std::vector< uint_fast32_t > walls;
+		walls.reserve( maze.getNumCells() * 2 );
+		for( decltype( rows ) y = 0; y < rows; ++y ) {
+			for( decltype( cols ) x = 0; x < cols; ++x ) {
+				if( x < cols - 1 ) {
+					walls.push_back( maze.index( x, y ) * 2 );
+				}
+				if( y < rows - 1 ) {
+					walls.push_back( maze.index( x, y ) * 2 + 1 );
+				}
+			}
+		}
+
+		//Fisher-Yates shuffle. Not std::shuffle() because that isn't guaranteed to give the same order on every standard library, and network games need everyone to get the same maze.
+		for( decltype( walls.size() ) i = walls.size(); i > 1; --i ) {
+			std::swap( walls[ i - 1 ], walls[ randomBelow( i ) ] );
+		}
+
+		std::vector< uint_fast32_t > parent( maze.getNumCells() );
+		std::vector< uint_fast32_t > setSize( maze.getNumCells(), 1 );
+		for( decltype( parent.size() ) i = 0; i < parent.size(); ++i ) {
+			parent[ i ] = i;
+		}
+
+		//Path halving: every cell we pass on the way to the root gets pointed at its grandparent, so later searches are shorter
+		auto findRoot = [ &parent ]( uint_fast32_t cell ) {
+			while( parent[ cell ] not_eq cell ) {
+				parent[ cell ] = parent[ parent[ cell ] ];
+				cell = parent[ cell ];
+			}
+			return cell;
+		};
+
+		cellDone(); //The first cell is a maze all by itself; each wall knocked down after that connects one more
+
+		for( decltype( walls.size() ) w = 0; w < walls.size() and cellsDone < totalCells; ++w ) {
+			uint_fast32_t cell = walls[ w ] / 2;
+			coordinate_t x = cell % cols;
+			coordinate_t y = cell / cols;
+			uint_fast8_t direction = ( ( walls[ w ] bitand 1 ) == 0 ) ? 1 : 3; //Right or down
+			uint_fast32_t neighbor = ( direction == 1 ) ? cell + 1 : cell + cols;
+
+			uint_fast32_t cellRoot = findRoot( cell );
+			uint_fast32_t neighborRoot = findRoot( neighbor );
+
+			if( cellRoot not_eq neighborRoot ) {
+				knockDownWall( maze, x, y, direction );
+
+				//Union by size keeps the trees shallow
+				if( setSize[ cellRoot ] < setSize[ neighborRoot ] ) {
+					std::swap( cellRoot, neighborRoot );
+				}
+				parent[ neighborRoot ] = cellRoot;
+				setSize[ cellRoot ] += setSize[ neighborRoot ];
+				cellDone();
+			}
+		}
+
+		for( decltype( rows ) y = 0; y < rows; ++y ) {
+			for( decltype( cols ) x = 0; x < cols; ++x ) {
+				maze.setVisited( x, y, true );
+			}
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGenerator::generateKruskal(): " << e.what() << std::endl;
+	}
+}
+
+void MazeGenerator::generatePrim( MazeGrid& maze, coordinate_t startX, coordinate_t startY ) {
+	try {
+		std::vector< irr::core::position2d< coordinate_t > > frontier;
+		std::vector< bool > inFrontier( maze.getNumCells(), false );
+
+		//Adds all neighbors of (x,y) which are neither in the maze nor already in the frontier
+		auto addToFrontier = [ & ]( coordinate_t x, coordinate_t y ) {
+			for( uint_fast8_t direction = 0; direction < 4; ++direction ) {
+				coordinate_t neighborX;
+				coordinate_t neighborY;
+				if( getNeighbor( maze, x, y, direction, neighborX, neighborY ) and not maze.isVisited( neighborX, neighborY ) and not inFrontier[ maze.index( neighborX, neighborY ) ] ) {
+					inFrontier[ maze.index( neighborX, neighborY ) ] = true;
+					frontier.push_back( irr::core::position2d< coordinate_t >( neighborX, neighborY ) );
+				}
+			}
+		};
+
+		maze.setVisited( startX, startY, true );
+		addToFrontier( startX, startY );
+		cellDone();
+
+		while( not frontier.empty() ) {
+			decltype( frontier.size() ) chosen = randomBelow( frontier.size() );
+			coordinate_t x = frontier[ chosen ].X;
+			coordinate_t y = frontier[ chosen ].Y;
+			frontier[ chosen ] = frontier.back();
+			frontier.pop_back();
+
+			//Connect to a random neighbor that's already in the maze. Every frontier cell has at least one.
+			uint_fast8_t visitedDirections[ 4 ];
+			uint_fast8_t numVisited = 0;
+			for( uint_fast8_t direction = 0; direction < 4; ++direction ) {
+				coordinate_t neighborX;
+				coordinate_t neighborY;
+				if( getNeighbor( maze, x, y, direction, neighborX, neighborY ) and maze.isVisited( neighborX, neighborY ) ) {
+					visitedDirections[ numVisited ] = direction;
+					numVisited += 1;
+				}
+			}
+
+			knockDownWall( maze, x, y, visitedDirections[ randomBelow( numVisited ) ] );
+			maze.setVisited( x, y, true );
+			addToFrontier( x, y );
+			cellDone();
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGenerator::generatePrim(): " << e.what() << std::endl;
+	}
+}
+
+void MazeGenerator::generateWilson( MazeGrid& maze, coordinate_t startX, coordinate_t startY ) {
+	try {
+		coordinate_t cols = maze.getCols();
+		coordinate_t rows = maze.getRows();
+
+		//Which way the random walk last left each cell. Overwriting this when the walk comes back around is what erases the loops.
+		std::vector< uint8_t > walkDirection( maze.getNumCells(), 0 );
+
+		maze.setVisited( startX, startY, true );
+		cellDone();
+
+		for( decltype( rows ) walkStartY = 0; walkStartY < rows; ++walkStartY ) {
+			for( decltype( cols ) walkStartX = 0; walkStartX < cols; ++walkStartX ) {
+				//Walk randomly until we run into the maze
+				coordinate_t x = walkStartX;
+				coordinate_t y = walkStartY;
+				while( not maze.isVisited( x, y ) ) {
+					uint_fast8_t possibleDirections[ 4 ];
+					uint_fast8_t numPossible = 0;
+					for( uint_fast8_t direction = 0; direction < 4; ++direction ) {
+						coordinate_t neighborX;
+						coordinate_t neighborY;
+						if( getNeighbor( maze, x, y, direction, neighborX, neighborY ) ) {
+							possibleDirections[ numPossible ] = direction;
+							numPossible += 1;
+						}
+					}
+
+					uint_fast8_t direction = possibleDirections[ randomBelow( numPossible ) ];
+					walkDirection[ maze.index( x, y ) ] = direction;
+					getNeighbor( maze, x, y, direction, x, y );
+				}
+
+				//Now follow the walk again from the beginning, without its loops, adding it to the maze
+				x = walkStartX;
+				y = walkStartY;
+				while( not maze.isVisited( x, y ) ) {
+					uint_fast8_t direction = walkDirection[ maze.index( x, y ) ];
+					maze.setVisited( x, y, true );
+					knockDownWall( maze, x, y, direction );
+					getNeighbor( maze, x, y, direction, x, y );
+					cellDone();
+				}
+			}
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGenerator::generateWilson(): " << e.what() << std::endl;
+	}
+}
+
+MazeGenerator::algorithm_t MazeGenerator::getAlgorithm() const {
+	return algorithm;
+}
+
+coordinate_t MazeGenerator::getFarthestX() const {
+	return farthestX;
+}
+
+coordinate_t MazeGenerator::getFarthestY() const {
+	return farthestY;
+}
+
+const std::vector< uint_fast32_t >& MazeGenerator::getDeadEnds() const {
+	return deadEnds;
+}
+
+uint_fast32_t MazeGenerator::getFarthestDistance() const {
+	return farthestDistance;
+}
+
+bool MazeGenerator::getNeighbor( const MazeGrid& maze, coordinate_t x, coordinate_t y, uint_fast8_t direction, coordinate_t& neighborX, coordinate_t& neighborY ) const {
+	switch( direction ) {
+		case 0: { //Left
+			if( x == 0 ) {
+				return false;
+			}
+			neighborX = x - 1;
+			neighborY = y;
+			return true;
+		}
+		case 1: { //Right
+			if( x + 1 >= maze.getCols() ) {
+				return false;
+			}
+			neighborX = x + 1;
+			neighborY = y;
+			return true;
+		}
+		case 2: { //Up
+			if( y == 0 ) {
+				return false;
+			}
+			neighborX = x;
+			neighborY = y - 1;
+			return true;
+		}
+		default: { //Down
+			if( y + 1 >= maze.getRows() ) {
+				return false;
+			}
+			neighborX = x;
+			neighborY = y + 1;
+			return true;
+		}
+	}
+}
+
+MazeGenerator::policy_t MazeGenerator::getPolicy() const {
+	return policy;
+}
+
+void MazeGenerator::knockDownWall( MazeGrid& maze, coordinate_t x, coordinate_t y, uint_fast8_t direction ) {
+	auto cell = maze.index( x, y );
+	switch( direction ) {
+		case 0: { //Left
+			maze.setOriginalLeft( x, y, MazeCell::NONE );
+			passages[ cell - 1 ] += 1;
+			break;
+		}
+		case 1: { //Right
+			maze.setOriginalLeft( x + 1, y, MazeCell::NONE );
+			passages[ cell + 1 ] += 1;
+			break;
+		}
+		case 2: { //Up
+			maze.setOriginalTop( x, y, MazeCell::NONE );
+			passages[ cell - maze.getCols() ] += 1;
+			break;
+		}
+		default: { //Down
+			maze.setOriginalTop( x, y + 1, MazeCell::NONE );
+			passages[ cell + maze.getCols() ] += 1;
+			break;
+		}
+	}
+	passages[ cell ] += 1;
+}
+
+MazeGenerator::MazeGenerator() {
+	try {
+		algorithm = DEPTH_FIRST_SEARCH;
+		policy = NEWEST;
+		progressUpdatesPerSecond = 30;
+		farthestX = 0;
+		farthestY = 0;
+		farthestDistance = 0;
+		cellsDone = 0;
+		totalCells = 0;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGenerator::MazeGenerator(): " << e.what() << std::endl;
+	}
+}
+
+MazeGenerator::~MazeGenerator() {
+	try {
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGenerator::~MazeGenerator(): " << e.what() << std::endl;
+	}
+}
+
+MazeGenerator::policy_t MazeGenerator::policyFromString( std::wstring input ) {
+	std::vector< std::wstring > possibleChoices = { stringFromPolicy( NEWEST ), stringFromPolicy( RANDOM ), stringFromPolicy( OLDEST ), stringFromPolicy( NEWEST_OR_RANDOM ) };
+
+	std::wstring choice;
+	{
+		SpellChecker spellChecker;
+		choice = possibleChoices.at( spellChecker.indexOfClosestString( input, possibleChoices ) );
+	}
+
+	policy_t result = POLICY_DO_NOT_USE;
+
+	if( choice == possibleChoices.at( 0 ) ) {
+		result = NEWEST;
+	} else if( choice == possibleChoices.at( 1 ) ) {
+		result = RANDOM;
+	} else if( choice == possibleChoices.at( 2 ) ) {
+		result = OLDEST;
+	} else if( choice == possibleChoices.at( 3 ) ) {
+		result = NEWEST_OR_RANDOM;
+	}
+
+	return result;
+}
+
+uint_fast32_t MazeGenerator::randomBelow( uint_fast32_t max ) {
+	return randomNumber() % max;
+}
+
+void MazeGenerator::setAlgorithm( algorithm_t newAlgorithm ) {
+	if( newAlgorithm < ALGORITHM_DO_NOT_USE ) {
+		algorithm = newAlgorithm;
+	} else {
+		std::wcerr << L"Error in MazeGenerator::setAlgorithm(): Unrecognized algorithm " << newAlgorithm << L". Using depth-first search." << std::endl;
+		algorithm = DEPTH_FIRST_SEARCH;
+	}
+}
+
+void MazeGenerator::setPolicy( policy_t newPolicy ) {
+	if( newPolicy < POLICY_DO_NOT_USE ) {
+		policy = newPolicy;
+	} else {
+		std::wcerr << L"Error in MazeGenerator::setPolicy(): Unrecognized policy " << newPolicy << L". Using newest." << std::endl;
+		policy = NEWEST;
+	}
+}
+
+std::wstring MazeGenerator::stringFromAlgorithm( algorithm_t input ) {
+	switch( input ) {
+		case DEPTH_FIRST_SEARCH: {
+			return L"depth-first search";
+		}
+		case KRUSKAL: {
+			return L"kruskal";
+		}
+		case WILSON: {
+			return L"wilson";
+		}
+		case PRIM: {
+			return L"prim";
+		}
+		case GROWING_TREE: {
+			return L"growing tree";
+		}
+		default: {
+			return L"Unrecognized algorithm";
+		}
+	}
+}
+
+std::wstring MazeGenerator::stringFromPolicy( policy_t input ) {
+	switch( input ) {
+		case NEWEST: {
+			return L"newest";
+		}
+		case RANDOM: {
+			return L"random";
+		}
+		case OLDEST: {
+			return L"oldest";
+		}
+		case NEWEST_OR_RANDOM: {
+			return L"newest or random";
+		}
+		default: {
+			return L"Unrecognized policy";
+		}
+	}
+}
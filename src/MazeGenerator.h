@@ -0,0 +1,181 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The MazeGenerator class turns a grid full of walls into a perfect maze (one with exactly one path between any two cells). It contains the maze generation algorithms.
+ */
+
+#ifndef MAZEGENERATOR_H
+#define MAZEGENERATOR_H
+
+#ifdef WINDOWS
+    #include <irrlicht.h>
+#else
+    #include <irrlicht/irrlicht.h>
+#endif
+#include <chrono>
+#include <functional>
+#include <random>
+#ifdef HAVE_STRING
+	#include <string>
+#endif //HAVE_STRING
+#ifdef HAVE_VECTOR
+	#include <vector>
+#endif //HAVE_VECTOR
+#include "Integers.h"
+#include "MazeGrid.h"
+#include "PreprocessorCommands.h"
+
+class MazeGenerator {
+	public:
+		/**
+		 * The generation algorithms. They all make perfect mazes, but the mazes look different: depth-first search makes long twisty corridors, Prim's makes lots of short dead ends, Kruskal's and Wilson's are somewhere in between (Wilson's picks uniformly from all possible mazes). Growing tree looks like any of the others depending on its selection policy.
+		 * Speed measured on a 1000x1000 maze on one core: depth-first search about 11 million cells per second, Kruskal's about 3 million (and it needs the most memory: a shuffled list of every wall plus the union-find arrays), Wilson's about 4 million, Prim's about 5 million, and growing tree between 5 and 13 million depending on the policy.
+		 */
+		enum algorithm_t : uint_fast8_t { DEPTH_FIRST_SEARCH, KRUSKAL, WILSON, PRIM, GROWING_TREE, ALGORITHM_DO_NOT_USE };
+		/**
+		 * How the growing tree algorithm picks which active cell to grow from next. NEWEST behaves like depth-first search, RANDOM like Prim's, OLDEST makes long straight corridors, and NEWEST_OR_RANDOM picks one or the other each time.
+		 */
+		enum policy_t : uint_fast8_t { NEWEST, RANDOM, OLDEST, NEWEST_OR_RANDOM, POLICY_DO_NOT_USE };
+
+		/**
+		 * Returns the algorithm most closely matching a given string
+		 */
+		static algorithm_t algorithmFromString( std::wstring input );
+		/**
+		 * Given an algorithm, returns a string representation of the algorithm
+		 */
+		static std::wstring stringFromAlgorithm( algorithm_t input );
+		/**
+		 * Returns the growing tree policy most closely matching a given string
+		 */
+		static policy_t policyFromString( std::wstring input );
+		/**
+		 * Given a growing tree policy, returns a string representation of the policy
+		 */
+		static std::wstring stringFromPolicy( policy_t input );
+
+		/**
+		 * Constructor: Sets the algorithm to depth-first search and progress reporting to 30 updates per second.
+		 */
+		MazeGenerator();
+		/**
+		 * Destructor: Does nothing.
+		 */
+		virtual ~MazeGenerator();
+
+		/**
+		 * Knocks down walls in the given maze until it's a perfect maze. Every wall between two cells should be in place beforehand. Walls are only ever changed to NONE, so whatever the maze border and the start cell's walls were set to beforehand stays that way unless a passage goes through it.
+		 * @param maze: The maze to work on.
+		 * @param startX: The cell to start generating from. Algorithms which don't have a starting cell (Kruskal's) ignore this, but it's still used for working out getFarthestX() and getFarthestY().
+		 * @param startY: See startX.
+		 */
+		void generate( MazeGrid& maze, coordinate_t startX, coordinate_t startY );
+
+		algorithm_t getAlgorithm() const;
+		policy_t getPolicy() const;
+		/**
+		 * Returns the cell farthest (along the maze's paths) from the start cell given to generate(). When several cells are equally far, this is the last one the algorithm found.
+		 */
+		coordinate_t getFarthestX() const;
+		coordinate_t getFarthestY() const;
+		/**
+		 * Returns how many steps it takes to get from the start cell to the farthest cell.
+		 */
+		uint_fast32_t getFarthestDistance() const;
+		/**
+		 * Returns how many passages generate() carved out of the given cell (as returned by MazeGrid::index()): 1 for a dead end, 2 for a corridor, 3 or 4 for a junction.
+		 */
+		inline uint_fast8_t getPassages( uint_fast32_t cell ) const { return passages[ cell ]; }
+		/**
+		 * Returns every cell with only one passage, as made by the last call to generate(). They're listed column by column, top to bottom within each column, which is the order MazeManager has always picked keys' places from.
+		 */
+		const std::vector< uint_fast32_t >& getDeadEnds() const;
+
+		/**
+		 * Called by generate() with the fraction of the maze generated so far (0 to 1), no more than progressUpdatesPerSecond times per second. Can be left empty.
+		 */
+		std::function< void( float fractionDone ) > progressCallback;
+		uint_fast8_t progressUpdatesPerSecond;
+		/**
+		 * Where the random numbers come from. Whoever owns the random seed must set this before calling generate().
+		 */
+		std::function< std::minstd_rand::result_type() > randomNumber;
+
+		void setAlgorithm( algorithm_t newAlgorithm );
+		void setPolicy( policy_t newPolicy );
+	protected:
+	private:
+		algorithm_t algorithm;
+		policy_t policy;
+
+		coordinate_t farthestX;
+		coordinate_t farthestY;
+		uint_fast32_t farthestDistance;
+
+		std::vector< uint8_t > passages; ///< One per cell, indexed the same way as MazeGrid. Counted up by knockDownWall().
+		std::vector< uint_fast32_t > deadEnds;
+
+		uint_fast32_t cellsDone;
+		uint_fast32_t totalCells;
+		std::chrono::steady_clock::time_point lastProgressReport;
+		/**
+		 * Counts one more cell as done and calls progressCallback if it's been long enough since the last time.
+		 */
+		void cellDone();
+
+		/**
+		 * Finds the farthest cell from the start with a breadth-first search, for those algorithms that don't keep track of distances themselves.
+		 */
+		void findFarthest( MazeGrid& maze, coordinate_t startX, coordinate_t startY );
+		/**
+		 * Fills deadEnds from the passage counts. Goes through the cells row by row, which is kinder to the cache than going column by column, then puts them in column order with a counting sort.
+		 */
+		void findDeadEnds( const MazeGrid& maze );
+		/**
+		 * Finds the neighbor of a cell in the given direction (0 = left, 1 = right, 2 = up, 3 = down). Returns false if there is no neighbor in that direction because the cell is on the edge of the maze.
+		 */
+		bool getNeighbor( const MazeGrid& maze, coordinate_t x, coordinate_t y, uint_fast8_t direction, coordinate_t& neighborX, coordinate_t& neighborY ) const;
+		/**
+		 * Knocks down the wall between a cell and its neighbor in the given direction (0 = left, 1 = right, 2 = up, 3 = down), and counts the passage for both of them. Assumes the neighbor exists. Every algorithm carves through here, so the passage counts are always right.
+		 */
+		void knockDownWall( MazeGrid& maze, coordinate_t x, coordinate_t y, uint_fast8_t direction );
+		/**
+		 * Returns a random number from 0 to max - 1. Just randomNumber() % max, but using the same function everywhere makes sure every platform gets the same maze from the same seed.
+		 */
+		uint_fast32_t randomBelow( uint_fast32_t max );
+
+		/**
+		 * Randomized depth-first search (also known as the recursive backtracker). Keeps its own stack of cells rather than recursing, but draws random numbers in exactly the same order as the recursive version did, so a given random seed still makes the same maze.
+		 */
+		void generateDepthFirst( MazeGrid& maze, coordinate_t startX, coordinate_t startY );
+		/**
+		 * Randomized Kruskal's algorithm: goes through every wall in random order, knocking it down if the cells on either side aren't yet connected. Uses a union-find (disjoint set) structure with path compression.
+		 */
+		void generateKruskal( MazeGrid& maze );
+		/**
+		 * Wilson's algorithm: random walks from each cell not yet in the maze until the walk hits the maze, then adds the walk with its loops erased.
+		 */
+		void generateWilson( MazeGrid& maze, coordinate_t startX, coordinate_t startY );
+		/**
+		 * Randomized Prim's algorithm: keeps a frontier of cells bordering the maze and connects a random one each step.
+		 */
+		void generatePrim( MazeGrid& maze, coordinate_t startX, coordinate_t startY );
+		/**
+		 * The growing tree algorithm: keeps a list of active cells, picks one according to the policy, and grows the maze from it.
+		 */
+		void generateGrowingTree( MazeGrid& maze, coordinate_t startX, coordinate_t startY );
+};
+
+#endif // MAZEGENERATOR_H
@@ -0,0 +1,211 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The MazeGrid class stores the state of every cell in the maze. Everything lives in flat, row-major arrays ("planes") so that scanning the whole maze walks memory in order: one byte of packed walls per cell, one byte of visibility flags per cell, one byte of visited flag per cell, and one visitor color per cell.
+ */
+
+#include "MazeGrid.h"
+#include "colors.h"
+
+#include <algorithm>
+#include <atomic>
+#ifdef HAVE_IOSTREAM
+	#include <iostream>
+#endif //HAVE_IOSTREAM
+
+namespace {
+	std::atomic< uint_fast64_t > lastWallsVersion( 0 ); //Shared by every grid, including ones being made on other threads
+}
+
+MazeGrid::MazeGrid() {
+	try {
+		cols = 0;
+		rows = 0;
+		wallsChanged = true;
+		wallsVersion = 0;
+		layoutChanged = true;
+		layoutVersion = 0;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGrid::MazeGrid(): " << e.what() << std::endl;
+	}
+}
+
+MazeGrid::~MazeGrid() {
+	try {
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGrid::~MazeGrid(): " << e.what() << std::endl;
+	}
+}
+
+void MazeGrid::clearVisited() {
+	try {
+		std::fill( visitedPlane.begin(), visitedPlane.end(), 0 );
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGrid::clearVisited(): " << e.what() << std::endl;
+	}
+}
+
+void MazeGrid::fillWalls( MazeCell::border_t val ) {
+	try {
+		uint8_t packed = ( val << TOP_SHIFT ) bitor ( val << LEFT_SHIFT ) bitor ( val << ORIGINAL_TOP_SHIFT ) bitor ( val << ORIGINAL_LEFT_SHIFT );
+		std::fill( wallPlane.begin(), wallPlane.end(), packed );
+		wallsChanged = true;
+		layoutChanged = true;
+		std::fill( bottomBorder.begin(), bottomBorder.end(), val );
+		std::fill( rightBorder.begin(), rightBorder.end(), val );
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGrid::fillWalls(): " << e.what() << std::endl;
+	}
+}
+
+bool MazeGrid::isDeadEnd( coordinate_t x, coordinate_t y ) const {
+	try {
+		uint_fast8_t numOpen = 0;
+
+		if( getTop( x, y ) == MazeCell::NONE ) {
+			numOpen += 1;
+		}
+		if( getLeft( x, y ) == MazeCell::NONE ) {
+			numOpen += 1;
+		}
+		if( getBottom( x, y ) == MazeCell::NONE ) {
+			numOpen += 1;
+		}
+		if( getRight( x, y ) == MazeCell::NONE ) {
+			numOpen += 1;
+		}
+
+		return ( numOpen == 1 );
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGrid::isDeadEnd(): " << e.what() << std::endl;
+		return false;
+	}
+}
+
+uint_fast64_t MazeGrid::getWallsVersion() const {
+	if( wallsChanged ) {
+		wallsVersion = ++lastWallsVersion;
+		wallsChanged = false;
+	}
+	return wallsVersion;
+}
+
+uint_fast64_t MazeGrid::getLayoutVersion() const {
+	if( layoutChanged ) {
+		layoutVersion = ++lastWallsVersion;
+		layoutChanged = false;
+		wallChanges.clear();
+	}
+	return layoutVersion;
+}
+
+const std::vector< MazeGrid::WallChange >& MazeGrid::getWallChanges() const {
+	return wallChanges;
+}
+
+void MazeGrid::removeLocks() {
+	try {
+		wallsChanged = true;
+		for( decltype( wallPlane.size() ) i = 0; i < wallPlane.size(); ++i ) {
+			auto & walls = wallPlane[ i ];
+			if( ( ( walls >> TOP_SHIFT ) bitand 3 ) == MazeCell::LOCK ) {
+				walls = ( walls bitand compl ( 3 << TOP_SHIFT ) ) bitor ( MazeCell::NONE << TOP_SHIFT );
+				wallChanges.push_back( { static_cast< coordinate_t >( i % cols ), static_cast< coordinate_t >( i / cols ), false } );
+			}
+			if( ( ( walls >> LEFT_SHIFT ) bitand 3 ) == MazeCell::LOCK ) {
+				walls = ( walls bitand compl ( 3 << LEFT_SHIFT ) ) bitor ( MazeCell::NONE << LEFT_SHIFT );
+				wallChanges.push_back( { static_cast< coordinate_t >( i % cols ), static_cast< coordinate_t >( i / cols ), true } );
+			}
+		}
+
+		for( auto & border : bottomBorder ) {
+			if( border == MazeCell::LOCK ) {
+				border = MazeCell::NONE;
+			}
+		}
+
+		for( auto & border : rightBorder ) {
+			if( border == MazeCell::LOCK ) {
+				border = MazeCell::NONE;
+			}
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGrid::removeLocks(): " << e.what() << std::endl;
+	}
+}
+
+void MazeGrid::resize( coordinate_t newCols, coordinate_t newRows ) {
+	try {
+		cols = newCols;
+		rows = newRows;
+		wallsChanged = true;
+		layoutChanged = true;
+
+		uint_fast32_t numCells = static_cast< uint_fast32_t >( cols ) * rows;
+		uint8_t noWalls = ( MazeCell::NONE << TOP_SHIFT ) bitor ( MazeCell::NONE << LEFT_SHIFT ) bitor ( MazeCell::NONE << ORIGINAL_TOP_SHIFT ) bitor ( MazeCell::NONE << ORIGINAL_LEFT_SHIFT );
+
+		//assign() rather than resize() so that no state from the previous maze survives
+		wallPlane.assign( numCells, noWalls );
+		visibilityPlane.assign( numCells, 0 );
+		visitedPlane.assign( numCells, 0 );
+		colorPlane.assign( numCells, BLACK );
+		bottomBorder.assign( cols, MazeCell::NONE );
+		rightBorder.assign( rows, MazeCell::NONE );
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGrid::resize(): " << e.what() << std::endl;
+	}
+}
+
+void MazeGrid::setAllTopLeftVisible( bool val ) {
+	try {
+		for( auto & flags : visibilityPlane ) {
+			if( val ) {
+				flags or_eq ( TOP_VISIBLE bitor LEFT_VISIBLE );
+			} else {
+				flags and_eq compl ( TOP_VISIBLE bitor LEFT_VISIBLE );
+			}
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGrid::setAllTopLeftVisible(): " << e.what() << std::endl;
+	}
+}
+
+void MazeGrid::setOriginalBottom( coordinate_t x, coordinate_t y, MazeCell::border_t val ) {
+	try {
+		if( y + 1 < rows ) {
+			setOriginalTop( x, y + 1, val );
+		} else {
+			bottomBorder.at( x ) = val;
+			wallsChanged = true;
+			layoutChanged = true;
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGrid::setOriginalBottom(): " << e.what() << std::endl;
+	}
+}
+
+void MazeGrid::setOriginalRight( coordinate_t x, coordinate_t y, MazeCell::border_t val ) {
+	try {
+		if( x + 1 < cols ) {
+			setOriginalLeft( x + 1, y, val );
+		} else {
+			rightBorder.at( y ) = val;
+			wallsChanged = true;
+			layoutChanged = true;
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeGrid::setOriginalRight(): " << e.what() << std::endl;
+	}
+}
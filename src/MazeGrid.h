@@ -0,0 +1,226 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The MazeGrid class stores the state of every cell in the maze. Everything lives in flat, row-major arrays ("planes") so that scanning the whole maze walks memory in order: one byte of packed walls per cell, one byte of visibility flags per cell, one byte of visited flag per cell, and one visitor color per cell.
+ */
+
+#ifndef MAZEGRID_H
+#define MAZEGRID_H
+
+#ifdef WINDOWS
+    #include <irrlicht.h>
+#else
+    #include <irrlicht/irrlicht.h>
+#endif
+#ifdef HAVE_VECTOR
+	#include <vector>
+#endif //HAVE_VECTOR
+#include "Integers.h"
+#include "MazeCell.h"
+#include "PreprocessorCommands.h"
+
+class MazeGrid {
+	public:
+		/**
+		 * Constructor: makes an empty (zero by zero) grid.
+		 */
+		MazeGrid();
+		/**
+		 * Destructor: Does nothing.
+		 */
+		virtual ~MazeGrid();
+
+		/**
+		 * Discards the current contents and makes a grid of the given size. Every wall is NONE, no cell is visited or visible, and every visitor color is black.
+		 */
+		void resize( coordinate_t newCols, coordinate_t newRows );
+
+		/**
+		 * Returns the number of columns in the grid.
+		 */
+		inline coordinate_t getCols() const { return cols; }
+		/**
+		 * Returns the number of rows in the grid.
+		 */
+		inline coordinate_t getRows() const { return rows; }
+		/**
+		 * Returns the number of cells in the grid.
+		 */
+		inline uint_fast32_t getNumCells() const { return wallPlane.size(); }
+		/**
+		 * Returns whether the grid has any cells at all.
+		 */
+		inline bool empty() const { return wallPlane.empty(); }
+		/**
+		 * Returns the offset of cell (x,y) into the planes. Cells are stored row by row, so neighbors on the X axis are adjacent in memory.
+		 */
+		inline uint_fast32_t index( coordinate_t x, coordinate_t y ) const { return static_cast< uint_fast32_t >( y ) * cols + x; }
+
+		inline MazeCell::border_t getTop( coordinate_t x, coordinate_t y ) const { return getField( index( x, y ), TOP_SHIFT ); }
+		inline MazeCell::border_t getLeft( coordinate_t x, coordinate_t y ) const { return getField( index( x, y ), LEFT_SHIFT ); }
+		/**
+		 * For those solving algorithms that absolutely cannot be used on mazes that are no longer simply connected.
+		 */
+		inline MazeCell::border_t getOriginalTop( coordinate_t x, coordinate_t y ) const { return getField( index( x, y ), ORIGINAL_TOP_SHIFT ); }
+		inline MazeCell::border_t getOriginalLeft( coordinate_t x, coordinate_t y ) const { return getField( index( x, y ), ORIGINAL_LEFT_SHIFT ); }
+		/**
+		 * The bottom of a cell is the top of the cell below it. Only cells in the bottom row have a bottom of their own.
+		 */
+		inline MazeCell::border_t getBottom( coordinate_t x, coordinate_t y ) const {
+			if( y + 1 < rows ) {
+				return getTop( x, y + 1 );
+			} else {
+				return static_cast< MazeCell::border_t >( bottomBorder[ x ] );
+			}
+		}
+		/**
+		 * The right of a cell is the left of the cell beside it. Only cells in the rightmost column have a right of their own.
+		 */
+		inline MazeCell::border_t getRight( coordinate_t x, coordinate_t y ) const {
+			if( x + 1 < cols ) {
+				return getLeft( x + 1, y );
+			} else {
+				return static_cast< MazeCell::border_t >( rightBorder[ y ] );
+			}
+		}
+
+		/**
+		 * Changes the top wall without changing what getOriginalTop() returns. Used when players dissolve or unlock walls. The change goes in the list returned by getWallChanges().
+		 */
+		inline void setTop( coordinate_t x, coordinate_t y, MazeCell::border_t val ) {
+			setField( index( x, y ), TOP_SHIFT, val );
+			wallChanges.push_back( { x, y, false } );
+		}
+		inline void setLeft( coordinate_t x, coordinate_t y, MazeCell::border_t val ) {
+			setField( index( x, y ), LEFT_SHIFT, val );
+			wallChanges.push_back( { x, y, true } );
+		}
+		/**
+		 * Changes both the top wall and what getOriginalTop() returns. Used while building the maze.
+		 */
+		inline void setOriginalTop( coordinate_t x, coordinate_t y, MazeCell::border_t val ) {
+			setField( index( x, y ), ORIGINAL_TOP_SHIFT, val );
+			setField( index( x, y ), TOP_SHIFT, val );
+			layoutChanged = true;
+		}
+		inline void setOriginalLeft( coordinate_t x, coordinate_t y, MazeCell::border_t val ) {
+			setField( index( x, y ), ORIGINAL_LEFT_SHIFT, val );
+			setField( index( x, y ), LEFT_SHIFT, val );
+			layoutChanged = true;
+		}
+		/**
+		 * Sets the top of the cell below, or the maze border if (x,y) is in the bottom row.
+		 */
+		void setOriginalBottom( coordinate_t x, coordinate_t y, MazeCell::border_t val );
+		/**
+		 * Sets the left of the cell to the right, or the maze border if (x,y) is in the rightmost column.
+		 */
+		void setOriginalRight( coordinate_t x, coordinate_t y, MazeCell::border_t val );
+
+		inline bool hasTopLock( coordinate_t x, coordinate_t y ) const { return getTop( x, y ) == MazeCell::LOCK; }
+		inline bool hasLeftLock( coordinate_t x, coordinate_t y ) const { return getLeft( x, y ) == MazeCell::LOCK; }
+		inline bool hasLock( coordinate_t x, coordinate_t y ) const { return hasTopLock( x, y ) or hasLeftLock( x, y ); }
+		/**
+		 * Returns true if exactly one side of the cell is open.
+		 */
+		bool isDeadEnd( coordinate_t x, coordinate_t y ) const;
+		/**
+		 * Turns every lock in the maze into NONE, in a single pass over the wall plane.
+		 */
+		void removeLocks();
+		/**
+		 * Returns a number which changes whenever any wall changes, and which no other grid's walls have ever had. Anything worked out from the walls (such as DistanceFields) stays good for as long as this stays the same, even if grids get swapped.
+		 */
+		uint_fast64_t getWallsVersion() const;
+		/**
+		 * Like getWallsVersion(), but doesn't change when walls are changed by setTop(), setLeft(), or removeLocks(); those changes are listed by getWallChanges() instead. Anything worked out from the walls which can be patched up a wall at a time (such as the JunctionGraph) only has to start over when this changes.
+		 */
+		uint_fast64_t getLayoutVersion() const;
+
+		struct WallChange {
+			coordinate_t x;
+			coordinate_t y;
+			bool left; ///< True if the cell's left wall changed, false if its top did
+		};
+		/**
+		 * Returns every wall changed by setTop(), setLeft(), or removeLocks() since the layout version last changed, oldest first. Changes to the bottom and right maze borders aren't listed, since nobody can walk through those anyway.
+		 */
+		const std::vector< WallChange >& getWallChanges() const;
+
+		inline bool isVisited( coordinate_t x, coordinate_t y ) const { return visitedPlane[ index( x, y ) ] not_eq 0; }
+		inline void setVisited( coordinate_t x, coordinate_t y, bool val ) { visitedPlane[ index( x, y ) ] = val; }
+		/**
+		 * Marks every cell as unvisited.
+		 */
+		void clearVisited();
+
+		inline irr::video::SColor getVisitorColor( coordinate_t x, coordinate_t y ) const { return colorPlane[ index( x, y ) ]; }
+		inline void setVisitorColor( coordinate_t x, coordinate_t y, irr::video::SColor color ) { colorPlane[ index( x, y ) ] = color; }
+
+		inline bool isTopVisible( coordinate_t x, coordinate_t y ) const { return visibilityPlane[ index( x, y ) ] bitand TOP_VISIBLE; }
+		inline bool isLeftVisible( coordinate_t x, coordinate_t y ) const { return visibilityPlane[ index( x, y ) ] bitand LEFT_VISIBLE; }
+		inline bool isBottomVisible( coordinate_t x, coordinate_t y ) const { return visibilityPlane[ index( x, y ) ] bitand BOTTOM_VISIBLE; }
+		inline bool isRightVisible( coordinate_t x, coordinate_t y ) const { return visibilityPlane[ index( x, y ) ] bitand RIGHT_VISIBLE; }
+		inline void setTopVisible( coordinate_t x, coordinate_t y, bool val ) { setFlag( index( x, y ), TOP_VISIBLE, val ); }
+		inline void setLeftVisible( coordinate_t x, coordinate_t y, bool val ) { setFlag( index( x, y ), LEFT_VISIBLE, val ); }
+		inline void setBottomVisible( coordinate_t x, coordinate_t y, bool val ) { setFlag( index( x, y ), BOTTOM_VISIBLE, val ); }
+		inline void setRightVisible( coordinate_t x, coordinate_t y, bool val ) { setFlag( index( x, y ), RIGHT_VISIBLE, val ); }
+		/**
+		 * Sets the top and left visibility of every cell at once. Bottom and right visibility are left alone since they only matter on the maze border.
+		 */
+		void setAllTopLeftVisible( bool val );
+
+		/**
+		 * Sets the top and left (and original top and left) of every cell, and the bottom and right maze borders, in one pass.
+		 */
+		void fillWalls( MazeCell::border_t val );
+	protected:
+	private:
+		enum shift_t : uint_fast8_t { TOP_SHIFT = 0, LEFT_SHIFT = 2, ORIGINAL_TOP_SHIFT = 4, ORIGINAL_LEFT_SHIFT = 6 };
+		enum visibility_t : uint8_t { TOP_VISIBLE = 1, LEFT_VISIBLE = 2, BOTTOM_VISIBLE = 4, RIGHT_VISIBLE = 8 };
+
+		inline MazeCell::border_t getField( uint_fast32_t i, shift_t shift ) const { return static_cast< MazeCell::border_t >( ( wallPlane[ i ] >> shift ) bitand 3 ); }
+		inline void setField( uint_fast32_t i, shift_t shift, MazeCell::border_t val ) {
+			wallPlane[ i ] = ( wallPlane[ i ] bitand compl ( 3 << shift ) ) bitor ( val << shift );
+			wallsChanged = true;
+		}
+		inline void setFlag( uint_fast32_t i, visibility_t flag, bool val ) {
+			if( val ) {
+				visibilityPlane[ i ] or_eq flag;
+			} else {
+				visibilityPlane[ i ] and_eq compl flag;
+			}
+		}
+
+		coordinate_t cols;
+		coordinate_t rows;
+
+		//Building a maze changes walls millions of times, so changes only set a flag; getWallsVersion() takes a new number when it sees the flag.
+		mutable bool wallsChanged;
+		mutable uint_fast64_t wallsVersion;
+		mutable bool layoutChanged;
+		mutable uint_fast64_t layoutVersion;
+		mutable std::vector< WallChange > wallChanges; //getLayoutVersion() empties this when it takes a new number, since anything depending on the old layout has to start over anyway
+
+		std::vector< uint8_t > wallPlane; //Two bits each for top, left, original top, and original left.
+		std::vector< uint8_t > visibilityPlane; //One bit each for top, left, bottom, and right.
+		std::vector< uint8_t > visitedPlane;
+		std::vector< irr::video::SColor > colorPlane;
+
+		std::vector< uint8_t > bottomBorder; //One per column: the bottom of the bottom row.
+		std::vector< uint8_t > rightBorder; //One per row: the right of the rightmost column.
+};
+
+#endif // MAZEGRID_H
@@ -19,74 +19,96 @@
 #include "colors.h"
 #include "CustomException.h"
 #include "MazeManager.h"
-#include "MainGame.h"
+#include "StringConverter.h"
 #include "SettingsManager.h"
 
+#include <algorithm>
 #include <boost/filesystem/fstream.hpp>
 #ifdef HAVE_IOSTREAM
 #include <iostream>
 #endif //HAVE_IOSTREAM
 
 
-//Recursively searches the maze to see if it can get from start to end
-bool MazeManager::canGetTo( uint_fast8_t startX, uint_fast8_t startY, uint_fast8_t goalX, uint_fast8_t goalY ) {
+//Moves the loading screen's progress bar along, unless this maze is being made in the background
+void MazeManager::addLoadingProgress( float percent ) {
 	try {
-		bool found = false;
+		if( showProgress ) {
+			mainGame->setLoadingPercentage( mainGame->getLoadingPercentage() + percent );
+			mainGame->drawAll();
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeManager::addLoadingProgress(): " << e.what() << std::endl;
+	}
+}
+
+//Checks every collectable at once with a single flood fill, using the Reachability object's own visited flags so that players' trails are left alone
+bool MazeManager::canGetToAllCollectables( coordinate_t startX, coordinate_t startY ) {
+	try {
+		std::vector< uint_fast32_t > targets;
+		targets.reserve( stuff.size() );
 		
-		maze[ startX ][ startY ].visited = true;
+		for( decltype( stuff.size() ) i = 0; i < stuff.size(); ++i ) {
+			targets.push_back( maze.index( stuff[ i ].getX(), stuff[ i ].getY() ) );
+		}
 		
-		if( startX == goalX and startY == goalY ) {
-			found = true;
-		} else {
-			if( startY > 0 and maze[ startX ][ startY ].getTop() == MazeCell::NONE and maze[ startX ][ startY - 1 ].visited == false ) {
-				found = canGetTo( startX, startY - 1, goalX, goalY );
-			}
-			
-			if( found == false and startY < ( rows - 1 ) and maze[ startX ][ startY + 1 ].getTop() == MazeCell::NONE and maze[ startX ][ startY + 1 ].visited == false ) {
-				found = canGetTo( startX, startY + 1, goalX, goalY );
-			}
-			
-			if( found == false and startX < ( cols - 1 ) and maze[ startX + 1 ][ startY ].getLeft() == MazeCell::NONE and maze[ startX + 1 ][ startY ].visited == false ) {
-				found = canGetTo( startX + 1, startY, goalX, goalY );
-			}
-			
-			if( found == false and startX > 0 and maze[ startX ][ startY ].getLeft() == MazeCell::NONE and maze[ startX - 1 ][ startY ].visited == false ) {
-				found = canGetTo( startX - 1, startY, goalX, goalY );
+		treeDistances.update( maze );
+		if( treeDistances.isTree() ) { //No need to flood the whole maze: each collectable only has one way to it
+			auto start = maze.index( startX, startY );
+			for( decltype( targets.size() ) t = 0; t < targets.size(); ++t ) {
+				if( treeDistances.distance( start, targets[ t ] ) == TreeDistances::UNREACHABLE ) {
+					return false;
+				}
 			}
+			return true;
 		}
-		
-		return found;
+		return reachability.canReachAll( maze, startX, startY, targets );
 	} catch ( std::exception &e ) {
-		std::wcerr << L"Error in MazeManager::canGetTo(): " << e.what() << std::endl;
+		std::wcerr << L"Error in MazeManager::canGetToAllCollectables(): " << e.what() << std::endl;
 		return false;
 	}
 }
 
-//Iterates through all collectables, calls canGetTo on their locations
-bool MazeManager::canGetToAllCollectables( uint_fast8_t startX, uint_fast8_t startY ) {
+//Breadth-first search outward from the root cell, remembering how each cell was reached
+void MazeManager::findPathsFrom( coordinate_t rootX, coordinate_t rootY, std::vector< uint_fast32_t >& parent, std::vector< uint_fast32_t >& order ) {
 	try {
-		bool result = true;
-
-		for( decltype( mainGame->stuff.size() ) i = 0; ( i < mainGame->stuff.size() and result == true ); ++i ) {
-
-			//Do this here because canGetTo() uses the visited variable
-			for( decltype( cols ) x = 0; x < cols; ++x ) {
-				for( decltype( rows ) y = 0; y < rows; ++y ) {
-					maze[ x ][ y ].visited = false;
+		parent.assign( maze.getNumCells(), UINT_FAST32_MAX );
+		order.clear();
+		if( maze.empty() ) {
+			return;
+		}
+		order.reserve( maze.getNumCells() );
+		
+		uint_fast32_t root = maze.index( rootX, rootY );
+		parent[ root ] = root;
+		order.push_back( root );
+		
+		for( decltype( order.size() ) i = 0; i < order.size(); ++i ) {
+			uint_fast32_t cell = order[ i ];
+			coordinate_t x = cell % cols;
+			coordinate_t y = cell / cols;
+			
+			auto visit = [ & ]( uint_fast32_t neighbor ) {
+				if( parent[ neighbor ] == UINT_FAST32_MAX ) {
+					parent[ neighbor ] = cell;
+					order.push_back( neighbor );
 				}
+			};
+			
+			if( y > 0 and maze.getTop( x, y ) == MazeCell::NONE ) {
+				visit( cell - cols );
 			}
-
-			bool otherResult = canGetTo( startX, startY, mainGame->stuff[ i ].getX(), mainGame->stuff[ i ].getY() );
-
-			if( otherResult == false ) {
-				result = false;
+			if( y < rows - 1 and maze.getTop( x, y + 1 ) == MazeCell::NONE ) {
+				visit( cell + cols );
+			}
+			if( x > 0 and maze.getLeft( x, y ) == MazeCell::NONE ) {
+				visit( cell - 1 );
+			}
+			if( x < cols - 1 and maze.getLeft( x + 1, y ) == MazeCell::NONE ) {
+				visit( cell + 1 );
 			}
 		}
-
-		return result;
 	} catch ( std::exception &e ) {
-		std::wcerr << L"Error in MazeManager::canGetToAllCollectables(): " << e.what() << std::endl;
-		return false;
+		std::wcerr << L"Error in MazeManager::findPathsFrom(): " << e.what() << std::endl;
 	}
 }
 
@@ -142,43 +164,43 @@ void MazeManager::draw( irr::IrrlichtDevice* device, uint_fast16_t cellWidth, ui
 		
 		irr::core::position2d< irr::s32 > shadowOffset( 1, 1 );
 
-		for( decltype( cols ) x = 0; x < cols; ++x ) {
-			for( decltype( rows ) y = 0; y < rows; ++y ) {
-				if( maze[ x ][ y ].topVisible ) {
-					if( maze[ x ][ y ].getTop() == MazeCell::WALL ) {
+		for( decltype( rows ) y = 0; y < rows; ++y ) { //Row by row, since that's the order the cells are stored in
+			for( decltype( cols ) x = 0; x < cols; ++x ) {
+				if( maze.isTopVisible( x, y ) ) {
+					if( maze.getTop( x, y ) == MazeCell::WALL ) {
 						driver->draw2DLine( shadowOffset + irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * y ), shadowOffset + irr::core::position2d< irr::s32 >( cellWidth * ( x + 1 ), cellHeight * y ), wallShadowColor );
 						driver->draw2DLine( irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * y ), irr::core::position2d< irr::s32 >( cellWidth * ( x + 1 ), cellHeight * y ), wallColor );
-					} else if( maze[ x ][ y ].getTop() == MazeCell::ACIDPROOF ) {
+					} else if( maze.getTop( x, y ) == MazeCell::ACIDPROOF ) {
 						driver->draw2DLine( shadowOffset + irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * y ), shadowOffset + irr::core::position2d< irr::s32 >( cellWidth * ( x + 1 ), cellHeight * y ), acidProofWallShadowColor );
 						driver->draw2DLine( irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * y ), irr::core::position2d< irr::s32 >( cellWidth * ( x + 1 ), cellHeight * y ), acidProofWallColor );
-					} else if( maze[ x ][ y ].getTop() == MazeCell::LOCK ) {
+					} else if( maze.getTop( x, y ) == MazeCell::LOCK ) {
 						driver->draw2DLine( shadowOffset + irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * y ), shadowOffset + irr::core::position2d< irr::s32 >( cellWidth * ( x + 1 ), cellHeight * y ), lockShadowColor );
 						driver->draw2DLine( irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * y ), irr::core::position2d< irr::s32 >( cellWidth * ( x + 1 ), cellHeight * y ), lockColor );
 					}
 				}
 				
-				if( maze[ x ][ y ].leftVisible ) {
-					if( maze[ x ][ y ].getLeft() == MazeCell::WALL ) {
+				if( maze.isLeftVisible( x, y ) ) {
+					if( maze.getLeft( x, y ) == MazeCell::WALL ) {
 						driver->draw2DLine( shadowOffset + irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * y ), shadowOffset + irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * ( y + 1 ) ), wallShadowColor );
 						driver->draw2DLine( irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * y ), irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * ( y + 1 ) ), wallColor );
-					} else if( maze[ x ][ y ].getLeft() == MazeCell::ACIDPROOF ) {
+					} else if( maze.getLeft( x, y ) == MazeCell::ACIDPROOF ) {
 						driver->draw2DLine( shadowOffset + irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * y ), shadowOffset + irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * ( y + 1 ) ), acidProofWallShadowColor );
 						driver->draw2DLine( irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * y ), irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * ( y + 1 ) ), acidProofWallColor );
-					} else if( maze[ x ][ y ].getLeft() == MazeCell::LOCK ) {
+					} else if( maze.getLeft( x, y ) == MazeCell::LOCK ) {
 						driver->draw2DLine( shadowOffset + irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * y ), shadowOffset + irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * ( y + 1 ) ), lockShadowColor );
 						driver->draw2DLine( irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * y ), irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * ( y + 1 ) ), lockColor );
 					}
 				}
 				
-				if( maze[ x ][ y ].rightVisible ) {
+				if( maze.isRightVisible( x, y ) ) {
 					//Only cells on the right or bottom edge of the maze should have anything other than NONE as right or bottom, and then it should only be a solid WALL
-					if( maze[ x ][ y ].getRight() == MazeCell::ACIDPROOF ) {
+					if( maze.getRight( x, y ) == MazeCell::ACIDPROOF ) {
 						driver->draw2DLine( shadowOffset + irr::core::position2d< irr::s32 >( cellWidth * ( x + 1 ), cellHeight * y ), shadowOffset + irr::core::position2d< irr::s32 >( cellWidth * ( x + 1 ), cellHeight * ( y + 1 ) ), wallShadowColor );
 						driver->draw2DLine( irr::core::position2d< irr::s32 >( cellWidth * ( x + 1 ), cellHeight * y ), irr::core::position2d< irr::s32 >( cellWidth * ( x + 1 ), cellHeight * ( y + 1 ) ), acidProofWallColor );
 					}
 				}
-				if( maze[ x ][ y ].bottomVisible ) {	
-					if( maze[ x ][ y ].getBottom() == MazeCell::ACIDPROOF ) {
+				if( maze.isBottomVisible( x, y ) ) {	
+					if( maze.getBottom( x, y ) == MazeCell::ACIDPROOF ) {
 						driver->draw2DLine( shadowOffset + irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * ( y + 1 ) ), shadowOffset + irr::core::position2d< irr::s32 >( cellWidth * ( x + 1 ), cellHeight * ( y + 1 ) ), wallShadowColor );
 						driver->draw2DLine( irr::core::position2d< irr::s32 >( cellWidth * x, cellHeight * ( y + 1 ) ), irr::core::position2d< irr::s32 >( cellWidth * ( x + 1 ), cellHeight * ( y + 1 ) ), acidProofWallColor );
 					}
@@ -198,349 +220,432 @@ irr::core::stringw MazeManager::getFileTypeName() const {
 	return fileTypeName;
 }
 
+std::minstd_rand::result_type MazeManager::getRandomNumber() {
+	return randomNumberGenerator();
+}
+
+const std::minstd_rand& MazeManager::getRandomNumberGenerator() const {
+	return randomNumberGenerator;
+}
+
+MazeManager::LevelSettings MazeManager::getCurrentSettings() const {
+	LevelSettings current;
+	try {
+		current.numPlayers = settingsManager->getNumPlayers();
+		current.mazeSize = settingsManager->getMazeSize();
+		current.generator = settingsManager->getMazeGenerator();
+		current.policy = settingsManager->getGrowingTreePolicy();
+		current.endless = settingsManager->getEndlessMazes() and not mainGame->isConnected();
+		current.hideUnseen = settingsManager->getHideUnseen();
+		current.colorMode = settingsManager->colorMode;
+		current.debug = mainGame->getDebugStatus();
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeManager::getCurrentSettings(): " << e.what() << std::endl;
+	}
+	return current;
+}
+
+
 
+void MazeManager::lockPassage( uint_fast32_t cell, uint_fast32_t neighbor ) {
+	try {
+		//Every wall is either the top or the left of the cell below or to the right of it
+		uint_fast32_t lower = std::max( cell, neighbor );
+		coordinate_t x = lower % cols;
+		coordinate_t y = lower / cols;
+		
+		if( lower - std::min( cell, neighbor ) == cols ) {
+			maze.setOriginalTop( x, y, MazeCell::LOCK );
+		} else {
+			maze.setOriginalLeft( x, y, MazeCell::LOCK );
+		}
+		
+		if( levelSettings.debug ) {
+			debugLog << L"Placed lock at " << x << L"x" << y << std::endl;
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeManager::lockPassage(): " << e.what() << std::endl;
+	}
+}
 
 //Figures out which cells should be visible from the given position
-void MazeManager::makeCellsVisible( uint_fast8_t x, uint_fast8_t y ) {
+void MazeManager::makeCellsVisible( coordinate_t x, coordinate_t y ) {
 	if( settingsManager->getHideUnseen() ) { //No need to do anything if they're all visible anyway
 		for( auto yprime = y; yprime <= y; --yprime ) { //When yprime wraps around, we're done
-			maze[ x ][ yprime ].topVisible = true;
-			if( maze[ x ][ yprime ].getTop() not_eq MazeCell::NONE ) {
+			maze.setTopVisible( x, yprime, true );
+			if( maze.getTop( x, yprime ) not_eq MazeCell::NONE ) {
 				break;
 			}
 		}
 		for( auto yprime = y + 1; yprime < rows; ++yprime ) {
-			maze[ x ][ yprime ].topVisible = true;
-			if( maze[ x ][ yprime ].getTop() not_eq MazeCell::NONE ) {
+			maze.setTopVisible( x, yprime, true );
+			if( maze.getTop( x, yprime ) not_eq MazeCell::NONE ) {
 				break;
 			}
 		}
 		for( auto xprime = x; xprime <= x; --xprime ) { //When xprime wraps around, we're done
-			maze[ xprime ][ y ].leftVisible = true;
-			if( maze[ xprime ][ y ].getLeft() not_eq MazeCell::NONE ) {
+			maze.setLeftVisible( xprime, y, true );
+			if( maze.getLeft( xprime, y ) not_eq MazeCell::NONE ) {
 				break;
 			}
 		}
 		for( auto xprime = x + 1; xprime < cols; ++xprime ) {
-			maze[ xprime ][ y ].leftVisible = true;
-			if( maze[ xprime ][ y ].getLeft() not_eq MazeCell::NONE ) {
+			maze.setLeftVisible( xprime, y, true );
+			if( maze.getLeft( xprime, y ) not_eq MazeCell::NONE ) {
 				break;
 			}
 		}
 	}
 }
 
-//Does everything involved in making the maze, calls other functions as needed.
+//True if nothing that affects makeRandomLevel() differs from what made this maze
+bool MazeManager::madeWithSettings( const LevelSettings& settings ) const {
+	try {
+		return ( levelSettings.numPlayers == settings.numPlayers
+			and levelSettings.mazeSize == settings.mazeSize
+			and levelSettings.generator == settings.generator
+			and levelSettings.policy == settings.policy
+			and levelSettings.hideUnseen == settings.hideUnseen
+			and levelSettings.colorMode == settings.colorMode
+			and levelSettings.debug == settings.debug //Debugging always adds acid
+			and not levelSettings.endless
+			and not settings.endless );
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeManager::madeWithSettings(): " << e.what() << std::endl;
+		return false;
+	}
+}
+
 void MazeManager::makeRandomLevel() {
+	levelSettings = getCurrentSettings();
+	makeLevel( 0, 0 );
+	printDebugLog();
+}
+
+void MazeManager::makeRandomLevel( const LevelSettings& settings ) {
+	levelSettings = settings;
+	makeLevel( 0, 0 );
+}
+
+void MazeManager::makeRandomLevelOfSize( coordinate_t newCols, coordinate_t newRows ) {
+	levelSettings = getCurrentSettings();
+	makeLevel( std::max< coordinate_t >( newCols, 1 ), std::max< coordinate_t >( newRows, 1 ) );
+	printDebugLog();
+}
+
+//Does everything involved in making the maze, calls other functions as needed.
+void MazeManager::makeLevel( coordinate_t exactCols, coordinate_t exactRows ) {
 	try {
-		mainGame->drawAll();
+		addLoadingProgress( 0 );
+		debugLog.str( L"" );
 		// Flawfinder: ignore
 		//srand( mainGame->randomSeed ); //randomSeed is set either by resetThings() or by loadFromFile()
-		{
-			decltype( cols ) tempCols = mainGame->getRandomNumber() % 28 + 2; //I don't remember where I got the 28. The 2 is arbitrary so there's some minimum amount.
-			decltype( rows ) tempRows = tempCols + ( mainGame->getRandomNumber() % 5 ); //Again, no idea where the 5 came from.
-			newMaze( tempCols, tempRows );
-		}
-		mainGame->setLoadingPercentage( mainGame->getLoadingPercentage() + 1 );
-		mainGame->drawAll();
+		bool endless = levelSettings.endless and exactCols == 0;
 		
-		//Set whether the cells are visible. Those on the border are changed later.
-		for( decltype( cols ) x = 0; x < cols; ++x ) {
-			for( decltype( rows ) y = 0; y < rows; ++y ) {
-				maze[ x ][ y ].setOriginalTop( MazeCell::WALL );
-				maze[ x ][ y ].setOriginalLeft( MazeCell::WALL );
-				maze[ x ][ y ].setOriginalRight( MazeCell::NONE );
-				maze[ x ][ y ].setOriginalBottom( MazeCell::NONE );
-				maze[ x ][ y ].visited = false;
+		if( not endless ) {
+			endlessMaze.reset();
+			
+			if( exactCols > 0 ) {
+				newMaze( exactCols, exactRows );
+			} else {
+				decltype( cols ) tempCols = getRandomNumber() % ( levelSettings.mazeSize - 2 ) + 2; //The maze size preference defaults to 30, which gives the same 2 to 29 columns as the original hard-coded "% 28 + 2". The 2 is arbitrary so there's some minimum amount.
+				decltype( rows ) tempRows = tempCols + ( getRandomNumber() % 5 ); //Again, no idea where the 5 came from.
+				newMaze( tempCols, tempRows );
 			}
+		} else {
+			if( not endlessMaze ) {
+				decltype( cols ) tempCols = getRandomNumber() % ( levelSettings.mazeSize - 2 ) + 2;
+				endlessMaze.reset( new EndlessMaze( tempCols, getRandomNumber(), 2 ) );
+			}
+			
+			newMaze( endlessMaze->getCols(), endlessMaze->getNextSegmentRows() );
 		}
-		setAllCellsVisibility();
+		addLoadingProgress( 1 );
 		
-		mainGame->setLoadingPercentage( mainGame->getLoadingPercentage() + 1 );
-		mainGame->drawAll();
+		//Start with every wall in place; the maze generator knocks them down. The maze borders are changed later.
+		maze.fillWalls( MazeCell::WALL );
+		maze.clearVisited();
+		maze.setAllTopLeftVisible( not levelSettings.hideUnseen ); //Same as setAllCellsVisibility(), without asking the settings manager
+		
+		addLoadingProgress( 1 );
 
-		for( decltype( settingsManager->getNumPlayers() ) p = 0; p < settingsManager->getNumPlayers(); ++p ) {
-			mainGame->playerStart[ p ].reset();
+		stuff.clear();
+		numLocks = 0;
+		playerStart.resize( levelSettings.numPlayers );
+		for( decltype( playerStart.size() ) p = 0; p < playerStart.size(); ++p ) {
+			playerStart[ p ].reset();
 		}
 		
-		{
-			decltype( cols ) goalX = mainGame->getRandomNumber() % cols;
-			decltype( rows ) goalY = mainGame->getRandomNumber() % rows;
-			mainGame->goal.setX( goalX );
-			mainGame->goal.setY( goalY );
-			//Make the goal inaccessible unless we've found all the keys (locks are place elsewhere in the code but one lock does get placed at the goal)
-			maze[ goalX ][ goalY ].setOriginalTop( MazeCell::ACIDPROOF );
-			maze[ goalX ][ goalY ].setOriginalLeft( MazeCell::ACIDPROOF );
-			if( goalX < ( cols - 1 ) ) {
-				maze[ goalX + 1 ][ goalY ].setOriginalLeft( MazeCell::ACIDPROOF );
+		if( endless ) { //The next piece of the endless maze is already made, so all there is to do is copy it. Players start where they came in from the previous piece, and the goal is where they'll go out to the next one.
+			coordinate_t entryX;
+			coordinate_t exitX;
+			endlessMaze->takeSegment( maze, entryX, exitX );
+			
+			goalX = exitX;
+			goalY = rows - 1;
+			if( maze.getTop( exitX, rows - 1 ) not_eq MazeCell::NONE ) {
+				maze.setOriginalTop( exitX, rows - 1, MazeCell::ACIDPROOF );
+			}
+			if( maze.getLeft( exitX, rows - 1 ) not_eq MazeCell::NONE ) {
+				maze.setOriginalLeft( exitX, rows - 1, MazeCell::ACIDPROOF );
+			}
+			if( maze.getRight( exitX, rows - 1 ) not_eq MazeCell::NONE ) {
+				maze.setOriginalRight( exitX, rows - 1, MazeCell::ACIDPROOF );
 			}
-			if( goalY < ( rows - 1 ) ) {
-				maze[ goalX ][ goalY + 1 ].setOriginalTop( MazeCell::ACIDPROOF );
+			
+			for( decltype( playerStart.size() ) p = 0; p < playerStart.size(); ++p ) {
+				playerStart[ p ].setPos( entryX, 0 );
+			}
+		} else {
+			goalX = getRandomNumber() % cols;
+			goalY = getRandomNumber() % rows;
+			//Make the goal inaccessible unless we've found all the keys (locks are place elsewhere in the code but one lock does get placed at the goal)
+			maze.setOriginalTop( goalX, goalY, MazeCell::ACIDPROOF );
+			maze.setOriginalLeft( goalX, goalY, MazeCell::ACIDPROOF );
+			maze.setOriginalRight( goalX, goalY, MazeCell::ACIDPROOF );
+			maze.setOriginalBottom( goalX, goalY, MazeCell::ACIDPROOF );
+			
+			if( showProgress ) { //Generation takes up about 90% of loading time. That's not based on any measurements, it's just a guess.
+				auto percentageBeforeGenerating = mainGame->getLoadingPercentage();
+				generator.progressCallback = [ this, percentageBeforeGenerating ]( float fractionDone ) {
+					mainGame->setLoadingPercentage( percentageBeforeGenerating + ( 90.0f * fractionDone ) );
+					mainGame->drawAll();
+				};
+			} else {
+				generator.progressCallback = nullptr;
 			}
 			
-			recurseRandom( goalX, goalY, 0, 0 ); //Start recursion from the goal's position; for some reason that makes the mazes harder than if we started recursion from the player's starting point.
+			generator.setAlgorithm( levelSettings.generator );
+			generator.setPolicy( levelSettings.policy );
+			generator.generate( maze, goalX, goalY ); //Start from the goal's position; for some reason that makes the mazes harder than if we started from the player's starting point.
+			
+			//Players start as far from the goal as possible
+			for( decltype( playerStart.size() ) p = 0; p < playerStart.size(); ++p ) {
+				playerStart[ p ].setPos( generator.getFarthestX(), generator.getFarthestY() );
+				playerStart[ p ].distanceFromExit = generator.getFarthestDistance();
+			}
 		}
 		
-		mainGame->setLoadingPercentage( mainGame->getLoadingPercentage() + 1 );
-		mainGame->drawAll();
+		addLoadingProgress( 1 );
 		
-		//Add walls at maze borders
 		//Add walls at maze borders
 		for( decltype( cols ) x = 0; x < cols; ++x ) {
-			maze[ x ][ 0 ].setOriginalTop( MazeCell::ACIDPROOF );
-			maze[ x ][ 0 ].topVisible = true;
-			maze[ x ][ rows-1 ].setOriginalBottom( MazeCell::ACIDPROOF );
-			maze[ x ][ rows-1 ].bottomVisible = true;
+			maze.setOriginalTop( x, 0, MazeCell::ACIDPROOF );
+			maze.setTopVisible( x, 0, true );
+			maze.setOriginalBottom( x, rows - 1, MazeCell::ACIDPROOF );
+			maze.setBottomVisible( x, rows - 1, true );
 		}
 		
 		for( decltype( rows ) y = 0; y < rows; ++y ) {
-			maze[ 0 ][ y ].setOriginalLeft( MazeCell::ACIDPROOF );
-			maze[ 0 ][ y ].leftVisible = true;
-			maze[ cols-1 ][ y ].setOriginalRight( MazeCell::ACIDPROOF );
-			maze[ cols-1 ][ y ].rightVisible = true;
+			maze.setOriginalLeft( 0, y, MazeCell::ACIDPROOF );
+			maze.setLeftVisible( 0, y, true );
+			maze.setOriginalRight( cols - 1, y, MazeCell::ACIDPROOF );
+			maze.setRightVisible( cols - 1, y, true );
 		}
 		
-		mainGame->setLoadingPercentage( mainGame->getLoadingPercentage() + 1 );
-		mainGame->drawAll();
-		
-		//Make MazeCell::isDeadEnd() work
-		for( decltype( cols ) x = 1; x < cols; ++x ) {
-			for( decltype( rows ) y = 0; y < rows; ++y ) {
-				maze[ x-1 ][ y ].setOriginalRight( maze[ x ][ y ].getLeft() );
+		//MazeGrid works out each cell's bottom and right from its neighbors, so the borders above are all they need.
+		addLoadingProgress( 2 );
+
+		//Find all dead ends, as indices into maze. The generator lists them as it carves; endless mazes come from EndlessMaze instead, so theirs have to be looked for.
+		std::vector< uint_fast32_t > deadEnds;
+		if( endless ) {
+			for( decltype( cols ) x = 0; x < cols; ++x ) {
+				for( decltype( rows ) y = 0; y < rows; ++y ) {
+					if( maze.isDeadEnd( x, y ) ) {
+						deadEnds.push_back( maze.index( x, y ) );
+					}
+				}
 			}
+		} else {
+			deadEnds = generator.getDeadEnds();
 		}
-		for( decltype( cols ) x = 0; x < cols; ++x ) {
-			for( decltype( rows ) y = 1; y < rows; ++y ) {
-				maze[ x ][ y-1 ].setOriginalBottom( maze[ x ][ y ].getTop() );
+		
+		addLoadingProgress( 1 );
+		
+		//The maze is a tree, so looking at it from the first player's start tells us which passages each key depends on. pathsParent and pathsOrder are used again below when placing locks.
+		std::vector< uint_fast32_t > pathsParent;
+		std::vector< uint_fast32_t > pathsOrder;
+		findPathsFrom( playerStart.at( 0 ).getX(), playerStart.at( 0 ).getY(), pathsParent, pathsOrder );
+		
+		//Anything past the goal can only be reached through the goal, which is going to get locked, so don't put keys there. Parents come before their children in pathsOrder, so one pass is enough.
+		std::vector< bool > pastGoal( maze.getNumCells(), true );
+		if( not maze.empty() ) {
+			uint_fast32_t goalCell = maze.index( goalX, goalY );
+			for( decltype( pathsOrder.size() ) i = 0; i < pathsOrder.size(); ++i ) {
+				uint_fast32_t cell = pathsOrder[ i ];
+				pastGoal[ cell ] = ( cell == goalCell or ( i > 0 and pastGoal[ pathsParent[ cell ] ] ) );
 			}
 		}
 		
-		mainGame->setLoadingPercentage( mainGame->getLoadingPercentage() + 1 );
-		mainGame->drawAll();
-
-		//Find all dead ends. I'm sure it would be more efficient to do this during maze generation rather than going back through afterward, but I can't be bothered with that now.
-		std::vector< decltype( cols ) > deadEndsX;
-		std::vector< decltype( rows ) > deadEndsY;
-
-		for( decltype( cols ) x = 0; x < cols; ++x ) {
-			for( decltype( rows ) y = 0; y < rows; ++y ) {
-				if( maze[ x ][ y ].isDeadEnd() ) {
-					deadEndsX.push_back( x );
-					deadEndsY.push_back( y );
+		addLoadingProgress( 1 );
+		
+		{ //Leave out the player starts, the goal (which is past itself), and everything past the goal, keeping the rest in order
+			decltype( deadEnds.size() ) kept = 0;
+			for( decltype( deadEnds.size() ) i = 0; i < deadEnds.size(); ++i ) {
+				bool usable = not pastGoal[ deadEnds[ i ] ];
+				for( decltype( playerStart.size() ) p = 0; usable and p < playerStart.size(); ++p ) {
+					usable = ( deadEnds[ i ] not_eq maze.index( playerStart[ p ].getX(), playerStart[ p ].getY() ) );
+				}
+				if( usable ) {
+					deadEnds[ kept ] = deadEnds[ i ];
+					kept += 1;
 				}
 			}
+			deadEnds.resize( kept );
 		}
 		
-		mainGame->setLoadingPercentage( mainGame->getLoadingPercentage() + 1 );
-		mainGame->drawAll();
-
-		//Remove player starts from list of dead ends
-		for( decltype( settingsManager->getNumPlayers() ) p = 0; p < settingsManager->getNumPlayers(); ++p ) {
-			for( decltype( deadEndsX.size() ) i = 0; i < deadEndsX.size(); ++i ) {
-				if( mainGame->playerStart.at( p ).getX() == deadEndsX.at( i ) and mainGame->playerStart.at( p ).getY() == deadEndsY.at( i ) ) {
-					deadEndsX.erase( deadEndsX.begin() + i );
-					deadEndsY.erase( deadEndsY.begin() + i );
+		//Which dead ends are still free, as a Fenwick tree over their places in the list: finding and taking the nth free one is O(log n), where erasing it from the middle of the list was O(n). What's left stays in order, so the same random numbers pick the same dead ends as erasing them did, and every seed still makes the same maze.
+		std::vector< uint_fast32_t > freeBelow( deadEnds.size() + 1, 0 ); //freeBelow[ i ] counts the free ones among the ( i bitand -i ) places ending at place i - 1
+		decltype( deadEnds.size() ) deadEndsLeft = deadEnds.size();
+		decltype( deadEnds.size() ) highestStep = 1;
+		for( decltype( deadEnds.size() ) i = 1; i <= deadEnds.size(); ++i ) {
+			freeBelow[ i ] += 1;
+			auto parent = i + ( i bitand ( 0 - i ) );
+			if( parent <= deadEnds.size() ) {
+				freeBelow[ parent ] += freeBelow[ i ];
+			}
+		}
+		while( highestStep * 2 <= deadEnds.size() ) {
+			highestStep *= 2;
+		}
+		auto takeDeadEnd = [ & ]( decltype( deadEnds.size() ) n ) {
+			decltype( deadEnds.size() ) place = 0;
+			for( auto step = highestStep; step > 0; step /= 2 ) {
+				if( place + step <= deadEnds.size() and freeBelow[ place + step ] <= n ) {
+					place += step;
+					n -= freeBelow[ place ];
 				}
 			}
-		}
-		
-		mainGame->setLoadingPercentage( mainGame->getLoadingPercentage() + 1 );
-		mainGame->drawAll();
-
-		//Remove goal from list of dead ends
-		for( decltype( deadEndsX.size() ) i = 0; i < deadEndsX.size(); ++i ) {
-			if( mainGame->goal.getX() == deadEndsX.at( i ) and mainGame->goal.getY() == deadEndsY.at( i ) ) {
-				deadEndsX.erase( deadEndsX.begin() + i );
-				deadEndsY.erase( deadEndsY.begin() + i );
+			for( auto i = place + 1; i <= deadEnds.size(); i += ( i bitand ( 0 - i ) ) ) {
+				freeBelow[ i ] -= 1;
 			}
-		}
+			deadEndsLeft -= 1;
+			return deadEnds[ place ];
+		};
 		
 		if( cols > 0 ) { //Decide how many keys/locks to use (# of keys = # of locks)
-			decltype( mainGame->numLocks ) temp = mainGame->getRandomNumber() % cols;
-			if( deadEndsX.size() > 0 ) {
-				temp = temp % deadEndsX.size();
-			}
-			mainGame->numLocks = temp;
+			//No more than half the dead ends get keys. Every dead end left without a collectable has a passage that can be locked, so there are always enough places for the locks.
+			//Also no more than 254, since the keys plus the acid have to fit in the uint_fast8_t returned by Game::getNumCollectables(). 256 collectables would wrap around to 0, and the bots would think there was nothing to pick up.
+			uint_fast32_t temp = getRandomNumber() % cols;
+			temp = temp % ( deadEnds.size() / 2 + 1 );
+			numLocks = std::min< uint_fast32_t >( temp, UINT_FAST8_MAX - 1 );
 		} else {
-			mainGame->numLocks = 0;
+			numLocks = 0;
 		}
 
-		//mainGame->numLocks = mainGame->getRandomNumber() % ( cols * rows ); //Uncomment this for a crazy number of keys!
+		//numLocks = getRandomNumber() % ( cols * rows ); //Uncomment this for a crazy number of keys!
 
-		decltype( mainGame->numLocks ) numKeys = mainGame->numLocks;
+		decltype( numLocks ) numKeys = numLocks;
 
 		//Place keys in dead ends
 		for( decltype( numKeys ) k = 0; k < numKeys; ++k ) {
-
-			if( deadEndsX.size() == 0 ) {
-				deadEndsX.push_back( mainGame->playerStart.at( 0 ).getX() );
-				deadEndsY.push_back( mainGame->playerStart.at( 0 ).getY() );
-			}
-			
-			{ //Pick one of the dead ends randomly.
-				decltype( deadEndsX.size() ) chosen = mainGame->getRandomNumber() % deadEndsX.size();
-
-				{ //Finally, create a key and put it there.
-					Collectable temp;
-					temp.setX( deadEndsX.at( chosen ) );
-					temp.setY( deadEndsY.at( chosen ) );
-					temp.setColorMode( mainGame->settingsManager.colorMode );
-					temp.setType( Collectable::KEY );
-					temp.loadTexture( mainGame->device );
-					mainGame->stuff.push_back( temp );
-					if( mainGame->getDebugStatus() ) {
-						std::wcout << L"Placing key at " << deadEndsX.at( chosen ) << L"," << deadEndsY.at( chosen ) << std::endl;
-					}
+			uint_fast32_t chosen;
+			if( deadEndsLeft == 0 ) { //Shouldn't happen given how many keys there can be, but just in case, put the key at the start. A random number still gets used up, as when the start used to be added to the list and then picked from it.
+				getRandomNumber();
+				chosen = maze.index( playerStart.at( 0 ).getX(), playerStart.at( 0 ).getY() );
+			} else { //Pick one of the dead ends randomly, and take it off the list so no other keys go there
+				chosen = takeDeadEnd( getRandomNumber() % deadEndsLeft );
+			}
+
+			{ //Finally, create a key and put it there.
+				Collectable temp;
+				temp.setX( chosen % cols );
+				temp.setY( chosen / cols );
+				temp.setColorMode( levelSettings.colorMode );
+				temp.setType( Collectable::KEY );
+				stuff.push_back( temp );
+				if( levelSettings.debug ) {
+					debugLog << L"Placing key at " << temp.getX() << L"," << temp.getY() << std::endl;
 				}
-
-				//Remove chosen from the list of dead ends so no other keys go there
-				deadEndsX.erase( deadEndsX.begin() + chosen );
-				deadEndsY.erase( deadEndsY.begin() + chosen );
 			}
 		}
 		
-		mainGame->setLoadingPercentage( mainGame->getLoadingPercentage() + 1 );
-		mainGame->drawAll();
+		addLoadingProgress( 1 );
 		
 		{
-			uint_fast8_t InverseProbabilityOfAcid = std::min( ( uint_fast8_t ) UINT_FAST8_MAX, ( uint_fast8_t ) mainGame->getMaxRandomNumber() ); //Acid is supposed to be really rare. I call this inverse probability because the higher this number is, the less the probability is. 1 means total, 100% probability. Never set this to zero.
+			uint_fast8_t InverseProbabilityOfAcid = std::min( ( uint_fast8_t ) UINT_FAST8_MAX, ( uint_fast8_t ) randomNumberGenerator.max() ); //Acid is supposed to be really rare. I call this inverse probability because the higher this number is, the less the probability is. 1 means total, 100% probability. Never set this to zero.
 			
-			if( mainGame->getDebugStatus() ) {
+			if( levelSettings.debug ) {
 				InverseProbabilityOfAcid = 1; //If the game is being debugged, ensure the acid is always there - it may be what's being debugged. As Keith Curtis says in 'After the Software Wars', "if the code isn't executed, it probably doesn't work.".
 			}
-			if( mainGame->getRandomNumber() % InverseProbabilityOfAcid == 0 ) {
-				if( deadEndsX.empty() ) { //If all the dead ends have been filled with other collectables
-					Collectable temp;
+			if( getRandomNumber() % InverseProbabilityOfAcid == 0 ) {
+				Collectable temp;
+				if( deadEndsLeft == 0 ) { //If all the dead ends have been filled with other collectables
 					if( cols > 0 ) { //Clang's static analyzer thinks rows and cols may be zero
-						temp.setX( mainGame->getRandomNumber() % cols );
+						temp.setX( getRandomNumber() % cols );
 					}
 					if( rows > 0 ) {
-						temp.setY( mainGame->getRandomNumber() % rows );
-					}
-					
-					temp.setColorMode( mainGame->settingsManager.colorMode );
-					temp.setType( Collectable::ACID );
-					temp.loadTexture( mainGame->device );
-					mainGame->stuff.push_back( temp );
-				} else {
-					//Pick one of the dead ends randomly.
-					decltype( deadEndsX.size() ) chosen = mainGame->getRandomNumber() % deadEndsX.size();
-
-					{ //Finally, create an acid and put it there.
-						Collectable temp;
-						temp.setX( deadEndsX.at( chosen ) );
-						temp.setY( deadEndsY.at( chosen ) );
-						temp.setColorMode( mainGame->settingsManager.colorMode );
-						temp.setType( Collectable::ACID );
-						temp.loadTexture( mainGame->device );
-						mainGame->stuff.push_back( temp );
+						temp.setY( getRandomNumber() % rows );
 					}
-
-					//Remove chosen from the list of dead ends so no other stuff goes there
-					deadEndsX.erase( deadEndsX.begin() + chosen );
-					deadEndsY.erase( deadEndsY.begin() + chosen );
+				} else { //Pick one of the dead ends randomly, and take it off the list so no other stuff goes there
+					uint_fast32_t chosen = takeDeadEnd( getRandomNumber() % deadEndsLeft );
+					temp.setX( chosen % cols );
+					temp.setY( chosen / cols );
 				}
+				
+				temp.setColorMode( levelSettings.colorMode );
+				temp.setType( Collectable::ACID );
+				stuff.push_back( temp );
 			}
 		}
 
-		for( decltype( settingsManager->getNumPlayers() ) p = 0; p < settingsManager->getNumPlayers(); ++p ) {
-			mainGame->player[ p ].setPos( mainGame->playerStart[ p ].getX(), mainGame->playerStart[ p ].getY() );
-		}
-
-		if( mainGame->numLocks > 0 ) {
-			//Place locks
-			//Place first lock at the mainGame->goal
-			if( maze[ mainGame->goal.getX() ][ mainGame->goal.getY() ].getTop() == MazeCell::NONE ) {
-				maze[ mainGame->goal.getX() ][ mainGame->goal.getY() ].setOriginalTop( MazeCell::LOCK );
-			} else if( maze[ mainGame->goal.getX() ][ mainGame->goal.getY() ].getLeft() == MazeCell::NONE ) {
-				maze[ mainGame->goal.getX() ][ mainGame->goal.getY() ].setOriginalLeft( MazeCell::LOCK );
-			} else if( maze[ mainGame->goal.getX() ][ mainGame->goal.getY() + 1 ].getTop() == MazeCell::NONE ) {
-				maze[ mainGame->goal.getX() ][ mainGame->goal.getY() + 1 ].setOriginalTop( MazeCell::LOCK );
-			} else if( maze[ mainGame->goal.getX() + 1 ][ mainGame->goal.getY() ].getLeft() == MazeCell::NONE ) {
-				maze[ mainGame->goal.getX() + 1 ][ mainGame->goal.getY() ].setOriginalLeft( MazeCell::LOCK );
+		if( numLocks > 0 and not maze.empty() ) {
+			//Place locks. A lock can go in any passage as long as no collectable and no player start is on the far side of it (as seen from the first player's start). Work out which cells have something in or past them, leaves first.
+			std::vector< bool > needed( maze.getNumCells(), false );
+			for( decltype( stuff.size() ) i = 0; i < stuff.size(); ++i ) {
+				needed[ maze.index( stuff[ i ].getX(), stuff[ i ].getY() ) ] = true;
+			}
+			for( decltype( playerStart.size() ) p = 0; p < playerStart.size(); ++p ) {
+				needed[ maze.index( playerStart[ p ].getX(), playerStart[ p ].getY() ) ] = true;
+			}
+			for( auto i = pathsOrder.size(); i > 1; --i ) {
+				uint_fast32_t cell = pathsOrder[ i - 1 ];
+				if( needed[ cell ] ) {
+					needed[ pathsParent[ cell ] ] = true;
+				}
 			}
-
-			decltype( mainGame->numLocks ) numLocksPlaced = 1;
 			
-			auto startTime = time( nullptr ); //Very rarely, there may be more keys than can be placed, or it may take too long to find places for them all.
+			decltype( numLocks ) numLocksPlaced = 0;
 			
-			while( ( startTime != -1 and difftime( time( nullptr ), startTime ) < 10 ) //while time limit hasn't been reached... (10 seconds just seemed like a convenient number, you can raise or lower it)
-				and ( mainGame->device->run() not_eq false ) //...and the window hasn't been closed...
-				and ( numLocksPlaced < mainGame->numLocks ) //...and we haven't placed all the locks...
-				and ( cols > 0 and rows > 0 ) ) { //...and the size of the maze is not zero...
-					
-				decltype( cols ) tempX = mainGame->getRandomNumber() % cols;
-				decltype( rows ) tempY = mainGame->getRandomNumber() % rows;
-
-				if( maze[ tempX ][ tempY ].getTop() == MazeCell::NONE ) {
-					maze[ tempX ][ tempY ].setOriginalTop( MazeCell::LOCK );
-
-					if( canGetToAllCollectables( mainGame->playerStart[ 0 ].getX(), mainGame->playerStart[ 0 ].getY() ) ) {
-						numLocksPlaced += 1;
-						if( mainGame->getDebugStatus() ) {
-							std::wcout << L"Placed lock " << numLocksPlaced << L" at " << tempX << L"x" << tempY << std::endl;
-						}
-					} else {
-						maze[ tempX ][ tempY ].setOriginalTop( MazeCell::NONE );
-					}
-				} else if( maze[ tempX ][ tempY ].getLeft() == MazeCell::NONE ) {
-					maze[ tempX ][ tempY ].setOriginalLeft( MazeCell::LOCK );
-
-					if( canGetToAllCollectables( mainGame->playerStart[ 0 ].getX(), mainGame->playerStart[ 0 ].getY() ) ) {
-						numLocksPlaced += 1;
-						if( mainGame->getDebugStatus() ) {
-							std::wcout << L"Placed lock " << numLocksPlaced << L" at " << tempX << L"x" << tempY << std::endl;
-						}
-					} else {
-						maze[ tempX ][ tempY ].setOriginalLeft( MazeCell::NONE );
-					}
+			//Place first lock at the goal, in the passage leading back toward the players
+			uint_fast32_t goalCell = maze.index( goalX, goalY );
+			if( pathsParent[ goalCell ] not_eq UINT_FAST32_MAX and pathsParent[ goalCell ] not_eq goalCell ) {
+				lockPassage( goalCell, pathsParent[ goalCell ] );
+				numLocksPlaced += 1;
+			}
+			
+			//Passages into the goal or anything past it would be pointless to lock
+			std::vector< uint_fast32_t > candidates;
+			for( decltype( pathsOrder.size() ) i = 1; i < pathsOrder.size(); ++i ) {
+				if( not needed[ pathsOrder[ i ] ] and not pastGoal[ pathsOrder[ i ] ] ) {
+					candidates.push_back( pathsOrder[ i ] );
 				}
 			}
 			
-			mainGame->timer->stop();
-			mainGame->timer->setTime( 0 );
-			if( mainGame->getDebugStatus() ) {
-				std::wcout << L"numLocksPlaced: " << numLocksPlaced << L"\tnumLocks: " << mainGame->numLocks << std::endl;
+			//Pick the rest at random from the candidates (a partial Fisher-Yates shuffle)
+			for( decltype( candidates.size() ) i = 0; i < candidates.size() and numLocksPlaced < numLocks; ++i ) {
+				std::swap( candidates[ i ], candidates[ i + getRandomNumber() % ( candidates.size() - i ) ] );
+				lockPassage( candidates[ i ], pathsParent[ candidates[ i ] ] );
+				numLocksPlaced += 1;
 			}
-
-			if( numLocksPlaced < mainGame->numLocks ) {
-				decltype( numLocksPlaced ) keysToRemove = mainGame->numLocks - numLocksPlaced;
-
-				for( decltype( mainGame->stuff.size() ) i = 0; ( i < mainGame->stuff.size() and keysToRemove > 0 ); ++i ) {
-					if( mainGame->getDebugStatus() ) {
-						std::wcout << L"keysToRemove: " << keysToRemove << std::endl;
-					}
-
-					if( mainGame->stuff.at( i ).getType() == Collectable::KEY ) {
-						mainGame->stuff.erase( mainGame->stuff.begin() + i );
-						i = 0;
-						keysToRemove -= 1;
-					}
+			
+			//There's always room for every lock. At most half of the D dead ends left after leaving out the player starts and the goal get keys, so at least D - numLocks - 1 of them (one might have the acid) are still empty. Each empty dead end has a passage that can be locked, and the goal gets one more, which makes at least D - numLocks >= numLocks. Keys are never taken away to make up for missing locks, so if this ever goes wrong, say so.
+			if( levelSettings.debug ) {
+				debugLog << L"numLocksPlaced: " << static_cast< uint_fast16_t >( numLocksPlaced ) << L"\tnumLocks: " << static_cast< uint_fast16_t >( numLocks ) << std::endl;
+				if( not canGetToAllCollectables( playerStart[ 0 ].getX(), playerStart[ 0 ].getY() ) ) {
+					std::wcerr << L"Error in MazeManager::makeLevel(): A lock cuts off a collectable" << std::endl;
+				}
+				if( numLocksPlaced < numLocks ) {
+					std::wcerr << L"Error in MazeManager::makeLevel(): Only " << static_cast< uint_fast16_t >( numLocksPlaced ) << L" of " << static_cast< uint_fast16_t >( numLocks ) << L" locks could be placed" << std::endl;
 				}
 			}
-
-			mainGame->numLocks = numLocksPlaced;
 		}
 		
-		mainGame->setLoadingPercentage( mainGame->getLoadingPercentage() + 1 );
-		mainGame->drawAll();
-
-		for( decltype( cols ) x = 0; x < cols; ++x ) {
-			for( decltype( rows ) y = 0; y < rows; ++y ) {
-				maze[ x ][ y ].visited = false;
-			}
-		}
-
-		for( decltype( settingsManager->getNumPlayers() ) p = 0; p < settingsManager->getNumPlayers(); ++p ) {
-			maze[ mainGame->playerStart[ p ].getX() ][ mainGame->playerStart[ p ].getY() ].visited = true;
-			maze[ mainGame->playerStart[ p ].getX() ][ mainGame->playerStart[ p ].getY() ].setVisitorColor( mainGame->player[ p ].getColorTwo() );
-			makeCellsVisible( mainGame->playerStart[ p ].getX(), mainGame->playerStart[ p ].getY() );
-		}
+		maze.clearVisited();
 		
-		mainGame->setLoadingPercentage( mainGame->getLoadingPercentage() + 1 );
-		mainGame->drawAll();
+		addLoadingProgress( 2 );
 	} catch ( std::exception &e ) {
-		std::wcerr << L"Error in MazeManager::makeRandomLevel(): " << e.what() << std::endl;
+		std::wcerr << L"Error in MazeManager::makeLevel(): " << e.what() << std::endl;
 	}
 }
 
@@ -549,8 +654,20 @@ MazeManager::MazeManager() {
 		//resizeMaze() will set cols and rows to whatever gets passed into it; we're making them zero here only so that resizeMaze() doesn't try to copy from the nonexistent previous maze.
 		cols = 0;
 		rows = 0;
-		maze = nullptr;
 		mainGame = nullptr;
+		generator.randomNumber = [ this ]() { return getRandomNumber(); };
+		goalX = 0;
+		goalY = 0;
+		numLocks = 0;
+		showProgress = true;
+		levelSettings.numPlayers = 0;
+		levelSettings.mazeSize = 0;
+		levelSettings.generator = MazeGenerator::DEPTH_FIRST_SEARCH;
+		levelSettings.policy = MazeGenerator::NEWEST;
+		levelSettings.endless = false;
+		levelSettings.hideUnseen = false;
+		levelSettings.colorMode = SettingsManager::FULLCOLOR;
+		levelSettings.debug = false;
 		settingsManager = nullptr;
 		StringConverter sc;
 		fileTypeName = sc.toIrrlichtStringW( PACKAGE_NAME );
@@ -564,130 +681,33 @@ MazeManager::MazeManager() {
 
 MazeManager::~MazeManager() {
 	try {
-		for( decltype( cols ) i = 0 ; i < cols ; ++i ) {
-			delete [ ] maze[ i ];
-		}
-
-		delete [ ] maze ;
 	} catch ( std::exception &e ) {
 		std::wcerr << L"Error in MazeManager::~MazeManager(): " << e.what() << std::endl;
 	}
 }
 
-//Creates a new maze of the desired size, then deletes old maze
-void MazeManager::newMaze( uint_fast8_t newCols, uint_fast8_t newRows ) {
+//Replaces the old maze with a new, blank one of the desired size
+void MazeManager::newMaze( coordinate_t newCols, coordinate_t newRows ) {
 	try {
-		decltype( cols ) oldCols = cols;
-
-		MazeCell** newMaze = new MazeCell *[ newCols ];
-
-		for( decltype( newCols ) i = 0 ; i < newCols ; ++i ) {
-			newMaze[ i ] = new MazeCell[ newRows ];
-		}
-
-		for( decltype( oldCols ) i = 0 ; i < oldCols ; ++i ) {
-			delete [ ] maze[ i ];
-		}
-
-		delete [ ] maze ;
+		maze.resize( newCols, newRows );
 
 		cols = newCols;
 		rows = newRows;
-
-		maze = newMaze;
 	} catch ( std::exception &e ) {
 		std::wcerr << L"Error in MazeManager::resizeMaze(): " << e.what() << std::endl;
 	}
 }
 
-//Generates the maze recursively
-void MazeManager::recurseRandom( uint_fast8_t x, uint_fast8_t y, uint_fast16_t depth, uint_fast16_t numSoFar ) {
-	try {
-		mainGame->setLoadingPercentage( mainGame->getLoadingPercentage() + ( 90.0f / ( cols * rows ) ) ); //I figure this recursion takes up about 90% of loading time. That's not based on any measurements, it's just a guess.
-		//At one point I included the following line because I hoped to show the maze as it was being generated. Might still add that as an option. Now it's there so that the loading screen gets drawn and lasts long enough to read it.
-		mainGame->drawAll();
-		
-		maze[ x ][ y ].visited = true;
-		maze[ x ][ y ].id = numSoFar;
-		
-		for( decltype( settingsManager->getNumPlayers() ) p = 0; p < settingsManager->getNumPlayers(); ++p ) {
-			if( depth >= mainGame->playerStart[ p ].distanceFromExit ) {
-				mainGame->playerStart[ p ].setPos( x, y );
-				mainGame->playerStart[ p ].distanceFromExit = depth;
-			}
-		}
-		
-		bool keepGoing = true;
-		
-		while( keepGoing ) {
-			numSoFar += 1;
-			
-			switch( mainGame->getRandomNumber() % 4 ) { //4 = number of directions (up, down, left, right)
-				case 0: //Left
-					
-					if( x > 0 and maze[ x-1 ][ y ].visited == false ) {
-						maze[ x ][ y ].setOriginalLeft( MazeCell::NONE );
-						
-						recurseRandom( x - 1, y, depth + 1, numSoFar );
-					}
-					
-					break;
-				
-				case 1: //Right
-					
-					if( x < cols - 1 and maze[ x+1 ][ y ].visited == false ) {
-						maze[ x+1 ][ y ].setOriginalLeft( MazeCell::NONE );
-						
-						recurseRandom( x + 1, y, depth + 1, numSoFar );
-					}
-					
-					break;
-				
-				case 2: //Up
-					
-					if( y > 0 and maze[ x ][ y-1 ].visited == false ) {
-						maze[ x ][ y ].setOriginalTop( MazeCell::NONE );
-						
-						recurseRandom( x, y - 1, depth + 1, numSoFar );
-					}
-					
-					break;
-				
-				case 3: //Down
-					
-					if( y < rows - 1 and maze[ x ][ y+1 ].visited == false ) {
-						maze[ x ][ y+1 ].setOriginalTop( MazeCell::NONE );
-						
-						recurseRandom( x, y + 1, depth + 1, numSoFar );
-					}
-					
-					break;
-			}
-			
-			//If we've reached a dead end, don't keep going. Otherwise do.
-			keepGoing = false;
-			if( ( x > 0 and maze[ x - 1 ][ y ].visited == false )
-					or ( x < cols - 1 and maze[ x + 1 ][ y ].visited == false )
-					or ( y > 0 and maze[ x ][ y - 1 ].visited == false )
-					or ( y < rows - 1 and maze[ x ][ y + 1 ].visited == false )
-			  ) {
-				keepGoing = true;
-			}
-		}
-	} catch ( std::exception &e ) {
-		std::wcerr << L"Error in MazeManager::recurseRandom(): " << e.what() << std::endl;
-	}
-}
-
 bool MazeManager::saveToFile( boost::filesystem::path dest ) {
 	try {
+		StringConverter sc;
 		
 		{ //Append the desired extension to the file name if it's not already present.
 			std::wstring destExtension = dest.extension().wstring();
 			destExtension.erase( destExtension.begin() ); //The first character is the '.' which we don't include in fileTypeExtension
-			if( not fileTypeExtension.equals_ignore_case( mainGame->stringConverter.toIrrlichtStringW( destExtension ) ) ) {
+			if( not fileTypeExtension.equals_ignore_case( sc.toIrrlichtStringW( destExtension ) ) ) {
 				dest += L".";
-				dest += mainGame->stringConverter.toStdWString( fileTypeExtension );
+				dest += sc.toStdWString( fileTypeExtension );
 			}
 		}
 		
@@ -695,24 +715,31 @@ bool MazeManager::saveToFile( boost::filesystem::path dest ) {
 			throw( CustomException( std::wstring( L"Directory specified, file needed: " ) + dest.wstring() ) );
 		}
 		
+		if( endlessMaze ) { //Each piece of an endless maze carries on from the one before it, so the random seed alone can't make it again
+			mainGame->showMessage( L"Maze NOT saved", L"Endless mazes can't be saved to a file. Turn off the \"endless mazes\" preference to play mazes that can be saved." );
+			return false;
+		}
+		
 		boost::filesystem::wofstream file; //Identical to a standard C++ wofstream, except it takes Boost paths
 		file.open( dest, boost::filesystem::wofstream::binary bitor boost::filesystem::wofstream::trunc );
 		
 		if( file.is_open() ) {
 			auto newRandomSeed = mainGame->getRandomSeed();
 			file << newRandomSeed;
+			file << L" " << levelSettings.mazeSize; //The same seed only makes the same maze if the maze size and generator match
+			file << L" " << static_cast< uint_fast16_t >( levelSettings.generator ) << L" " << static_cast< uint_fast16_t >( levelSettings.policy );
 			mainGame->setRandomSeed( newRandomSeed );
 			/*auto rs = mainGame->randomSeed;
 			file.write( reinterpret_cast<boost::filesystem::wofstream::char_type *>( &rs ), sizeof( rs ) / sizeof( boost::filesystem::wofstream::char_type ) );*/
 			file.close();
 			irr::core::stringw message( L"This maze has been saved to the file " );
-			message += mainGame->stringConverter.toIrrlichtStringW( dest.wstring() );
-			mainGame->gui->addMessageBox( L"Maze saved", mainGame->stringConverter.toStdWString( message ).c_str() ); //stringConverter.toWCharArray( message ) );
+			message += sc.toIrrlichtStringW( dest.wstring() );
+			mainGame->showMessage( L"Maze saved", sc.toStdWString( message ) );
 		} else {
 			irr::core::stringw message( L"Cannot save to file " );
-			message += mainGame->stringConverter.toIrrlichtStringW( dest.wstring() );
-			std::wcerr << mainGame->stringConverter.toStdWString( message ) << std::endl; //stringConverter.toWCharArray( message ) << std::endl;
-			mainGame->gui->addMessageBox( L"Maze NOT saved", mainGame->stringConverter.toStdWString( message ).c_str() ); //stringConverter.toWCharArray( message ) );
+			message += sc.toIrrlichtStringW( dest.wstring() );
+			std::wcerr << sc.toStdWString( message ) << std::endl; //stringConverter.toWCharArray( message ) << std::endl;
+			mainGame->showMessage( L"Maze NOT saved", sc.toStdWString( message ) );
 		}
 
 		return true;
@@ -725,17 +752,51 @@ bool MazeManager::saveToFile( boost::filesystem::path dest ) {
 	}
 }
 
+void MazeManager::printDebugLog() {
+	try {
+		std::wcout << debugLog.str();
+		debugLog.str( L"" );
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeManager::printDebugLog(): " << e.what() << std::endl;
+	}
+}
+
+void MazeManager::setRandomSeed( std::minstd_rand::result_type newSeed ) {
+	randomNumberGenerator.seed( newSeed );
+}
+
 void MazeManager::setAllCellsVisibility() {
 	//Set whether the cells are visible. Those on the border are changed later.
-	for( decltype( cols ) x = 0; x < cols; ++x ) {
-		for( decltype( rows ) y = 0; y < rows; ++y ) {
-			maze[ x ][ y ].topVisible = not settingsManager->getHideUnseen();
-			maze[ x ][ y ].leftVisible = not settingsManager->getHideUnseen();
-		}
+	maze.setAllTopLeftVisible( not settingsManager->getHideUnseen() );
+}
+
+//Swaps the levels rather than copying them, so nothing big gets copied while the game is waiting
+void MazeManager::swapLevel( MazeManager& other ) {
+	try {
+		std::swap( maze, other.maze );
+		std::swap( cols, other.cols );
+		std::swap( rows, other.rows );
+		std::swap( stuff, other.stuff );
+		std::swap( playerStart, other.playerStart );
+		std::swap( goalX, other.goalX );
+		std::swap( goalY, other.goalY );
+		std::swap( numLocks, other.numLocks );
+		std::swap( levelSettings, other.levelSettings );
+		{ //Each level's debug messages go with it
+			std::wstring log = debugLog.str();
+			debugLog.str( other.debugLog.str() );
+			other.debugLog.str( log );
+		}
+		std::swap( randomNumberGenerator, other.randomNumberGenerator );
+		generator.setAlgorithm( other.generator.getAlgorithm() );
+		generator.setPolicy( other.generator.getPolicy() );
+		endlessMaze.reset(); //The level swapped in isn't part of it
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in MazeManager::swapLevel(): " << e.what() << std::endl;
 	}
 }
 
-void MazeManager::setPointers( MainGame* newMainGame, SettingsManager* newSettingsManager ){
+void MazeManager::setPointers( Game* newMainGame, SettingsManager* newSettingsManager ){
 	try {
 		mainGame = newMainGame;
 		settingsManager = newSettingsManager;
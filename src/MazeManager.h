@@ -19,12 +19,31 @@
 #ifndef MAZEMANAGER_H
 #define MAZEMANAGER_H
 
-//#include "MainGame.h"
+#include "Collectable.h"
+#include "DistanceFields.h"
+#include "EndlessMaze.h"
+#include "Game.h"
+#include "JunctionGraph.h"
+#include "KeyOrderPlanner.h"
 #include "MazeCell.h"
+#include "MazeGenerator.h"
+#include "MazeGrid.h"
+#include "PlayerStart.h"
 #include "PreprocessorCommands.h"
+#include "Reachability.h"
 #include "SettingsManager.h"
+#include "TreeDistances.h"
+#include "WallFollower.h"
 
 #include <boost/filesystem.hpp>
+#include <memory>
+#include <random>
+#ifdef HAVE_SSTREAM
+	#include <sstream>
+#endif //HAVE_SSTREAM
+#ifdef HAVE_VECTOR
+	#include <vector>
+#endif //HAVE_VECTOR
 
 #ifdef WINDOWS
     #include <irrlicht.h>
@@ -32,7 +51,6 @@
     #include <irrlicht/irrlicht.h>
 #endif
 
-class MainGame;
 class SettingsManager;
 
 class MazeManager {
@@ -42,40 +60,155 @@ class MazeManager {
 		/** Default destructor */
 		virtual ~MazeManager();
 		
-		MazeCell** maze;
+		MazeGrid maze;
+		/**
+		 * Shared by every bot in the maze, so that each target only gets searched for once. Keeps itself up to date as walls get dissolved or unlocked.
+		 */
+		DistanceFields distanceFields;
+		/**
+		 * Answers distances without searching, for as long as the maze has no loops. Check isTree() after calling update(), and use distanceFields if not.
+		 */
+		TreeDistances treeDistances;
+		/**
+		 * The maze with its corridors squashed flat, for bots to search. Nothing makes it until a bot first calls update() on it, so it costs nothing if no bot uses it.
+		 */
+		JunctionGraph junctionGraph;
+		/**
+		 * Works out which order bots should pick up the keys in. Shared so that its tables only get allocated once.
+		 */
+		KeyOrderPlanner keyOrderPlanner;
+		/**
+		 * Where the Right Hand Rule and Left Hand Rule bots go next. Like the junctionGraph, nothing makes it until a bot first calls update() on it.
+		 */
+		WallFollower wallFollower;
 		
-		bool canGetTo( uint_fast8_t startX, uint_fast8_t startY, uint_fast8_t goalX, uint_fast8_t goalY );
-		bool canGetToAllCollectables( uint_fast8_t startX, uint_fast8_t startY );
+		/**
+		 * Returns true if every collectable can be reached from the given cell without going through walls or locks.
+		 */
+		bool canGetToAllCollectables( coordinate_t startX, coordinate_t startY );
 		
 		void draw( irr::IrrlichtDevice* device, uint_fast16_t cellWidth, uint_fast16_t cellHeight );
 		
+		/**
+		 * Makes the mazes for makeRandomLevel(). Which algorithm it uses comes from the "maze generator" preference.
+		 */
+		MazeGenerator generator;
+		
 		irr::core::stringw getFileTypeExtension() const;
 		irr::core::stringw getFileTypeName() const;
+		/**
+		 * Mazes get their random numbers from here rather than from MainGame, so that a maze can be made on another thread. Call setRandomSeed() before makeRandomLevel().
+		 */
+		std::minstd_rand::result_type getRandomNumber();
+		/**
+		 * Lets MainGame carry on using random numbers from where the maze left off, just as it would if it had made the maze itself.
+		 */
+		const std::minstd_rand& getRandomNumberGenerator() const;
 		bool hideUnseen;
 		
-		void makeCellsVisible( uint_fast8_t x, uint_fast8_t y );
-		void makeRandomLevel();
+		/**
+		 * The preferences and game state that makeRandomLevel() depends on, copied all at once so that a maze being made on another thread never reads them while the settings screen is changing them.
+		 */
+		struct LevelSettings {
+			uint_fast8_t numPlayers;
+			coordinate_t mazeSize;
+			MazeGenerator::algorithm_t generator;
+			MazeGenerator::policy_t policy;
+			bool endless; ///< Already false in network games, since the clients only get the random seed, not the endless maze's state
+			bool hideUnseen;
+			SettingsManager::colorMode_t colorMode;
+			bool debug;
+		};
+		/**
+		 * Copies what makeRandomLevel() needs from the game and settings given to setPointers(). Only call this on the main thread.
+		 */
+		LevelSettings getCurrentSettings() const;
 		
-		void newMaze( uint_fast8_t newCols, uint_fast8_t newRows );
+		/**
+		 * Messages from the last makeRandomLevel(), written when the debug preference is on. They're saved up rather than printed as they happen, since the level might be made on another thread; printDebugLog() writes them out.
+		 */
+		std::wostringstream debugLog;
+		void printDebugLog();
+		
+		/**
+		 * Returns false if any of the given settings differ from the ones the level was made with. Pass it getCurrentSettings() to find out whether a level made ahead of time is still the kind of maze that's wanted.
+		 */
+		bool madeWithSettings( const LevelSettings& settings ) const;
+		void makeCellsVisible( coordinate_t x, coordinate_t y );
+		/**
+		 * Makes a new maze and everything in it. The results go in maze, stuff, playerStart, goalX, goalY, and numLocks, for MainGame to copy. Reads the settings with getCurrentSettings() first, so this must be called on the main thread.
+		 */
+		void makeRandomLevel();
+		/**
+		 * Same as makeRandomLevel(), except that it uses the given settings instead of reading them. Neither the game nor the settings manager gets touched, so when showProgress is false this is safe to call from another thread.
+		 */
+		void makeRandomLevel( const LevelSettings& settings );
+		/**
+		 * Same as makeRandomLevel(), except that the maze is exactly this size instead of a random size based on the "maze size" preference, and it's never part of an endless maze. Used by cybrinth-benchmark, so that it can compare mazes of the same size.
+		 */
+		void makeRandomLevelOfSize( coordinate_t newCols, coordinate_t newRows );
 		
-		void recurseRandom( uint_fast8_t x, uint_fast8_t y, uint_fast16_t depth, uint_fast16_t numSoFar );
+		void newMaze( coordinate_t newCols, coordinate_t newRows );
 		
 		bool saveToFile( boost::filesystem::path dest );
 		
 		void setAllCellsVisibility();
-		void setPointers( MainGame* newMainGame, SettingsManager* newSettingsManager );
+		void setPointers( Game* newMainGame, SettingsManager* newSettingsManager );
+		void setRandomSeed( std::minstd_rand::result_type newSeed );
+		/**
+		 * Exchanges the level made by makeRandomLevel() with the one in another MazeManager, for when the next maze has been made ahead of time.
+		 */
+		void swapLevel( MazeManager& other );
 		
-		uint_fast8_t cols;
+		coordinate_t cols;
 		
-		MainGame* mainGame;
+		/**
+		 * The level made by makeRandomLevel(), besides the maze itself. The collectables' textures aren't loaded, since that has to be done on the main thread.
+		 */
+		std::vector< Collectable > stuff;
+		std::vector< PlayerStart > playerStart;
+		coordinate_t goalX;
+		coordinate_t goalY;
+		uint_fast8_t numLocks;
 		
-		uint_fast8_t rows;
+		/**
+		 * Whether makeRandomLevel() updates the loading screen. Must be false if it's called from any thread besides the main one.
+		 */
+		bool showProgress;
+		
+		/**
+		 * Only exists while the "endless mazes" preference is on. Each call to makeRandomLevel() takes the next piece of it.
+		 */
+		std::unique_ptr< EndlessMaze > endlessMaze;
+		
+		Game* mainGame;
+		
+		coordinate_t rows;
 		
 		SettingsManager* settingsManager;
 	protected:
 	private:
 		irr::core::stringw fileTypeExtension;
 		irr::core::stringw fileTypeName;
+		std::minstd_rand randomNumberGenerator;
+		LevelSettings levelSettings; ///< What the level was made with. makeLevel() reads these rather than the settings manager.
+		
+		void addLoadingProgress( float percent );
+		/**
+		 * Walks the maze's open passages outward from one cell. Since generated mazes are perfect mazes, this turns the maze into a tree rooted at that cell.
+		 * @param parent: Set to one entry per cell: the index of the next cell on the way back to the root. The root is its own parent, and cells that can't be reached get UINT_FAST32_MAX.
+		 * @param order: Set to the reachable cells in the order they were found, root first, so every cell comes after its parent.
+		 */
+		void findPathsFrom( coordinate_t rootX, coordinate_t rootY, std::vector< uint_fast32_t >& parent, std::vector< uint_fast32_t >& order );
+		/**
+		 * Puts a lock in the wall between two neighboring cells, given by their indices in the maze.
+		 */
+		void lockPassage( uint_fast32_t cell, uint_fast32_t neighbor );
+		/**
+		 * Does the work of makeRandomLevel() and makeRandomLevelOfSize(). If exactCols is zero, the size is chosen at random.
+		 */
+		void makeLevel( coordinate_t exactCols, coordinate_t exactRows );
+		Reachability reachability;
 };
 
 #endif // MAZEMANAGER_H
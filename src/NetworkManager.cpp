@@ -243,8 +243,31 @@ void NetworkManager::processPackets() {
 					
 					switch( command ) {
 						case NEWMAZE: {
-							uint32_t newRandomSeed = deSerializeU32( data );
+							auto split = data.find( "|" );
+							std::string seedString = data.substr( 0, split );
+							
+							uint32_t newRandomSeed = deSerializeU32( seedString );
 							std::wcout << sc.toStdWString( newRandomSeed ) << std::endl;
+							
+							if( split not_eq std::string::npos ) { //The same seed only makes the same maze if the maze size and generator preferences match the server's
+								data = data.substr( split + 1 );
+								split = data.find( "|" );
+								std::string sizeString = data.substr( 0, split );
+								mg->settingsManager.setMazeSize( deSerializeU32( sizeString ) );
+								
+								if( split not_eq std::string::npos ) {
+									data = data.substr( split + 1 );
+									split = data.find( "|" );
+									std::string generatorString = data.substr( 0, split );
+									mg->settingsManager.setMazeGenerator( static_cast< MazeGenerator::algorithm_t >( deSerializeU8( generatorString ) ) );
+									
+									if( split not_eq std::string::npos ) {
+										std::string policyString = data.substr( split + 1 );
+										mg->settingsManager.setGrowingTreePolicy( static_cast< MazeGenerator::policy_t >( deSerializeU8( policyString ) ) );
+									}
+								}
+							}
+							
 							mg->newMaze( newRandomSeed );
 							break;
 						} case TELEPORTPLAYER: {
@@ -257,8 +280,8 @@ void NetworkManager::processPackets() {
 							std::string yString = data;
 							
 							uint_fast8_t playerNum = deSerializeU8( playerString );
-							uint_fast8_t playerX = deSerializeU8( xString );
-							uint_fast8_t playerY = deSerializeU8( yString );
+							coordinate_t playerX = deSerializeU32( xString );
+							coordinate_t playerY = deSerializeU32( yString );
 							
 							std::wcout << L"Received player info: playerNum: " << playerNum << L" X: " << playerX << L" Y: " << playerY << std::endl;
 							
@@ -346,6 +369,12 @@ void NetworkManager::sendMaze( std::minstd_rand::result_type randomSeed ) {
 		data.append( serializeU8( NEWMAZE ) );
 		data.append( "|" );
 		data.append( serializeU32( randomSeed ) );
+		data.append( "|" );
+		data.append( serializeU32( mg->settingsManager.getMazeSize() ) );
+		data.append( "|" );
+		data.append( serializeU8( mg->settingsManager.getMazeGenerator() ) );
+		data.append( "|" );
+		data.append( serializeU8( mg->settingsManager.getGrowingTreePolicy() ) );
 		char channel;
 		if( isServer ) {
 			channel = SERVER_SEND_CHANNEL;
@@ -365,9 +394,9 @@ void NetworkManager::sendPlayerPos( uint_fast8_t playerNum ) {
 	data.append( serializeU8( playerNum ) );
 	data.append( "|" );
 	auto player = mg->getPlayer( playerNum );
-	data.append( serializeU8( player->getX() ) );
+	data.append( serializeU32( player->getX() ) ); //Coordinates are always sent as 32 bits so that builds with and without WIDE_COORDINATES can play together
 	data.append( "|" );
-	data.append( serializeU8( player->getY() ) );
+	data.append( serializeU32( player->getY() ) );
 	
 	char channel;
 	if( isServer ) {
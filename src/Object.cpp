@@ -126,21 +126,21 @@ irr::video::SColor Object::getColorTwo() {
 	}
 }
 
-uint_fast8_t Object::getX() {
+coordinate_t Object::getX() {
 	try {
 		return x;
 	} catch ( std::exception &e ) {
 		std::wcerr << L"Error in Object::getX(): " << e.what() << std::endl;
-		return UINT_FAST8_MAX;
+		return COORDINATE_MAX;
 	}
 }
 
-uint_fast8_t Object::getY() {
+coordinate_t Object::getY() {
 	try {
 		return y;
 	} catch ( std::exception &e ) {
 		std::wcerr << L"Error in Object::getY(): " << e.what() << std::endl;
-		return UINT_FAST8_MAX;
+		return COORDINATE_MAX;
 	}
 }
 
@@ -311,7 +311,7 @@ void Object::setColors( irr::video::SColor newColorOne, irr::video::SColor newCo
 	}
 }
 
-void Object::setPos( uint_fast8_t newX, uint_fast8_t newY ) {
+void Object::setPos( coordinate_t newX, coordinate_t newY ) {
 	try {
 		setX( newX );
 		setY( newY );
@@ -320,7 +320,7 @@ void Object::setPos( uint_fast8_t newX, uint_fast8_t newY ) {
 	}
 }
 
-void Object::setX( uint_fast8_t val ) {
+void Object::setX( coordinate_t val ) {
 	try {
 		x = val;
 		xInterp = x;
@@ -329,7 +329,7 @@ void Object::setX( uint_fast8_t val ) {
 	}
 }
 
-void Object::setY( uint_fast8_t val ) {
+void Object::setY( coordinate_t val ) {
 	try {
 		y = val;
 		yInterp = y;
@@ -32,11 +32,11 @@ class Object {
 	public:
 		Object();
 		virtual ~Object();
-		uint_fast8_t getY();
-		uint_fast8_t getX();
-		void setPos( uint_fast8_t newX, uint_fast8_t newY );
-		void setX( uint_fast8_t val );
-		void setY( uint_fast8_t val );
+		coordinate_t getY();
+		coordinate_t getX();
+		void setPos( coordinate_t newX, coordinate_t newY );
+		void setX( coordinate_t val );
+		void setY( coordinate_t val );
 		void moveY( int_fast8_t val );
 		void moveX( int_fast8_t val );
 		void draw( irr::IrrlichtDevice* device, uint_fast16_t width, uint_fast16_t height );
@@ -47,12 +47,12 @@ class Object {
 		void setColors( irr::video::SColor newColorOne, irr::video::SColor newColorTwo );
 		irr::video::SColor getColorOne();
 		irr::video::SColor getColorTwo();
-		uint_fast16_t distanceFromExit;
+		uint_fast32_t distanceFromExit; //Can be as large as the number of cells in the maze
 		void adjustImageColors( irr::video::IImage* image );
 	protected:
-		uint_fast8_t x;
+		coordinate_t x;
 		float xInterp;
-		uint_fast8_t y;
+		coordinate_t y;
 		float yInterp;
 		bool moving;
 		irr::video::ITexture* texture;
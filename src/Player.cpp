@@ -23,7 +23,8 @@
 #endif //HAVE_IOSTREAM
 #include "colors.h"
 #include <boost/filesystem.hpp>
-#include "MainGame.h"
+#include "Game.h"
+#include "StringConverter.h"
 #include "XPMImageLoader.h"
 
 // cppcheck-suppress uninitMemberVar
@@ -280,7 +281,7 @@ void Player::reset() {
 	}
 }
 
-void Player::setMG( MainGame* newMG ) {
+void Player::setMG( Game* newMG ) {
 	mg = newMG;
 }
 
@@ -27,8 +27,7 @@
 #include "colors.h"
 #include "PreprocessorCommands.h"
 
-//#include "MainGame.h"
-class MainGame; //Avoids circular dependency
+class Game; //Avoids circular dependency
 
 class Player : public Object {
 	public:
@@ -64,7 +63,7 @@ class Player : public Object {
 		void removeItem();
 		void reset();
 		
-		void setMG( MainGame* newMG );
+		void setMG( Game* newMG );
 		void setPlayerNumber( uint_fast8_t newNumber );
 		void setScore( intmax_t newScore );
 		
@@ -75,7 +74,7 @@ class Player : public Object {
 		uint_fast32_t timeTakenThisMaze;
 	protected:
 	private:
-		MainGame* mg;
+		Game* mg;
 		
 		uint_fast8_t heldItem;
 		Collectable::type_t heldItemType;
@@ -0,0 +1,248 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The Reachability class answers whether cells in a maze can be reached from a given starting cell, without going through any walls or locks. One flood fill answers the question for any number of target cells at once. In wide mazes, the passages are packed one bit per cell, and the flood fill goes a whole row at a time, 64 cells per instruction, rather than one cell at a time.
+ */
+
+#include "Reachability.h"
+
+#ifdef HAVE_IOSTREAM
+	#include <iostream>
+#endif //HAVE_IOSTREAM
+#include <algorithm>
+
+const coordinate_t Reachability::MIN_COLS_TO_PACK;
+
+Reachability::Reachability() {
+	try {
+		searchNumber = 0;
+		numReached = 0;
+		packedWallsVersion = 0;
+		wordsPerRow = 0;
+		lastSearchPacked = false;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in Reachability::Reachability(): " << e.what() << std::endl;
+	}
+}
+
+Reachability::~Reachability() {
+	try {
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in Reachability::~Reachability(): " << e.what() << std::endl;
+	}
+}
+
+bool Reachability::canReachAll( const MazeGrid& maze, coordinate_t startX, coordinate_t startY, const std::vector< uint_fast32_t >& targets ) {
+	try {
+		search( maze, startX, startY, targets );
+
+		for( decltype( targets.size() ) i = 0; i < targets.size(); ++i ) {
+			if( not wasReached( targets[ i ], maze.getCols() ) ) {
+				return false;
+			}
+		}
+		return true;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in Reachability::canReachAll(): " << e.what() << std::endl;
+		return false;
+	}
+}
+
+uint_fast32_t Reachability::getNumReached() const {
+	return numReached;
+}
+
+void Reachability::search( const MazeGrid& maze, coordinate_t startX, coordinate_t startY, const std::vector< uint_fast32_t >& targets ) {
+	try {
+		numReached = 0;
+		if( maze.empty() ) {
+			return;
+		}
+
+		if( targetDuring.size() not_eq maze.getNumCells() ) {
+			visitedDuring.clear(); //Only the cell-at-a-time search needs this, so it waits until that search is used
+			targetDuring.assign( maze.getNumCells(), 0 );
+			searchNumber = 0;
+		}
+
+		searchNumber += 1;
+		if( searchNumber == 0 ) { //Wrapped around, so old searches' numbers could be mistaken for this one's
+			visitedDuring.assign( visitedDuring.size(), 0 );
+			targetDuring.assign( targetDuring.size(), 0 );
+			searchNumber = 1;
+		}
+
+		uint_fast32_t targetsLeft = 0;
+		for( decltype( targets.size() ) i = 0; i < targets.size(); ++i ) {
+			if( targetDuring[ targets[ i ] ] not_eq searchNumber ) {
+				targetDuring[ targets[ i ] ] = searchNumber;
+				targetsLeft += 1;
+			}
+		}
+
+		lastSearchPacked = ( maze.getCols() >= MIN_COLS_TO_PACK );
+		if( lastSearchPacked ) {
+			searchPacked( maze, startX, startY );
+			for( decltype( targets.size() ) i = 0; i < targets.size(); ++i ) {
+				if( targetDuring[ targets[ i ] ] == searchNumber and wasReached( targets[ i ], maze.getCols() ) ) {
+					targetDuring[ targets[ i ] ] = 0; //So that duplicates only get counted once
+					numReached += 1;
+				}
+			}
+			return;
+		}
+
+		if( visitedDuring.size() not_eq maze.getNumCells() ) {
+			visitedDuring.assign( maze.getNumCells(), 0 );
+			queue.reserve( maze.getNumCells() );
+		}
+
+		auto cols = maze.getCols();
+		auto rows = maze.getRows();
+		queue.clear();
+
+		auto visit = [ & ]( uint_fast32_t cell ) {
+			if( visitedDuring[ cell ] not_eq searchNumber ) {
+				visitedDuring[ cell ] = searchNumber;
+				queue.push_back( cell );
+				if( targetDuring[ cell ] == searchNumber ) {
+					targetsLeft -= 1;
+					numReached += 1;
+				}
+			}
+		};
+
+		visit( maze.index( startX, startY ) );
+
+		for( decltype( queue.size() ) i = 0; i < queue.size() and targetsLeft > 0; ++i ) {
+			uint_fast32_t cell = queue[ i ];
+			coordinate_t x = cell % cols;
+			coordinate_t y = cell / cols;
+
+			if( y > 0 and maze.getTop( x, y ) == MazeCell::NONE ) {
+				visit( cell - cols );
+			}
+			if( y < rows - 1 and maze.getTop( x, y + 1 ) == MazeCell::NONE ) {
+				visit( cell + cols );
+			}
+			if( x > 0 and maze.getLeft( x, y ) == MazeCell::NONE ) {
+				visit( cell - 1 );
+			}
+			if( x < cols - 1 and maze.getLeft( x + 1, y ) == MazeCell::NONE ) {
+				visit( cell + 1 );
+			}
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in Reachability::search(): " << e.what() << std::endl;
+	}
+}
+
+std::vector< bool > Reachability::whichCanBeReached( const MazeGrid& maze, coordinate_t startX, coordinate_t startY, const std::vector< uint_fast32_t >& targets ) {
+	try {
+		search( maze, startX, startY, targets );
+
+		std::vector< bool > result( targets.size(), false );
+		for( decltype( targets.size() ) i = 0; i < targets.size(); ++i ) {
+			result[ i ] = wasReached( targets[ i ], maze.getCols() );
+		}
+		return result;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in Reachability::whichCanBeReached(): " << e.what() << std::endl;
+		return std::vector< bool >( targets.size(), false );
+	}
+}
+
+void Reachability::pack( const MazeGrid& maze ) {
+	auto cols = maze.getCols();
+	auto rows = maze.getRows();
+	wordsPerRow = ( cols + 63 ) / 64;
+	openRight.assign( static_cast< uint_fast32_t >( rows ) * wordsPerRow, 0 );
+	openDown.assign( openRight.size(), 0 );
+	for( decltype( rows ) y = 0; y < rows; ++y ) {
+		auto row = static_cast< uint_fast32_t >( y ) * wordsPerRow;
+		for( decltype( wordsPerRow ) w = 0; w < wordsPerRow; ++w ) {
+			uint64_t right = 0;
+			uint64_t down = 0;
+			coordinate_t firstX = w * 64;
+			coordinate_t lastX = std::min( static_cast< uint_fast32_t >( cols ), ( w + 1 ) * 64 );
+			for( auto x = firstX; x < lastX; ++x ) {
+				right |= static_cast< uint64_t >( x < cols - 1 and maze.getLeft( x + 1, y ) == MazeCell::NONE ) << ( x - firstX );
+				down |= static_cast< uint64_t >( y < rows - 1 and maze.getTop( x, y + 1 ) == MazeCell::NONE ) << ( x - firstX );
+			}
+			openRight[ row + w ] = right;
+			openDown[ row + w ] = down;
+		}
+	}
+	packedWallsVersion = maze.getWallsVersion();
+}
+
+void Reachability::searchPacked( const MazeGrid& maze, coordinate_t startX, coordinate_t startY ) {
+	if( packedWallsVersion not_eq maze.getWallsVersion() or openRight.size() not_eq static_cast< uint_fast32_t >( maze.getRows() ) * ( ( maze.getCols() + 63 ) / 64 ) ) {
+		pack( maze );
+	}
+	reachedBits.assign( openRight.size(), 0 );
+	wordWaiting.assign( openRight.size(), false );
+	wordsToDo.clear();
+
+	//Adds cells to a word, and queues the word up if any of them are new
+	auto reach = [ & ]( uint_fast32_t word, uint64_t cells ) {
+		cells &= compl reachedBits[ word ];
+		if( cells not_eq 0 ) {
+			reachedBits[ word ] |= cells;
+			if( not wordWaiting[ word ] ) {
+				wordWaiting[ word ] = true;
+				wordsToDo.push_back( word );
+			}
+		}
+	};
+
+	reach( startY * wordsPerRow + startX / 64, static_cast< uint64_t >( 1 ) << ( startX % 64 ) );
+
+	auto lastRow = openRight.size() - wordsPerRow;
+	while( not wordsToDo.empty() ) {
+		uint_fast32_t word = wordsToDo.back();
+		wordsToDo.pop_back();
+		wordWaiting[ word ] = false;
+		auto w = word % wordsPerRow;
+
+		//Along the word: rightward (toward the high bits), then leftward. Each step doubles how far the fill can go: after the step with shift s, canMove only has a cell's bit set if the fill can move into it from each of the s cells before it. Mazes are mostly short runs, so canMove usually runs out long before the shifts do.
+		uint64_t fill = reachedBits[ word ];
+		uint64_t canMove = openRight[ word ] << 1;
+		for( uint_fast8_t shift = 1; shift < 64 and canMove not_eq 0; shift *= 2 ) {
+			fill |= canMove bitand ( fill << shift );
+			canMove &= canMove << shift;
+		}
+		canMove = openRight[ word ];
+		for( uint_fast8_t shift = 1; shift < 64 and canMove not_eq 0; shift *= 2 ) {
+			fill |= canMove bitand ( fill >> shift );
+			canMove &= canMove >> shift;
+		}
+		reachedBits[ word ] = fill;
+
+		//Then out of it
+		if( w + 1 < wordsPerRow ) {
+			reach( word + 1, ( fill bitand openRight[ word ] ) >> 63 );
+		}
+		if( w > 0 ) {
+			reach( word - 1, ( fill bitand ( openRight[ word - 1 ] >> 63 ) ) << 63 );
+		}
+		if( word < lastRow ) {
+			reach( word + wordsPerRow, fill bitand openDown[ word ] );
+		}
+		if( word >= wordsPerRow ) {
+			reach( word - wordsPerRow, fill bitand openDown[ word - wordsPerRow ] );
+		}
+	}
+}
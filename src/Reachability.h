@@ -0,0 +1,101 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The Reachability class answers whether cells in a maze can be reached from a given starting cell, without going through any walls or locks. One flood fill answers the question for any number of target cells at once. In wide mazes, the passages are packed one bit per cell, and the flood fill goes a whole row at a time, 64 cells per instruction, rather than one cell at a time.
+ */
+
+#ifndef REACHABILITY_H
+#define REACHABILITY_H
+
+#ifdef HAVE_VECTOR
+	#include <vector>
+#endif //HAVE_VECTOR
+#include "Integers.h"
+#include "MazeGrid.h"
+#include "PreprocessorCommands.h"
+
+class Reachability {
+	public:
+		/**
+		 * Constructor: Does nothing. Memory gets allocated the first time it's used on a maze and reused after that.
+		 */
+		Reachability();
+		/**
+		 * Destructor: Does nothing.
+		 */
+		virtual ~Reachability();
+
+		/**
+		 * Returns true if every one of the targets can be reached from the start cell. Stops searching as soon as the last target is found.
+		 * @param targets: Cell indices, as returned by MazeGrid::index(). Duplicates are fine.
+		 */
+		bool canReachAll( const MazeGrid& maze, coordinate_t startX, coordinate_t startY, const std::vector< uint_fast32_t >& targets );
+		/**
+		 * Returns which of the targets can be reached from the start cell, in the same order as the targets.
+		 * @param targets: Cell indices, as returned by MazeGrid::index(). Duplicates are fine.
+		 */
+		std::vector< bool > whichCanBeReached( const MazeGrid& maze, coordinate_t startX, coordinate_t startY, const std::vector< uint_fast32_t >& targets );
+		/**
+		 * Returns how many of the targets were reached by the last call to canReachAll() or whichCanBeReached().
+		 */
+		uint_fast32_t getNumReached() const;
+
+		/**
+		 * Mazes at least this wide are flood filled a row at a time. Narrower ones don't fill enough of each word to be worth it.
+		 */
+		static const coordinate_t MIN_COLS_TO_PACK = 64;
+	protected:
+	private:
+		/**
+		 * Rather than clearing a visited flag for every cell before each search, every search gets a new number, and a cell has been visited by this search if its entry in visitedDuring equals that number. The same goes for targetDuring. Everything only needs clearing once every four billion or so searches, when the number wraps around.
+		 */
+		uint_fast32_t searchNumber;
+		std::vector< uint_fast32_t > visitedDuring;
+		std::vector< uint_fast32_t > targetDuring;
+		std::vector< uint_fast32_t > queue;
+		uint_fast32_t numReached;
+
+		//The passages packed one bit per cell: bit x % 64 of word x / 64 in each row's words stands for column x. Only packed again when the walls change.
+		uint_fast64_t packedWallsVersion; ///< See MazeGrid::getWallsVersion()
+		uint_fast32_t wordsPerRow;
+		std::vector< uint64_t > openRight; ///< A cell's bit is set if there's no wall between it and the cell to its right
+		std::vector< uint64_t > openDown; ///< A cell's bit is set if there's no wall between it and the cell below it
+		std::vector< uint64_t > reachedBits; ///< A cell's bit is set if the last packed search reached it
+		std::vector< uint32_t > wordsToDo; ///< Words which have gained reached cells since they were last spread from
+		std::vector< uint8_t > wordWaiting; ///< One per word: whether it's in wordsToDo
+		bool lastSearchPacked;
+
+		/**
+		 * Does the actual flood fill: breadth-first, stopping early once every target has been reached. Hands wide mazes to searchPacked() instead.
+		 */
+		void search( const MazeGrid& maze, coordinate_t startX, coordinate_t startY, const std::vector< uint_fast32_t >& targets );
+		/**
+		 * Floods everything reachable from the start, 64 cells at a time: along each word as far as the walls allow in both directions, then into the words beside, above, and below it. Words are done again whenever they gain cells from a neighbor, until none do.
+		 */
+		void searchPacked( const MazeGrid& maze, coordinate_t startX, coordinate_t startY );
+		void pack( const MazeGrid& maze );
+		/**
+		 * Returns whether the last search reached the cell.
+		 */
+		inline bool wasReached( uint_fast32_t cell, coordinate_t cols ) const {
+			if( lastSearchPacked ) {
+				uint_fast32_t word = ( cell / cols ) * wordsPerRow + ( cell % cols ) / 64;
+				return word < reachedBits.size() and ( ( reachedBits[ word ] >> ( ( cell % cols ) % 64 ) ) bitand 1 );
+			}
+			return visitedDuring.size() > cell and visitedDuring[ cell ] == searchNumber;
+		}
+};
+
+#endif // REACHABILITY_H
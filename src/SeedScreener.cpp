@@ -0,0 +1,140 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The SeedScreener class picks a random seed whose maze matches the "target difficulty" preference. It makes the mazes for a list of candidate seeds on all the processor's cores at once, measures each one, and keeps the first seed on the list that's close enough. The result is an ordinary seed, so the maze can be saved, loaded, and sent to network clients the same as any other.
+ */
+
+#include "SeedScreener.h"
+
+#include <algorithm>
+#include <atomic>
+#ifdef HAVE_IOSTREAM
+	#include <iostream>
+#endif //HAVE_IOSTREAM
+#include <mutex>
+#include <thread>
+#ifdef HAVE_VECTOR
+	#include <vector>
+#endif //HAVE_VECTOR
+
+const uint_fast16_t SeedScreener::MAX_CANDIDATES;
+const float SeedScreener::TOLERANCE = 0.1f;
+
+SeedScreener::SeedScreener() {
+	try {
+		candidatesTried = 0;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in SeedScreener::SeedScreener(): " << e.what() << std::endl;
+	}
+}
+
+SeedScreener::~SeedScreener() {
+	try {
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in SeedScreener::~SeedScreener(): " << e.what() << std::endl;
+	}
+}
+
+std::minstd_rand::result_type SeedScreener::screen( const MazeManager::LevelSettings& settings, const MazeDifficulty& target, std::minstd_rand::result_type firstSeed, MazeManager& result ) {
+	try {
+		std::vector< std::minstd_rand::result_type > seeds( MAX_CANDIDATES );
+		{
+			std::minstd_rand following( firstSeed );
+			seeds[ 0 ] = firstSeed; //So that a maze which already matches comes out the same as it would without screening
+			for( decltype( seeds.size() ) s = 1; s < seeds.size(); ++s ) {
+				seeds[ s ] = following();
+			}
+		}
+
+		std::atomic< uint_fast16_t > nextCandidate( 0 );
+		std::atomic< uint_fast16_t > firstMatch( MAX_CANDIDATES ); //Candidates after it can't be chosen, so there's no point making them
+		std::atomic< uint_fast16_t > tried( 0 );
+
+		//Only touched while holding chosenMutex
+		std::mutex chosenMutex;
+		uint_fast16_t chosen = MAX_CANDIDATES;
+		bool chosenMatches = false;
+		float chosenMiss = 0;
+
+		auto work = [ & ]() {
+			MazeManager candidate;
+			candidate.showProgress = false;
+
+			for( auto c = nextCandidate++; c < firstMatch; c = nextCandidate++ ) {
+				candidate.setRandomSeed( seeds[ c ] );
+				candidate.makeRandomLevel( settings );
+				tried += 1;
+
+				MazeDifficulty measured;
+				measured.measure( candidate );
+				bool matches = measured.isWithin( target, TOLERANCE );
+				float miss = measured.missBy( target );
+
+				//A match beats anything that doesn't match, and the earliest match beats the rest. Without a match, the closest wins. Either way the order the threads finish in doesn't matter.
+				std::lock_guard< std::mutex > lock( chosenMutex );
+				bool better;
+				if( chosen == MAX_CANDIDATES ) {
+					better = true;
+				} else if( matches not_eq chosenMatches ) {
+					better = matches;
+				} else if( matches ) {
+					better = ( c < chosen );
+				} else {
+					better = ( miss < chosenMiss or ( miss == chosenMiss and c < chosen ) );
+				}
+
+				if( better ) {
+					chosen = c;
+					chosenMatches = matches;
+					chosenMiss = miss;
+					difficulty = measured;
+					result.swapLevel( candidate ); //candidate gets the old level, which its next makeRandomLevel() will replace
+				}
+				if( matches and c < firstMatch ) {
+					firstMatch = c;
+				}
+			}
+		};
+
+		{
+			uint_fast16_t numThreads = std::min< uint_fast16_t >( MAX_CANDIDATES, std::max< unsigned int >( 1, std::thread::hardware_concurrency() ) ); //hardware_concurrency() is zero if it can't tell
+			std::vector< std::thread > threads;
+			for( decltype( numThreads ) t = 1; t < numThreads; ++t ) {
+				threads.push_back( std::thread( work ) );
+			}
+			work();
+			for( decltype( threads.size() ) t = 0; t < threads.size(); ++t ) {
+				threads.at( t ).join();
+			}
+		}
+
+		candidatesTried = tried;
+		if( chosen == MAX_CANDIDATES ) { //Nothing got made, which can only happen if something threw
+			return firstSeed;
+		}
+		return seeds[ chosen ];
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in SeedScreener::screen(): " << e.what() << std::endl;
+		return firstSeed;
+	}
+}
+
+uint_fast16_t SeedScreener::getCandidatesTried() const {
+	return candidatesTried;
+}
+
+const MazeDifficulty& SeedScreener::getDifficulty() const {
+	return difficulty;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The SeedScreener class picks a random seed whose maze matches the "target difficulty" preference. It makes the mazes for a list of candidate seeds on all the processor's cores at once, measures each one, and keeps the first seed on the list that's close enough. The result is an ordinary seed, so the maze can be saved, loaded, and sent to network clients the same as any other.
+ */
+
+#ifndef SEEDSCREENER_H
+#define SEEDSCREENER_H
+
+#include <random>
+#include "Integers.h"
+#include "MazeDifficulty.h"
+#include "MazeManager.h"
+#include "PreprocessorCommands.h"
+
+class SeedScreener {
+	public:
+		/**
+		 * Constructor: Does nothing. Threads only get started while screen() is running.
+		 */
+		SeedScreener();
+		/**
+		 * Destructor: Does nothing.
+		 */
+		virtual ~SeedScreener();
+
+		/**
+		 * How many seeds get tried before giving up and taking the closest one.
+		 */
+		static const uint_fast16_t MAX_CANDIDATES = 256;
+		/**
+		 * How far off each measure can be, as a fraction of the target, for a maze to count as a match.
+		 */
+		static const float TOLERANCE;
+
+		/**
+		 * Tries firstSeed, then the seeds that follow it from an std::minstd_rand seeded with firstSeed, until one makes a maze within TOLERANCE of target. Which seed gets picked only depends on the candidates' order, never on which thread finished first, so it's the same every time. Must not be called with settings.endless on, since those mazes don't come from a single seed.
+		 * @param settings: What every candidate gets made with, from MazeManager::getCurrentSettings(). The threads only ever read this copy, never the game or its settings manager.
+		 * @param result: Gets the level made from the chosen seed, as if its makeRandomLevel( settings ) had been called with that seed, so there's no need to make it again.
+		 * @return the chosen seed, or the seed of the closest maze if none were close enough.
+		 */
+		std::minstd_rand::result_type screen( const MazeManager::LevelSettings& settings, const MazeDifficulty& target, std::minstd_rand::result_type firstSeed, MazeManager& result );
+
+		/**
+		 * How many candidates the last call to screen() made mazes for.
+		 */
+		uint_fast16_t getCandidatesTried() const;
+		/**
+		 * How hard the maze chosen by the last call to screen() is.
+		 */
+		const MazeDifficulty& getDifficulty() const;
+	protected:
+	private:
+		uint_fast16_t candidatesTried;
+		MazeDifficulty difficulty;
+};
+
+#endif // SEEDSCREENER_H
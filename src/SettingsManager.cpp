@@ -23,14 +23,13 @@
 #include <boost/lexical_cast.hpp>
 #include <iostream>
 #include <irrlicht/irrlicht.h>
-#include <SDL_mixer.h>
 #include <vector>
 
 #include "CustomException.h"
 #include "SettingsManager.h"
 
-#include "MainGame.h"
 #include "MazeManager.h"
+#include "SeedScreener.h"
 
 SettingsManager::SettingsManager() {
 	setPointers( nullptr, nullptr, nullptr, nullptr, nullptr, nullptr );
@@ -64,7 +63,14 @@ SettingsManager::SettingsManager() {
 	timeFormatDefault = L"%T";
 	debugDefault = false;
 	colorModeDefault = FULLCOLOR;
+	mazeSizeDefault = 30;
+	mazeGeneratorDefault = MazeGenerator::DEPTH_FIRST_SEARCH;
+	growingTreePolicyDefault = MazeGenerator::NEWEST;
+	endlessMazesDefault = false;
+	swarmSizeDefault = 0;
+	//targetDifficultyDefault is all "any", as made by MazeDifficulty's constructor
 	
+	debug = debugDefault; //resetToDefaults() leaves this alone, since MainGame decides it before reading the prefs; anything else (like HeadlessGame) would be left with garbage
 	playMusic = playMusicDefault; //This prevents resetToDefaults() from erroneously thinking that the music preference has been changed the first time that function gets called
 	
 	resetToDefaults();
@@ -96,21 +102,23 @@ void SettingsManager::setBitsPerPixel( uint_fast8_t newBPP ) {
 void SettingsManager::setBotAlgorithm( AI::algorithm_t newAlgorithm ) {
 	botAlgorithm = newAlgorithm;
 	switch( botAlgorithm ) {
-		case AI::DIJKSTRA: {
-			botsKnowSolution = true; //Dijkstra's algorithm only works if bots know the solution beforehand
-			if( ( mainGame != nullptr and mainGame != NULL ) and not mainGame->isNull( mainGame->settingsScreen.botsKnowSolutionCheckBox ) ) {
-				mainGame->settingsScreen.botsKnowSolutionCheckBox->setChecked( true );
-				mainGame->settingsScreen.botsKnowSolutionCheckBox->setEnabled( false );
-			}
+		case AI::DIJKSTRA:
+		case AI::A_STAR: {
+			botsKnowSolution = true; //Dijkstra's algorithm and A* only work if bots know the solution beforehand
 			break;
 		}
 		default: {
-			if( ( mainGame != nullptr and mainGame != NULL ) and not mainGame->isNull( mainGame->settingsScreen.botsKnowSolutionCheckBox ) ) {
-				mainGame->settingsScreen.botsKnowSolutionCheckBox->setEnabled( true );
-			}
 			break;
 		}
 	}
+	
+	if( mainGame != nullptr and mainGame != NULL ) {
+		mainGame->botAlgorithmChanged();
+	}
+}
+
+void SettingsManager::setEndlessMazes( bool newEndlessMazes ) {
+	endlessMazes = newEndlessMazes;
 }
 
 void SettingsManager::setFullscreenResolution( irr::core::dimension2d< irr::u32 > newResolution ) {
@@ -141,6 +149,19 @@ void SettingsManager::setPlayMusic( bool newSetting ) {
 	}
 }
 
+void SettingsManager::setSwarmSize( uint_fast32_t newSwarmSize ) {
+	if( newSwarmSize > 1000000 ) { //Each one takes a few dozen bytes, and drawing them all takes a while
+		std::wcerr << L"Error: " << newSwarmSize << L" swarm bots is too many. Using 1000000." << std::endl;
+		swarmSize = 1000000;
+	} else {
+		swarmSize = newSwarmSize;
+	}
+}
+
+void SettingsManager::setTargetDifficulty( MazeDifficulty newTarget ) {
+	targetDifficulty = newTarget;
+}
+
 void SettingsManager::savePrefs() {
 	try {
 		std::vector< boost::filesystem::path > configFolders = system->getConfigFolders(); // Flawfinder: ignore
@@ -288,7 +309,7 @@ void SettingsManager::savePrefs() {
 							
 							{
 								AI temp;
-								prefsFile << possiblePrefs.at( ALGORITHM ) << L"\t" << temp.stringFromAlgorithm( botAlgorithm ) << defaultString << temp.stringFromAlgorithm( botAlgorithmDefault ) << L". Controls which algorithm bots use to solve the maze. Possible values are Random Depth-First Search (will always find a way to a key/goal, not necessarily the nearest key/goal), Iterative Deepening Depth-First Search (will always find the nearest key/goal, but is really slow. May cause the game to freeze for short periods of time. Not recommended for slow computers!), Heuristic Depth-First Search (a version of DFS that tries to move towards the nearest key), Left Hand Rule and Right Hand Rule (inefficient), and Dijkstra (experimental!)." << std::endl;
+								prefsFile << possiblePrefs.at( ALGORITHM ) << L"\t" << temp.stringFromAlgorithm( botAlgorithm ) << defaultString << temp.stringFromAlgorithm( botAlgorithmDefault ) << L". Controls which algorithm bots use to solve the maze. Possible values are Random Depth-First Search (will always find a way to a key/goal, not necessarily the nearest key/goal), Iterative Deepening Depth-First Search (will always find the nearest key/goal, but is really slow. May cause the game to freeze for short periods of time. Not recommended for slow computers!), Heuristic Depth-First Search (a version of DFS that tries to move towards the nearest key), Left Hand Rule and Right Hand Rule (inefficient), Dijkstra (experimental!), and A* (always finds the shortest way to a key/goal, and looks at fewer cells than Dijkstra on the way)." << std::endl;
 							}
 							
 							prefsFile << possiblePrefs.at( SOLUTION_KNOWN ) << L"\t" << sc.toStdWString( botsKnowSolution ) << defaultString << sc.toStdWString( botsKnowSolutionDefault ) << L". Whether the bots know the solution or have to find it as they play. Note that they do not necessarily know the *best* solution, just one that works." << std::endl;
@@ -302,6 +323,18 @@ void SettingsManager::savePrefs() {
 							
 							prefsFile << possiblePrefs.at( HIDE_UNSEEN ) << L"\t" << sc.toStdWString( hideUnseen ) << defaultString << sc.toStdWString( hideUnseenDefault ) << L". Hides parts of the maze that no player has seen yet (seen means unobstructed line-of-sight from any player's position)" << std::endl;
 							
+							prefsFile << possiblePrefs.at( MAZE_SIZE ) << L"\t" << sc.toStdWString( mazeSize ) << defaultString << sc.toStdWString( mazeSizeDefault ) << L". Controls how big random mazes can get: each maze will be between 2 and this many minus one cells wide, and up to 4 cells taller than it is wide. Must be an integer between 3 and " << sc.toStdWString( COORDINATE_MAX - 4 ) << L". Everyone in a network game uses the server's maze size. Huge mazes take a long time to generate and solve, which can be handy for testing." << std::endl;
+							
+							prefsFile << possiblePrefs.at( MAZE_GENERATOR ) << L"\t" << MazeGenerator::stringFromAlgorithm( mazeGenerator ) << defaultString << MazeGenerator::stringFromAlgorithm( mazeGeneratorDefault ) << L". Controls which algorithm makes random mazes. Possible values are Depth-First Search (long, twisty corridors; one of the fastest), Kruskal (lots of short dead ends; the slowest, and needs the most memory), Wilson (an unbiased mix of long and short corridors), Prim (lots of short dead ends), and Growing Tree (looks like one of the others depending on the growing tree selection preference). The same random seed only makes the same maze with the same generator. Everyone in a network game uses the server's generator." << std::endl;
+							
+							prefsFile << possiblePrefs.at( ENDLESS_MAZES ) << L"\t" << sc.toStdWString( endlessMazes ) << defaultString << sc.toStdWString( endlessMazesDefault ) << L". Makes each maze carry on from where the last one ended, with no waiting between them: the goal leads into the next maze, and the next maze is generated in the background while you play. Good for leaving bots running for a long time. The maze generator preference is ignored, the maze size preference only counts when the game starts, and network games never use endless mazes. The screensaver always uses endless mazes." << std::endl;
+							
+							prefsFile << possiblePrefs.at( SWARM_SIZE ) << L"\t" << sc.toStdWString( swarmSize ) << defaultString << sc.toStdWString( swarmSizeDefault ) << L". Adds this many extra bots which don't play: they don't pick anything up or win, they just go around and around the maze from the start to each key and the goal. They're moved and drawn all at once, so there can be thousands of them. Handy for seeing how the game copes with lots of bots, and nice to watch in the screensaver. Must be an integer between 0 and 1,000,000." << std::endl;
+							
+							prefsFile << possiblePrefs.at( TARGET_DIFFICULTY ) << L"\t" << MazeDifficulty::toString( targetDifficulty ) << defaultString << MazeDifficulty::toString( targetDifficultyDefault ) << L". Makes the game look for random mazes of about this difficulty, instead of taking whatever maze the next random seed makes. Four numbers separated by spaces: how many steps it is from the start to the goal, the fraction of cells which are dead ends (between 0 and 1), the average number of ways on from a cell which isn't a dead end (1 is all corridors), and how many keys there are. Any of them can be \"any\" instead, and any left off the end count as \"any\". The game tries up to " << SeedScreener::MAX_CANDIDATES << L" seeds on all your processor's cores while you play the current maze, and takes the first one within " << static_cast< int >( SeedScreener::TOLERANCE * 100 ) << L"% of every number, or the closest if none are. The maze size and maze generator preferences still apply, so ask for something they can make. Only the server looks; everyone else in a network game gets the seed it picked. Has no effect on endless mazes." << std::endl;
+							
+							prefsFile << possiblePrefs.at( GROWING_TREE_POLICY ) << L"\t" << MazeGenerator::stringFromPolicy( growingTreePolicy ) << defaultString << MazeGenerator::stringFromPolicy( growingTreePolicyDefault ) << L". Only matters if the maze generator is Growing Tree. Controls which cell it grows the maze from next. Possible values are Newest (like Depth-First Search), Random (like Prim), Oldest (long straight corridors), and Newest or Random (half and half)." << std::endl;
+							
 							prefsFile << possiblePrefs.at( TIME_FORMAT ) << L"\t" << timeFormat << defaultString << timeFormatDefault << L". Must be in wcsftime format. See http://www.cplusplus.com/reference/ctime/strftime/ for a format reference." << std::endl;
 							
 							prefsFile << possiblePrefs.at( DATE_FORMAT ) << L"\t" << dateFormat << defaultString << dateFormatDefault << L". Must be in wcsftime format. See http://www.cplusplus.com/reference/ctime/strftime/ for a format reference." << std::endl;
@@ -332,14 +365,30 @@ AI::algorithm_t SettingsManager::getBotAlgorithm() {
 	return botAlgorithm;
 }
 
+bool SettingsManager::getEndlessMazes() {
+	return endlessMazes;
+}
+
 irr::core::dimension2d< irr::u32 > SettingsManager::getFullscreenResolution() {
 	return fullscreenResolution;
 }
 
+MazeGenerator::policy_t SettingsManager::getGrowingTreePolicy() {
+	return growingTreePolicy;
+}
+
 bool SettingsManager::getHideUnseen() {
 	return hideUnseen;
 }
 
+MazeGenerator::algorithm_t SettingsManager::getMazeGenerator() {
+	return mazeGenerator;
+}
+
+coordinate_t SettingsManager::getMazeSize() {
+	return mazeSize;
+}
+
 irr::core::dimension2d< irr::u32 > SettingsManager::getMinimumWindowSize() {
 	return minimumWindowSize;
 }
@@ -352,6 +401,14 @@ bool SettingsManager::getPlayMusic() {
 	return playMusic;
 }
 
+uint_fast32_t SettingsManager::getSwarmSize() {
+	return swarmSize;
+}
+
+const MazeDifficulty& SettingsManager::getTargetDifficulty() {
+	return targetDifficulty;
+}
+
 irr::core::dimension2d< irr::u32 > SettingsManager::getWindowSize() {
 	return windowSize;
 }
@@ -470,15 +527,14 @@ void SettingsManager::readPrefs() {
 												
 												if( choiceAsInt <= 100 ) {
 													musicVolume = choiceAsInt;
-													Mix_VolumeMusic( musicVolume * MIX_MAX_VOLUME / 100 );
+													mainGame->musicVolumeChanged();
 													if( debug ) {
 														std::wcout << L"Volume should be " << choiceAsInt << "%" << std::endl;
-														std::wcout << L"Volume is really " << 100 * Mix_VolumeMusic( -1 ) / MIX_MAX_VOLUME << "%" << std::endl;
 													}
 												} else {
 													std::wcerr << L"Warning: Volume greater than 100%: " << choiceAsInt << std::endl;
-													Mix_VolumeMusic( MIX_MAX_VOLUME );
 													musicVolume = 100;
+													mainGame->musicVolumeChanged();
 												}
 											} catch( boost::bad_lexical_cast &e ) {
 												std::wcerr << L"Error reading volume preference (is it not a number?) on line " << lineNum << L": " << e.what() << std::endl;
@@ -657,6 +713,44 @@ void SettingsManager::readPrefs() {
 											break;
 										}
 										
+										case MAZE_SIZE: { //L"maze size"
+											try {
+												setMazeSize( boost::lexical_cast< coordinate_t >( choice ) );
+											} catch( boost::bad_lexical_cast &e ) {
+												std::wcerr << L"Error reading maze size preference (is it not a number?) on line " << lineNum << L": " << e.what() << std::endl;
+											}
+											break;
+										}
+										
+										case MAZE_GENERATOR: { //L"maze generator"
+											setMazeGenerator( MazeGenerator::algorithmFromString( choice ) );
+											break;
+										}
+										
+										case ENDLESS_MAZES: { //L"endless mazes"
+											endlessMazes = wStringToBool( choice );
+											break;
+										}
+										
+										case SWARM_SIZE: { //L"swarm bots"
+											try {
+												setSwarmSize( boost::lexical_cast< uint_fast32_t >( choice ) );
+											} catch( boost::bad_lexical_cast &e ) {
+												std::wcerr << L"Error reading swarm bots preference (is it not a number?) on line " << lineNum << L": " << e.what() << std::endl;
+											}
+											break;
+										}
+										
+										case TARGET_DIFFICULTY: { //L"target difficulty"
+											setTargetDifficulty( MazeDifficulty::fromString( choice ) );
+											break;
+										}
+										
+										case GROWING_TREE_POLICY: { //L"growing tree selection"
+											setGrowingTreePolicy( MazeGenerator::policyFromString( choice ) );
+											break;
+										}
+										
 										case BACKGROUND_ANIMATIONS: { //L"ackground animations"
 											backgroundAnimations = wStringToBool( choice );
 											break;
@@ -763,6 +857,12 @@ void SettingsManager::resetToDefaults() {
 	}
 	
 	hideUnseen = hideUnseenDefault;
+	mazeSize = mazeSizeDefault;
+	mazeGenerator = mazeGeneratorDefault;
+	growingTreePolicy = growingTreePolicyDefault;
+	endlessMazes = endlessMazesDefault;
+	swarmSize = swarmSizeDefault;
+	targetDifficulty = targetDifficultyDefault;
 	
 	if( device != nullptr ) {
 		fullscreenResolution = device->getVideoModeList()->getDesktopResolution();
@@ -771,6 +871,36 @@ void SettingsManager::resetToDefaults() {
 
 
 
+void SettingsManager::setGrowingTreePolicy( MazeGenerator::policy_t newPolicy ) {
+	if( newPolicy < MazeGenerator::POLICY_DO_NOT_USE ) {
+		growingTreePolicy = newPolicy;
+	} else {
+		std::wcerr << L"Error: unrecognized growing tree selection. Using " << MazeGenerator::stringFromPolicy( growingTreePolicyDefault ) << L"." << std::endl;
+		growingTreePolicy = growingTreePolicyDefault;
+	}
+}
+
+void SettingsManager::setMazeGenerator( MazeGenerator::algorithm_t newGenerator ) {
+	if( newGenerator < MazeGenerator::ALGORITHM_DO_NOT_USE ) {
+		mazeGenerator = newGenerator;
+	} else {
+		std::wcerr << L"Error: unrecognized maze generator. Using " << MazeGenerator::stringFromAlgorithm( mazeGeneratorDefault ) << L"." << std::endl;
+		mazeGenerator = mazeGeneratorDefault;
+	}
+}
+
+void SettingsManager::setMazeSize( coordinate_t newMazeSize ) {
+	if( newMazeSize < 3 ) { //makeRandomLevel() divides by mazeSize - 2
+		std::wcerr << L"Error: maze size " << newMazeSize << L" is too small. Using 3." << std::endl;
+		mazeSize = 3;
+	} else if( newMazeSize > COORDINATE_MAX - 4 ) { //makeRandomLevel() may add 4 to get the number of rows
+		std::wcerr << L"Error: maze size " << newMazeSize << L" is too big. Using " << COORDINATE_MAX - 4 << L"." << std::endl;
+		mazeSize = COORDINATE_MAX - 4;
+	} else {
+		mazeSize = newMazeSize;
+	}
+}
+
 void SettingsManager::setNumBots( uint_fast8_t newNumBots ) {
 	numBots = newNumBots;
 	
@@ -788,7 +918,7 @@ void SettingsManager::setNumPlayers( uint_fast8_t newNumPlayers ) {
 }
 
 
-void SettingsManager::setPointers( irr::IrrlichtDevice* newDevice, MainGame* newMainGame, MazeManager* newMazeManager, NetworkManager* newNetwork, SpellChecker* newSpellChecker, SystemSpecificsManager* newSystem ) {
+void SettingsManager::setPointers( irr::IrrlichtDevice* newDevice, Game* newMainGame, MazeManager* newMazeManager, NetworkManager* newNetwork, SpellChecker* newSpellChecker, SystemSpecificsManager* newSystem ) {
 	device = newDevice;
 	mainGame = newMainGame;
 	mazeManager = newMazeManager;
@@ -20,12 +20,15 @@
 #define SETTINGSMANAGER_H
 
 #include "AI.h"
+#include "Game.h"
+#include "MazeDifficulty.h"
+#include "MazeGenerator.h"
 //#include "MazeManager.h"
-#include "NetworkManager.h"
 #include "SpellChecker.h"
 #include "SystemSpecificsManager.h"
 
 class MazeManager; //Avoids circular dependency
+class NetworkManager; //Only a pointer is needed here, and this keeps RakNet out of anything that doesn't use the network
 
 class SettingsManager
 {
@@ -33,7 +36,7 @@ class SettingsManager
 		SettingsManager();
 		~SettingsManager();
 		
-		void setPointers( irr::IrrlichtDevice* newDevice, MainGame* newMainGame, MazeManager* newMazeManager, NetworkManager* newNetwork, SpellChecker* newSpellChecker, SystemSpecificsManager* newSystem ); //Must be called before readPrefs!
+		void setPointers( irr::IrrlichtDevice* newDevice, Game* newMainGame, MazeManager* newMazeManager, NetworkManager* newNetwork, SpellChecker* newSpellChecker, SystemSpecificsManager* newSystem ); //Must be called before readPrefs!
 		
 		bool allowSmallSize;
 		bool alwaysServer;
@@ -66,12 +69,18 @@ class SettingsManager
 		
 		uint_fast8_t getBitsPerPixel();
 		AI::algorithm_t getBotAlgorithm();
+		bool getEndlessMazes();
+		MazeGenerator::policy_t getGrowingTreePolicy();
 		bool getHideUnseen();
+		MazeGenerator::algorithm_t getMazeGenerator();
+		coordinate_t getMazeSize();
 		irr::core::dimension2d< irr::u32 > getMinimumWindowSize();
 		uint_fast8_t getMusicVolume();
 		uint_fast8_t getNumBots();
 		uint_fast8_t getNumPlayers();
 		bool getPlayMusic();
+		uint_fast32_t getSwarmSize();
+		const MazeDifficulty& getTargetDifficulty();
 		irr::core::dimension2d< irr::u32 > getWindowSize();
 		
 		bool isServer;
@@ -88,12 +97,18 @@ class SettingsManager
 		void savePrefs();
 		void setBitsPerPixel( uint_fast8_t newBPP );
 		void setBotAlgorithm( AI::algorithm_t newAlgorithm );
+		void setEndlessMazes( bool newEndlessMazes );
 		void setFullscreenResolution( irr::core::dimension2d< irr::u32 > newResolution );
+		void setGrowingTreePolicy( MazeGenerator::policy_t newPolicy );
 		void setHideUnseen( bool newHideUnseen );
+		void setMazeGenerator( MazeGenerator::algorithm_t newGenerator );
+		void setMazeSize( coordinate_t newMazeSize );
 		void setMusicVolume( uint_fast8_t newVolume );
 		void setNumBots( uint_fast8_t newNumBots );
 		void setNumPlayers( uint_fast8_t newNumPlayers );
 		void setPlayMusic( bool newSetting );
+		void setSwarmSize( uint_fast32_t newSwarmSize );
+		void setTargetDifficulty( MazeDifficulty newTarget );
 		void setWindowSize( irr::core::dimension2d< irr::u32 > newSize );
 		bool showBackgrounds;
 		bool showBackgroundsDefault;
@@ -114,14 +129,24 @@ class SettingsManager
 		std::vector< std::wstring > driverTypes = { L"opengl", L"direct3d9", L"direct3d8", L"burning's video", L"software", L"null" };
 		enum driver_t : uint_fast8_t { OPENGL = 0, DIRECT3D9 = 1, DIRECT3D8 = 2, BURNINGS = 3, SOFTWARE = 4, DRIVERNULL = 5, DRIVER_DO_NOT_USE = 255 };
 		
+		bool endlessMazes;
+		bool endlessMazesDefault;
+		
 		irr::core::dimension2d< irr::u32 > fullscreenResolution;
 		irr::core::dimension2d< irr::u32 > fullscreenResolutionDefault;
 		
+		MazeGenerator::policy_t growingTreePolicy;
+		MazeGenerator::policy_t growingTreePolicyDefault;
+		
 		bool hideUnseen;
 		bool hideUnseenDefault;
 		
-		MainGame* mainGame;
+		Game* mainGame;
+		MazeGenerator::algorithm_t mazeGenerator;
+		MazeGenerator::algorithm_t mazeGeneratorDefault;
 		MazeManager* mazeManager;
+		coordinate_t mazeSize; //Random mazes are between 2 and mazeSize - 1 columns wide
+		coordinate_t mazeSizeDefault;
 		irr::core::dimension2d< irr::u32 > minimumWindowSize; //This should be ignored if allowSmallSize is true.
 		uint_fast8_t musicVolume;
 		uint_fast8_t musicVolumeDefault;
@@ -140,15 +165,22 @@ class SettingsManager
 		std::vector< std::wstring > possiblePrefs = { L"bots' solving algorithm", L"volume", L"number of bots", L"show backgrounds",
 									L"fullscreen", L"mark player trails", L"debug", L"bits per pixel", L"wait for vertical sync", L"driver type", L"number of players",
 									L"window size", L"play music", L"network port", L"always server", L"bots know the solution", L"bot movement delay", L"hide unseen maze areas", L"background animations",
-									L"autodetect fullscreen resolution", L"fullscreen resolution", L"time format", L"date format" };
+									L"autodetect fullscreen resolution", L"fullscreen resolution", L"time format", L"date format", L"maze size",
+									L"maze generator", L"growing tree selection", L"endless mazes", L"swarm bots", L"target difficulty" };
 		//Each item in pref_t must match with an item in possiblePrefs.
 		enum pref_t : uint_fast8_t { ALGORITHM = 0, VOLUME = 1, NUMBOTS = 2, SHOW_BACKGROUNDS = 3, FULLSCREEN = 4, MARK_TRAILS = 5, DEBUG = 6, BPP = 7, VSYNC = 8, DRIVER_TYPE = 9, NUMPLAYERS = 10,
 									WINDOW_SIZE = 11, PLAY_MUSIC = 12, NETWORK_PORT = 13, ALWAYS_SERVER = 14, SOLUTION_KNOWN = 15, MOVEMENT_DELAY = 16, HIDE_UNSEEN = 17, BACKGROUND_ANIMATIONS = 18, 
-									AUTODETECT_RESOLUTION = 19, FULLSCREEN_RESOLUTION = 20, TIME_FORMAT = 21, DATE_FORMAT = 22 };
+									AUTODETECT_RESOLUTION = 19, FULLSCREEN_RESOLUTION = 20, TIME_FORMAT = 21, DATE_FORMAT = 22, MAZE_SIZE = 23,
+									MAZE_GENERATOR = 24, GROWING_TREE_POLICY = 25, ENDLESS_MAZES = 26, SWARM_SIZE = 27, TARGET_DIFFICULTY = 28 };
 		
 		SpellChecker* spellChecker;
+		uint_fast32_t swarmSize; //How many bots BotSwarm runs, on top of numBots
+		uint_fast32_t swarmSizeDefault;
 		SystemSpecificsManager* system; // Flawfinder: ignore
 		
+		MazeDifficulty targetDifficulty; //What SeedScreener looks for in a maze. Screening is off unless something's set.
+		MazeDifficulty targetDifficultyDefault;
+		
 		irr::core::dimension2d< irr::u32 > windowSize;
 		irr::core::dimension2d< irr::u32 > windowSizeDefault;
 		bool wStringToBool( std::wstring choice );
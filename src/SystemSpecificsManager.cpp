@@ -30,6 +30,13 @@
 #include "SystemSpecificsManager.h"
 #include "PreprocessorCommands.h"
 
+#if defined WINDOWS
+	#include <windows.h>
+	#include <psapi.h>
+#elif defined UNIX || defined MACOSX
+	#include <sys/resource.h>
+#endif
+
 std::wstring SystemSpecificsManager::getEnvironmentVariable( std::string name ) {
 	char * result = getenv( name.c_str() );
 	//cppcheck-suppress duplicateExpression
@@ -257,6 +264,26 @@ std::vector< boost::filesystem::path > SystemSpecificsManager::getImageFolders()
 	return imageFolders;
 }
 
+//Returns 0 if we don't know how to find out on this operating system
+uint_fast64_t SystemSpecificsManager::getPeakMemoryUsage() {
+	#if defined WINDOWS
+		PROCESS_MEMORY_COUNTERS counters;
+		if( GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) ) ) {
+			return counters.PeakWorkingSetSize;
+		}
+	#elif defined UNIX || defined MACOSX
+		struct rusage usage;
+		if( getrusage( RUSAGE_SELF, &usage ) == 0 ) {
+			#if defined MACOSX
+				return usage.ru_maxrss; //OS X gives it in bytes
+			#else
+				return static_cast< uint_fast64_t >( usage.ru_maxrss ) * 1024; //Everybody else gives it in kilobytes
+			#endif
+		}
+	#endif
+	return 0;
+}
+
 std::vector< boost::filesystem::path > SystemSpecificsManager::getMusicFolders() {
 	std::vector< boost::filesystem::path > musicFolders;
 	musicFolders.push_back( boost::filesystem::current_path() );
@@ -24,6 +24,7 @@
 	#include <vector>
 #endif //HAVE_VECTOR
 
+#include "Integers.h"
 #include "PreprocessorCommands.h"
 #include "StringConverter.h"
 #include <string>
@@ -36,6 +37,10 @@ class SystemSpecificsManager {
 		std::vector< boost::filesystem::path > getFontFolders();
 		std::vector< boost::filesystem::path > getImageFolders();
 		std::vector< boost::filesystem::path > getMusicFolders();
+		/**
+		 * Returns the most memory this process has used at any one time so far, in bytes, or 0 if that can't be found out on this operating system.
+		 */
+		uint_fast64_t getPeakMemoryUsage();
 		std::vector< boost::filesystem::path > getConfigFolders(); //Order: Increasing specificity of who can read/write to the folder. I.e. start with system-wide stuff, end with stuff specific to the current user.
 		bool canBeUsedAsFolder( boost::filesystem::path folder );
 		std::wstring getEnvironmentVariable( std::string name );
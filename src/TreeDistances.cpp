@@ -0,0 +1,261 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The TreeDistances class answers how far apart two cells are without searching at all, as long as the maze has no loops. A freshly made maze is a tree (or, for pieces of an endless maze, a few trees), so there's exactly one way between any two cells: up from each of them to the nearest cell they share on the way to the root, and back down. That shared cell is found in constant time from a depth-first ordering of the cells and a table of the shallowest cell in each power-of-two run of them. Once a wall is dissolved there can be loops, so it stops answering and everybody goes back to searching.
+ */
+
+#include "TreeDistances.h"
+
+#include <algorithm>
+#ifdef HAVE_IOSTREAM
+	#include <iostream>
+#endif //HAVE_IOSTREAM
+
+const uint32_t TreeDistances::UNREACHABLE;
+const uint_fast32_t TreeDistances::BLOCK_SIZE;
+const uint32_t TreeDistances::NO_PARENT;
+
+TreeDistances::TreeDistances() {
+	try {
+		tree = false;
+		layoutVersion = 0;
+		wallChangesApplied = 0;
+		cellsSearched = 0;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in TreeDistances::TreeDistances(): " << e.what() << std::endl;
+	}
+}
+
+TreeDistances::~TreeDistances() {
+	try {
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in TreeDistances::~TreeDistances(): " << e.what() << std::endl;
+	}
+}
+
+void TreeDistances::build( const MazeGrid& maze ) {
+	auto numCells = maze.getNumCells();
+	auto cols = maze.getCols();
+	auto rows = maze.getRows();
+	tree = true;
+	parent.assign( numCells, NO_PARENT );
+	depth.assign( numCells, 0 );
+	root.assign( numCells, NO_PARENT ); //Doubles as a record of which cells have been reached
+	position.resize( numCells );
+	order.clear();
+	order.reserve( numCells );
+
+	//Depth-first, so that everything under a cell comes right after it in order. In a tree, the only neighbor already reached is the one we came from; any other means there's a loop.
+	std::vector< uint32_t > stack;
+	for( decltype( numCells ) r = 0; r < numCells and tree; ++r ) {
+		if( root[ r ] not_eq NO_PARENT ) {
+			continue;
+		}
+		root[ r ] = r;
+		stack.push_back( r );
+		while( not stack.empty() and tree ) {
+			uint32_t cell = stack.back();
+			stack.pop_back();
+			position[ cell ] = order.size();
+			order.push_back( cell );
+
+			coordinate_t x = cell % cols;
+			coordinate_t y = cell / cols;
+			auto reach = [ & ]( uint32_t neighbor ) {
+				if( neighbor == parent[ cell ] ) {
+					return;
+				}
+				if( root[ neighbor ] not_eq NO_PARENT ) {
+					tree = false;
+					return;
+				}
+				root[ neighbor ] = r;
+				parent[ neighbor ] = cell;
+				depth[ neighbor ] = depth[ cell ] + 1;
+				stack.push_back( neighbor );
+			};
+			if( y > 0 and isPassage( maze.getTop( x, y ) ) ) {
+				reach( cell - cols );
+			}
+			if( x > 0 and isPassage( maze.getLeft( x, y ) ) ) {
+				reach( cell - 1 );
+			}
+			if( y < rows - 1 and isPassage( maze.getTop( x, y + 1 ) ) ) {
+				reach( cell + cols );
+			}
+			if( x < cols - 1 and isPassage( maze.getLeft( x + 1, y ) ) ) {
+				reach( cell + 1 );
+			}
+		}
+	}
+	cellsSearched += order.size();
+	if( not tree ) {
+		return;
+	}
+
+	parentByDepth.resize( numCells );
+	for( decltype( numCells ) i = 0; i < numCells; ++i ) {
+		auto above = parent[ order[ i ] ];
+		parentByDepth[ i ] = ( above == NO_PARENT ? UINT64_MAX : ( static_cast< uint64_t >( depth[ above ] ) << 32 ) bitor above );
+	}
+
+	auto numBlocks = ( numCells + BLOCK_SIZE - 1 ) / BLOCK_SIZE;
+	floorLog2.assign( numBlocks + 1, 0 );
+	for( decltype( numBlocks ) n = 2; n <= numBlocks; ++n ) {
+		floorLog2[ n ] = floorLog2[ n / 2 ] + 1;
+	}
+	blockMinimum.resize( floorLog2[ numBlocks ] + 1 );
+	blockMinimum[ 0 ].assign( numBlocks, UINT64_MAX );
+	for( decltype( numCells ) i = 0; i < numCells; ++i ) {
+		blockMinimum[ 0 ][ i / BLOCK_SIZE ] = std::min( blockMinimum[ 0 ][ i / BLOCK_SIZE ], parentByDepth[ i ] );
+	}
+	for( decltype( blockMinimum.size() ) k = 1; k < blockMinimum.size(); ++k ) {
+		decltype( numBlocks ) half = 1 << ( k - 1 );
+		blockMinimum[ k ].resize( numBlocks - 2 * half + 1 );
+		for( decltype( numBlocks ) b = 0; b < blockMinimum[ k ].size(); ++b ) {
+			blockMinimum[ k ][ b ] = std::min( blockMinimum[ k - 1 ][ b ], blockMinimum[ k - 1 ][ b + half ] );
+		}
+	}
+
+	countLocks( maze );
+}
+
+void TreeDistances::countLocks( const MazeGrid& maze ) {
+	locksAbove.resize( order.size() );
+	for( decltype( order.size() ) i = 0; i < order.size(); ++i ) {
+		auto cell = order[ i ];
+		auto above = parent[ cell ];
+		if( above == NO_PARENT ) {
+			locksAbove[ cell ] = 0;
+		} else {
+			locksAbove[ cell ] = locksAbove[ above ] + ( wallBetween( maze, cell, above ) == MazeCell::LOCK ? 1 : 0 );
+		}
+	}
+}
+
+uint32_t TreeDistances::distance( uint_fast32_t from, uint_fast32_t to, bool throughLocks ) const {
+	if( not tree or from >= root.size() or to >= root.size() or root[ from ] not_eq root[ to ] ) {
+		return UNREACHABLE;
+	}
+	auto shared = sharedAncestor( from, to );
+	if( not throughLocks and locksAbove[ from ] + locksAbove[ to ] not_eq 2 * locksAbove[ shared ] ) {
+		return UNREACHABLE;
+	}
+	return depth[ from ] + depth[ to ] - 2 * depth[ shared ];
+}
+
+uint_fast64_t TreeDistances::getCellsSearched() const {
+	return cellsSearched;
+}
+
+bool TreeDistances::path( const MazeGrid& maze, uint_fast32_t from, uint_fast32_t to, bool throughLocks, std::vector< irr::core::position2d< coordinate_t > >& path ) const {
+	path.clear();
+	if( distance( from, to, throughLocks ) == UNREACHABLE ) {
+		return false;
+	}
+	auto shared = sharedAncestor( from, to );
+	auto cols = maze.getCols();
+
+	//Up from the start to the shared cell, then down to the end, which is the way up from the end backward
+	for( auto cell = from; cell not_eq shared; ) {
+		cell = parent[ cell ];
+		path.push_back( irr::core::position2d< coordinate_t >( cell % cols, cell / cols ) );
+	}
+	auto downFrom = path.size();
+	for( auto cell = to; cell not_eq shared; cell = parent[ cell ] ) {
+		path.push_back( irr::core::position2d< coordinate_t >( cell % cols, cell / cols ) );
+	}
+	std::reverse( path.begin() + downFrom, path.end() );
+	return true;
+}
+
+uint32_t TreeDistances::sharedAncestor( uint_fast32_t a, uint_fast32_t b ) const {
+	if( a == b ) {
+		return a;
+	}
+	uint_fast32_t first = std::min( position[ a ], position[ b ] ) + 1;
+	uint_fast32_t last = std::max( position[ a ], position[ b ] );
+
+	uint64_t smallest = UINT64_MAX;
+	auto firstBlock = first / BLOCK_SIZE;
+	auto lastBlock = last / BLOCK_SIZE;
+	if( lastBlock - firstBlock < 2 ) {
+		for( auto i = first; i <= last; ++i ) {
+			smallest = std::min( smallest, parentByDepth[ i ] );
+		}
+	} else {
+		//The partial blocks at each end one cell at a time, and the whole blocks between them as two overlapping runs from the table
+		for( auto i = first; i < ( firstBlock + 1 ) * BLOCK_SIZE; ++i ) {
+			smallest = std::min( smallest, parentByDepth[ i ] );
+		}
+		for( auto i = lastBlock * BLOCK_SIZE; i <= last; ++i ) {
+			smallest = std::min( smallest, parentByDepth[ i ] );
+		}
+		auto numWholeBlocks = lastBlock - firstBlock - 1;
+		auto k = floorLog2[ numWholeBlocks ];
+		smallest = std::min( smallest, blockMinimum[ k ][ firstBlock + 1 ] );
+		smallest = std::min( smallest, blockMinimum[ k ][ lastBlock - ( static_cast< uint_fast32_t >( 1 ) << k ) ] );
+	}
+	return static_cast< uint32_t >( smallest bitand UINT32_MAX );
+}
+
+void TreeDistances::update( const MazeGrid& maze ) {
+	try {
+		if( maze.getLayoutVersion() not_eq layoutVersion or parent.size() not_eq maze.getNumCells() ) { //Before getWallChanges() gets looked at, since a new layout clears them
+			layoutVersion = maze.getLayoutVersion();
+			build( maze );
+			wallChangesApplied = maze.getWallChanges().size();
+			return;
+		}
+
+		//Opening a lock keeps the same passages, so the tree still stands and only the lock counts change. Anything else (a dissolved wall, most likely) can make a loop.
+		auto& changes = maze.getWallChanges();
+		bool locksChanged = false;
+		for( ; wallChangesApplied < changes.size(); ++wallChangesApplied ) {
+			auto& change = changes[ wallChangesApplied ];
+			if( not tree or ( change.left and change.x == 0 ) or ( not change.left and change.y == 0 ) ) { //The maze's outer border
+				continue;
+			}
+			auto here = maze.index( change.x, change.y );
+			auto there = ( change.left ? here - 1 : here - maze.getCols() );
+			bool wasPassage = ( parent[ here ] == there or parent[ there ] == here );
+			if( isPassage( change.left ? maze.getLeft( change.x, change.y ) : maze.getTop( change.x, change.y ) ) not_eq wasPassage ) {
+				tree = false;
+			} else {
+				locksChanged = true;
+			}
+		}
+		if( tree and locksChanged ) {
+			countLocks( maze );
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in TreeDistances::update(): " << e.what() << std::endl;
+	}
+}
+
+MazeCell::border_t TreeDistances::wallBetween( const MazeGrid& maze, uint_fast32_t a, uint_fast32_t b ) const {
+	auto cols = maze.getCols();
+	if( a > b ) {
+		std::swap( a, b );
+	}
+	//b is now to the right of or below a, so the wall is b's
+	coordinate_t x = b % cols;
+	coordinate_t y = b / cols;
+	if( b == a + cols ) { //Checked first since, with only one column, that's also a + 1
+		return maze.getTop( x, y );
+	} else {
+		return maze.getLeft( x, y );
+	}
+}
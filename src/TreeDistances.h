@@ -0,0 +1,117 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The TreeDistances class answers how far apart two cells are without searching at all, as long as the maze has no loops. A freshly made maze is a tree (or, for pieces of an endless maze, a few trees), so there's exactly one way between any two cells: up from each of them to the nearest cell they share on the way to the root, and back down. That shared cell is found in constant time from a depth-first ordering of the cells and a table of the shallowest cell in each power-of-two run of them. Once a wall is dissolved there can be loops, so it stops answering and everybody goes back to searching.
+ */
+
+#ifndef TREEDISTANCES_H
+#define TREEDISTANCES_H
+
+#ifdef WINDOWS
+    #include <irrlicht.h>
+#else
+    #include <irrlicht/irrlicht.h>
+#endif
+#ifdef HAVE_VECTOR
+	#include <vector>
+#endif //HAVE_VECTOR
+#include "Integers.h"
+#include "MazeGrid.h"
+#include "PreprocessorCommands.h"
+
+class TreeDistances {
+	public:
+		/**
+		 * Constructor: Does nothing. The tree gets made the first time update() is called.
+		 */
+		TreeDistances();
+		/**
+		 * Destructor: Does nothing.
+		 */
+		virtual ~TreeDistances();
+
+		static const uint32_t UNREACHABLE = UINT32_MAX;
+
+		/**
+		 * Makes the tree match the maze's walls. After a new maze, that means starting over; after locks have been opened, only the count of locks between each cell and the root is redone. Does nothing if the walls haven't changed.
+		 */
+		void update( const MazeGrid& maze );
+		/**
+		 * Returns whether the maze, counting locks as passages, had no loops when update() was last called. If not, distance() and path() can't be used; search instead.
+		 */
+		inline bool isTree() const { return tree; }
+
+		/**
+		 * Returns how many steps it takes to get from one cell to another (both as returned by MazeGrid::index()), or UNREACHABLE. Only call this if isTree().
+		 * @param throughLocks: whether to count locks as open, as they will be once all the keys have been found.
+		 */
+		uint32_t distance( uint_fast32_t from, uint_fast32_t to, bool throughLocks = false ) const;
+		/**
+		 * Sets path to the cells walked through on the way from one cell to another, not counting from but counting to. Only call this if isTree().
+		 * @param throughLocks: as with distance().
+		 * @return false if to can't be reached, in which case path is left empty.
+		 */
+		bool path( const MazeGrid& maze, uint_fast32_t from, uint_fast32_t to, bool throughLocks, std::vector< irr::core::position2d< coordinate_t > >& path ) const;
+		/**
+		 * Returns how many cells have been looked at to make trees, ever. Used by AI to count nodes expanded, the same as DistanceFields::getCellsSearched().
+		 */
+		uint_fast64_t getCellsSearched() const;
+	protected:
+	private:
+		/**
+		 * The runs of cells in the depth-first order are looked at this many at a time: the table only has an entry for each power-of-two run of blocks, so it stays small, and the cells at either end of a query are looked at one by one.
+		 */
+		static const uint_fast32_t BLOCK_SIZE = 32;
+		static const uint32_t NO_PARENT = UINT32_MAX;
+
+		bool tree;
+		uint_fast64_t layoutVersion; ///< See MazeGrid::getLayoutVersion()
+		std::vector< MazeGrid::WallChange >::size_type wallChangesApplied; ///< How much of MazeGrid::getWallChanges() has been looked at already
+		uint_fast64_t cellsSearched;
+
+		//Each of these has one entry per cell, indexed the same way as MazeGrid
+		std::vector< uint32_t > parent; ///< The next cell toward the root, or NO_PARENT for the roots
+		std::vector< uint32_t > depth; ///< How many steps from the root
+		std::vector< uint32_t > locksAbove; ///< How many locks there are between the cell and the root
+		std::vector< uint32_t > root; ///< Which root the cell is under; cells under different roots can't reach each other
+		std::vector< uint32_t > position; ///< Where the cell is in order
+
+		std::vector< uint32_t > order; ///< The cells, depth-first from each root in turn. Every cell comes after its parent, and everything under a cell comes right after it.
+		/**
+		 * One per place in order: the parent of the cell there, with its depth in the high 32 bits, so that the smallest one in any run is the shallowest. The shallowest parent of the cells after one cell's place up to another's is the cell they share on the way to the root.
+		 */
+		std::vector< uint64_t > parentByDepth;
+		std::vector< std::vector< uint64_t > > blockMinimum; ///< blockMinimum[ k ][ b ] is the smallest of parentByDepth in the 2^k blocks starting with block b
+		std::vector< uint8_t > floorLog2; ///< floorLog2[ n ] is the biggest k with 2^k <= n, for every n up to the number of blocks
+
+		void build( const MazeGrid& maze );
+		/**
+		 * Redoes locksAbove, parents first.
+		 */
+		void countLocks( const MazeGrid& maze );
+		/**
+		 * Returns the nearest cell which both cells have on the way to the root. They have to be under the same root.
+		 */
+		uint32_t sharedAncestor( uint_fast32_t a, uint_fast32_t b ) const;
+		/**
+		 * Returns the wall between two neighboring cells.
+		 */
+		MazeCell::border_t wallBetween( const MazeGrid& maze, uint_fast32_t a, uint_fast32_t b ) const;
+		static inline bool isPassage( MazeCell::border_t wall ) {
+			return wall == MazeCell::NONE or wall == MazeCell::LOCK;
+		}
+};
+
+#endif // TREEDISTANCES_H
@@ -0,0 +1,133 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The WallFollower class is a table of where the Right Hand Rule and Left Hand Rule bots go next. For each cell, each hand, and each way the hand can be pointing, it says which way the bot steps and where its hand ends up pointing afterward. Following a wall is then one table lookup per step, no matter how many walls the bot has to feel its way past first.
+ */
+
+#include "WallFollower.h"
+
+#ifdef HAVE_IOSTREAM
+	#include <iostream>
+#endif //HAVE_IOSTREAM
+
+namespace {
+	//Which way a bot tries first for each way its hand can be pointing. Both hands try the same ways; they only differ in where the hand goes afterward.
+	const WallFollower::direction_t TRY[ WallFollower::NUM_DIRECTIONS ] = { WallFollower::LEFT, WallFollower::RIGHT, WallFollower::DOWN, WallFollower::UP };
+	const WallFollower::direction_t OPPOSITE[ WallFollower::NUM_DIRECTIONS ] = { WallFollower::DOWN, WallFollower::UP, WallFollower::RIGHT, WallFollower::LEFT };
+}
+
+const uint8_t WallFollower::POINTING_SHIFT;
+const uint8_t WallFollower::TURNS_SHIFT;
+const uint8_t WallFollower::WALLED_IN;
+
+WallFollower::WallFollower() {
+	try {
+		layoutVersion = 0;
+		wallChangesApplied = 0;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in WallFollower::WallFollower(): " << e.what() << std::endl;
+	}
+}
+
+WallFollower::~WallFollower() {
+	try {
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in WallFollower::~WallFollower(): " << e.what() << std::endl;
+	}
+}
+
+void WallFollower::fill( const MazeGrid& maze, uint_fast32_t cell ) {
+	bool open[ NUM_DIRECTIONS ];
+	for( uint_fast8_t d = 0; d < NUM_DIRECTIONS; ++d ) {
+		open[ d ] = isOpen( maze, cell, static_cast< direction_t >( d ) );
+	}
+
+	for( uint_fast8_t h = 0; h < NUM_HANDS; ++h ) {
+		for( uint_fast8_t p = 0; p < NUM_DIRECTIONS; ++p ) {
+			//The same as the bots used to do: try the way the hand says, and if there's a wall, move the hand and try again
+			auto pointing = static_cast< direction_t >( p );
+			uint_fast8_t turns = 0;
+			while( turns < NUM_DIRECTIONS and not open[ TRY[ pointing ] ] ) {
+				pointing = ( h == RIGHT_HAND ? TRY[ pointing ] : OPPOSITE[ TRY[ pointing ] ] );
+				turns += 1;
+			}
+
+			auto& entry = table[ ( cell * NUM_HANDS + h ) * NUM_DIRECTIONS + p ];
+			if( turns == NUM_DIRECTIONS ) {
+				entry = WALLED_IN;
+			} else {
+				auto moved = TRY[ pointing ];
+				auto after = ( h == RIGHT_HAND ? OPPOSITE[ moved ] : moved );
+				entry = moved bitor ( after << POINTING_SHIFT ) bitor ( turns << TURNS_SHIFT );
+			}
+		}
+	}
+}
+
+bool WallFollower::isOpen( const MazeGrid& maze, uint_fast32_t cell, direction_t direction ) const {
+	coordinate_t x = cell % maze.getCols();
+	coordinate_t y = cell / maze.getCols();
+	auto open = []( MazeCell::border_t original, MazeCell::border_t now ) {
+		return original == MazeCell::NONE or ( original == MazeCell::LOCK and now == MazeCell::NONE );
+	};
+	if( direction == UP ) {
+		return y > 0 and open( maze.getOriginalTop( x, y ), maze.getTop( x, y ) );
+	} else if( direction == DOWN ) {
+		return y < maze.getRows() - 1 and open( maze.getOriginalTop( x, y + 1 ), maze.getTop( x, y + 1 ) );
+	} else if( direction == LEFT ) {
+		return x > 0 and open( maze.getOriginalLeft( x, y ), maze.getLeft( x, y ) );
+	} else {
+		return x < maze.getCols() - 1 and open( maze.getOriginalLeft( x + 1, y ), maze.getLeft( x + 1, y ) );
+	}
+}
+
+void WallFollower::update( const MazeGrid& maze ) {
+	try {
+		if( maze.getLayoutVersion() not_eq layoutVersion or table.size() not_eq maze.getNumCells() * NUM_HANDS * NUM_DIRECTIONS ) { //Before getWallChanges() gets looked at, since a new layout clears them
+			layoutVersion = maze.getLayoutVersion();
+			table.resize( maze.getNumCells() * NUM_HANDS * NUM_DIRECTIONS );
+			for( decltype( maze.getNumCells() ) cell = 0; cell < maze.getNumCells(); ++cell ) {
+				fill( maze, cell );
+			}
+			wallChangesApplied = maze.getWallChanges().size();
+			return;
+		}
+
+		//A wall only matters to the two cells on either side of it
+		auto& changes = maze.getWallChanges();
+		for( ; wallChangesApplied < changes.size(); ++wallChangesApplied ) {
+			auto& change = changes[ wallChangesApplied ];
+			auto here = maze.index( change.x, change.y );
+			fill( maze, here );
+			if( change.left and change.x > 0 ) {
+				fill( maze, here - 1 );
+			} else if( not change.left and change.y > 0 ) {
+				fill( maze, here - maze.getCols() );
+			}
+		}
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error in WallFollower::update(): " << e.what() << std::endl;
+	}
+}
+
+uint_fast64_t WallFollower::walk( const MazeGrid& maze, hand_t hand, uint_fast32_t& cell, direction_t& pointing, uint_fast32_t stopAt, uint_fast64_t maxSteps ) const {
+	uint_fast64_t steps = 0;
+	uint_fast8_t turns;
+	direction_t moved;
+	while( cell not_eq stopAt and steps < maxSteps and step( maze, hand, cell, pointing, turns, moved ) ) {
+		steps += 1;
+	}
+	return steps;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The WallFollower class is a table of where the Right Hand Rule and Left Hand Rule bots go next. For each cell, each hand, and each way the hand can be pointing, it says which way the bot steps and where its hand ends up pointing afterward. Following a wall is then one table lookup per step, no matter how many walls the bot has to feel its way past first.
+ */
+
+#ifndef WALLFOLLOWER_H
+#define WALLFOLLOWER_H
+
+#ifdef HAVE_VECTOR
+	#include <vector>
+#endif //HAVE_VECTOR
+#include "Integers.h"
+#include "MazeGrid.h"
+#include "PreprocessorCommands.h"
+
+class WallFollower {
+	public:
+		/**
+		 * Constructor: Does nothing. The table gets made the first time update() is called.
+		 */
+		WallFollower();
+		/**
+		 * Destructor: Does nothing.
+		 */
+		virtual ~WallFollower();
+
+		enum hand_t : uint_fast8_t { RIGHT_HAND, LEFT_HAND, NUM_HANDS };
+		/**
+		 * In the same order as AI's directions, so the bots can keep their hand the way they always have.
+		 */
+		enum direction_t : uint_fast8_t { UP, DOWN, LEFT, RIGHT, NUM_DIRECTIONS };
+
+		/**
+		 * Makes the table match the maze's walls. After a new maze, that means starting over; after locks have been opened, only the cells beside them get looked at again. Does nothing if the walls haven't changed.
+		 */
+		void update( const MazeGrid& maze );
+
+		/**
+		 * Takes one step, the same way the bots used to by trying one way after another.
+		 * @param cell: the cell to step from (as returned by MazeGrid::index()). Set to the cell stepped into.
+		 * @param pointing: which way the hand is pointing. Set to where it points after the step.
+		 * @param turns: set to how many ways had a wall and had to be turned away from before finding one without.
+		 * @param moved: set to the way the step went.
+		 * @return false if the cell has walls all the way around, in which case nothing is changed.
+		 */
+		inline bool step( const MazeGrid& maze, hand_t hand, uint_fast32_t& cell, direction_t& pointing, uint_fast8_t& turns, direction_t& moved ) const {
+			auto entry = table[ ( cell * NUM_HANDS + hand ) * NUM_DIRECTIONS + pointing ];
+			if( entry bitand WALLED_IN ) {
+				return false;
+			}
+			moved = static_cast< direction_t >( entry bitand 3 );
+			pointing = static_cast< direction_t >( ( entry >> POINTING_SHIFT ) bitand 3 );
+			turns = ( entry >> TURNS_SHIFT ) bitand 3;
+			if( moved == UP ) {
+				cell -= maze.getCols();
+			} else if( moved == DOWN ) {
+				cell += maze.getCols();
+			} else if( moved == LEFT ) {
+				cell -= 1;
+			} else {
+				cell += 1;
+			}
+			return true;
+		}
+		/**
+		 * Takes steps until reaching stopAt or having taken maxSteps of them, or getting stuck.
+		 * @return how many steps were taken.
+		 */
+		uint_fast64_t walk( const MazeGrid& maze, hand_t hand, uint_fast32_t& cell, direction_t& pointing, uint_fast32_t stopAt, uint_fast64_t maxSteps ) const;
+	protected:
+	private:
+		//Each entry is one byte: the way the step goes in the lowest two bits, then where the hand points afterward, then how many turns it took, then whether there was no way out at all
+		static const uint8_t POINTING_SHIFT = 2;
+		static const uint8_t TURNS_SHIFT = 4;
+		static const uint8_t WALLED_IN = 1 << 6;
+		std::vector< uint8_t > table; ///< NUM_HANDS * NUM_DIRECTIONS entries per cell, indexed by cell first so that one cell's entries are all together
+
+		uint_fast64_t layoutVersion; ///< See MazeGrid::getLayoutVersion()
+		std::vector< MazeGrid::WallChange >::size_type wallChangesApplied; ///< How much of MazeGrid::getWallChanges() has been patched in already
+
+		/**
+		 * Works out all of one cell's entries.
+		 */
+		void fill( const MazeGrid& maze, uint_fast32_t cell );
+		/**
+		 * Returns whether the bots can go from the cell in the given direction. Walls which have been dissolved still count, as they always have for these bots, but opened locks don't.
+		 */
+		bool isOpen( const MazeGrid& maze, uint_fast32_t cell, direction_t direction ) const;
+};
+
+#endif // WALLFOLLOWER_H
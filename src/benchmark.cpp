@@ -0,0 +1,443 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The main() function of cybrinth-benchmark, built by "make check". It times maze generation, reachability checks, cell visibility, and every bot algorithm on mazes from 10x10 up to 4096x4096, always using the same random seeds so that runs from different builds can be compared. The results are printed as comma-separated values: one line per benchmark and maze size, giving nanoseconds per maze cell, memory allocations per run, the process's peak memory usage, and how many cells each bot looked at. Run it with -help to see the options.
+ */
+
+#include "AI.h"
+#include "BotSwarm.h"
+#include "HeadlessGame.h"
+#include "MazeGenerator.h"
+#include "MazeGrid.h"
+#include "Reachability.h"
+#include "StringConverter.h"
+#include "SystemSpecificsManager.h"
+#include "TreeDistances.h"
+#include "WallFollower.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <codecvt>
+#include <cstdlib>
+#include <functional>
+#ifdef HAVE_IOSTREAM
+	#include <iostream>
+#endif //HAVE_IOSTREAM
+#include <locale>
+#include <new>
+#include <sstream>
+#ifdef HAVE_STRING
+	#include <string>
+#endif //HAVE_STRING
+#ifdef HAVE_VECTOR
+	#include <vector>
+#endif //HAVE_VECTOR
+
+namespace {
+	std::atomic< uint_fast64_t > numAllocations( 0 ); ///< Counted by our replacement operator new below.
+
+	/**
+	 * One run of one benchmark: how big the maze was, how long the part being measured took, and how many times it allocated memory.
+	 */
+	struct Sample {
+		uint_fast64_t cells = 0;
+		std::chrono::nanoseconds time = std::chrono::nanoseconds::zero();
+		uint_fast64_t allocations = 0;
+		uint_fast64_t nodesExpanded = 0; ///< See AI::getNodesExpanded(). Only the bot benchmarks set this.
+		uint_fast64_t botsGaveUp = 0; ///< Bots which hadn't reached the goal after the number of turns HeadlessGame::play() allows by default
+	};
+
+	struct Benchmark {
+		std::wstring name;
+		/**
+		 * Sets up one run on a maze of the given size made from the given seed, and measures only the part being benchmarked.
+		 */
+		std::function< Sample( coordinate_t size, std::minstd_rand::result_type seed ) > run;
+	};
+
+	/**
+	 * Times something and counts its allocations.
+	 */
+	template< typename Function > void measure( Sample& sample, Function function ) {
+		auto allocationsBefore = numAllocations.load();
+		auto started = std::chrono::steady_clock::now();
+		function();
+		sample.time += std::chrono::steady_clock::now() - started;
+		sample.allocations += numAllocations.load() - allocationsBefore;
+	}
+
+	/**
+	 * Sets up a HeadlessGame the same way for every benchmark that needs a whole level. The levels themselves are made with MazeManager::makeRandomLevelOfSize(), so that every run at one size has the same number of cells.
+	 */
+	void setUpGame( HeadlessGame& game ) {
+		game.settingsManager.setMazeGenerator( MazeGenerator::DEPTH_FIRST_SEARCH );
+		game.settingsManager.setGrowingTreePolicy( MazeGenerator::NEWEST );
+		game.settingsManager.setHideUnseen( false );
+		game.settingsManager.botsKnowSolution = false;
+	}
+
+	uint_fast64_t cellsIn( MazeManager* mazeManager ) {
+		return static_cast< uint_fast64_t >( mazeManager->cols ) * mazeManager->rows;
+	}
+
+	std::vector< Benchmark > allBenchmarks() {
+		std::vector< Benchmark > benchmarks;
+
+		//The generators, on their own, on mazes of exactly the size given. Depth-first search is what recurseRandom() used to be.
+		for( uint_fast8_t a = 0; a < MazeGenerator::ALGORITHM_DO_NOT_USE; ++a ) {
+			auto algorithm = static_cast< MazeGenerator::algorithm_t >( a );
+			benchmarks.push_back( { L"generate " + MazeGenerator::stringFromAlgorithm( algorithm ), [ algorithm ]( coordinate_t size, std::minstd_rand::result_type seed ) {
+				Sample sample;
+				MazeGrid maze;
+				maze.resize( size, size );
+				maze.fillWalls( MazeCell::WALL );
+				std::minstd_rand randomNumberGenerator( seed );
+				MazeGenerator generator;
+				generator.setAlgorithm( algorithm );
+				generator.setPolicy( MazeGenerator::NEWEST );
+				generator.randomNumber = [ &randomNumberGenerator ]() { return randomNumberGenerator(); };
+				measure( sample, [ & ]() { generator.generate( maze, 0, 0 ); } );
+				sample.cells = maze.getNumCells();
+				return sample;
+			} } );
+		}
+
+		benchmarks.push_back( { L"makeRandomLevelOfSize", []( coordinate_t size, std::minstd_rand::result_type seed ) {
+			Sample sample;
+			HeadlessGame game;
+			setUpGame( game );
+			auto mazeManager = game.getMazeManager();
+			mazeManager->setRandomSeed( seed );
+			measure( sample, [ & ]() { mazeManager->makeRandomLevelOfSize( size, size ); } );
+			sample.cells = cellsIn( mazeManager );
+			return sample;
+		} } );
+
+		benchmarks.push_back( { L"canGetToAllCollectables", []( coordinate_t size, std::minstd_rand::result_type seed ) {
+			Sample sample;
+			HeadlessGame game;
+			setUpGame( game );
+			auto mazeManager = game.getMazeManager();
+			mazeManager->setRandomSeed( seed );
+			mazeManager->makeRandomLevelOfSize( size, size );
+			auto start = mazeManager->playerStart.at( 0 );
+			measure( sample, [ & ]() { mazeManager->canGetToAllCollectables( start.getX(), start.getY() ); } );
+			sample.cells = cellsIn( mazeManager );
+			return sample;
+		} } );
+
+		//Every cell is a target, so the search can't stop early. Mazes 64 or more cells wide get packed (once per maze, which is counted here) and filled a word at a time.
+		benchmarks.push_back( { L"flood fill", []( coordinate_t size, std::minstd_rand::result_type seed ) {
+			Sample sample;
+			HeadlessGame game;
+			setUpGame( game );
+			auto mazeManager = game.getMazeManager();
+			mazeManager->setRandomSeed( seed );
+			mazeManager->makeRandomLevelOfSize( size, size );
+			std::vector< uint_fast32_t > targets( mazeManager->maze.getNumCells() );
+			for( decltype( targets.size() ) i = 0; i < targets.size(); ++i ) {
+				targets[ i ] = i;
+			}
+			auto start = mazeManager->playerStart.at( 0 );
+			Reachability reachability;
+			measure( sample, [ & ]() { reachability.canReachAll( mazeManager->maze, start.getX(), start.getY(), targets ); } );
+			sample.cells = cellsIn( mazeManager );
+			return sample;
+		} } );
+
+		//Once for every cell, as if a player had walked everywhere
+		benchmarks.push_back( { L"makeCellsVisible", []( coordinate_t size, std::minstd_rand::result_type seed ) {
+			Sample sample;
+			HeadlessGame game;
+			setUpGame( game );
+			game.settingsManager.setHideUnseen( true ); //Otherwise makeCellsVisible() has nothing to do
+			auto mazeManager = game.getMazeManager();
+			mazeManager->setRandomSeed( seed );
+			mazeManager->makeRandomLevelOfSize( size, size );
+			measure( sample, [ & ]() {
+				for( decltype( mazeManager->cols ) x = 0; x < mazeManager->cols; ++x ) {
+					for( decltype( mazeManager->rows ) y = 0; y < mazeManager->rows; ++y ) {
+						mazeManager->makeCellsVisible( x, y );
+					}
+				}
+			} );
+			sample.cells = cellsIn( mazeManager );
+			return sample;
+		} } );
+
+		//Making the tree, then asking it how far each cell is from another cell scattered somewhere else in the maze
+		benchmarks.push_back( { L"tree distances", []( coordinate_t size, std::minstd_rand::result_type seed ) {
+			Sample sample;
+			HeadlessGame game;
+			setUpGame( game );
+			auto mazeManager = game.getMazeManager();
+			mazeManager->setRandomSeed( seed );
+			mazeManager->makeRandomLevelOfSize( size, size );
+			auto& grid = mazeManager->maze;
+			uint_fast64_t total = 0;
+			measure( sample, [ & ]() {
+				TreeDistances tree;
+				tree.update( grid );
+				auto numCells = grid.getNumCells();
+				for( decltype( numCells ) cell = 0; cell < numCells; ++cell ) {
+					total += tree.distance( cell, ( static_cast< uint_fast64_t >( cell ) * 7919 ) % numCells, true );
+				}
+			} );
+			sample.cells = cellsIn( mazeManager );
+			if( total == 0 and sample.cells > 1 ) { //Also keeps the compiler from leaving out the queries
+				std::wcerr << L"The tree distances all came out zero" << std::endl;
+			}
+			return sample;
+		} } );
+
+		//Bots which know the solution find it when they're set up. The hand rules don't have a solving step, so they only appear under "play".
+		for( auto algorithm : { AI::RANDOM_DEPTH_FIRST_SEARCH, AI::ITERATIVE_DEEPENING_DEPTH_FIRST_SEARCH, AI::HEURISTIC_DEPTH_FIRST_SEARCH, AI::DIJKSTRA, AI::A_STAR } ) {
+			benchmarks.push_back( { L"solve " + AI::stringFromAlgorithm( algorithm ), [ algorithm ]( coordinate_t size, std::minstd_rand::result_type seed ) {
+				Sample sample;
+				HeadlessGame game;
+				setUpGame( game );
+				game.newMaze( seed, size, size );
+				AI bot;
+				bot.setPlayer( 0 );
+				measure( sample, [ & ]() { //Same as HeadlessGame::newMaze() and MainGame::takeLevelFromMazeManager()
+					bot.setup( &game, true, algorithm, 0 );
+					if( game.getMazeManager()->numLocks == 0 ) {
+						bot.allKeysFound();
+					}
+				} );
+				sample.cells = cellsIn( game.getMazeManager() );
+				sample.nodesExpanded = bot.getNodesExpanded();
+				return sample;
+			} } );
+		}
+
+		//Bots which don't know the solution work it out one move at a time, all the way to the goal
+		for( uint_fast8_t a = 0; a < AI::ALGORITHM_DO_NOT_USE; ++a ) {
+			auto algorithm = static_cast< AI::algorithm_t >( a );
+			benchmarks.push_back( { L"play " + AI::stringFromAlgorithm( algorithm ), [ algorithm ]( coordinate_t size, std::minstd_rand::result_type seed ) {
+				Sample sample;
+				HeadlessGame game;
+				setUpGame( game );
+				game.settingsManager.setBotAlgorithm( algorithm );
+				game.newMaze( seed, size, size );
+				std::vector< HeadlessGame::BotResult > results;
+				measure( sample, [ & ]() { results = game.play( 0 ); } );
+				sample.cells = cellsIn( game.getMazeManager() );
+				if( not results.empty() ) {
+					sample.nodesExpanded = results.front().nodesExpanded;
+				}
+				if( results.empty() or not results.front().reachedGoal ) {
+					sample.botsGaveUp += 1;
+				}
+				return sample;
+			} } );
+		}
+
+		//A whole walk from the start to the goal, one table lookup per step. Mazes without loops always get there; the step limit is for those with them.
+		for( auto hand : { WallFollower::RIGHT_HAND, WallFollower::LEFT_HAND } ) {
+			benchmarks.push_back( { ( hand == WallFollower::RIGHT_HAND ? L"follow right hand" : L"follow left hand" ), [ hand ]( coordinate_t size, std::minstd_rand::result_type seed ) {
+				Sample sample;
+				HeadlessGame game;
+				setUpGame( game );
+				game.newMaze( seed, size, size );
+				auto mazeManager = game.getMazeManager();
+				auto& grid = mazeManager->maze;
+				grid.removeLocks(); //As if every key had been found; otherwise the goal can be out of reach
+				mazeManager->wallFollower.update( grid );
+				auto start = grid.index( mazeManager->playerStart.at( 0 ).getX(), mazeManager->playerStart.at( 0 ).getY() );
+				auto goal = grid.index( game.getGoal()->getX(), game.getGoal()->getY() );
+				uint_fast64_t steps = 0;
+				measure( sample, [ & ]() {
+					auto cell = start;
+					auto pointing = WallFollower::UP;
+					steps = mazeManager->wallFollower.walk( grid, hand, cell, pointing, goal, static_cast< uint_fast64_t >( grid.getNumCells() ) * 4 );
+				} );
+				sample.cells = cellsIn( mazeManager );
+				sample.nodesExpanded = steps;
+				return sample;
+			} } );
+		}
+
+		//One bot on every cell, all taking a step at once
+		benchmarks.push_back( { L"swarm", []( coordinate_t size, std::minstd_rand::result_type seed ) {
+			Sample sample;
+			HeadlessGame game;
+			setUpGame( game );
+			game.newMaze( seed, size, size );
+			BotSwarm swarm;
+			swarm.reset( &game, cellsIn( game.getMazeManager() ), 0 );
+			swarm.move( 0 ); //The first move makes the distance fields; after that, moving is all that's left
+			measure( sample, [ & ]() { swarm.move( 0 ); } );
+			sample.cells = cellsIn( game.getMazeManager() );
+			return sample;
+		} } );
+
+		return benchmarks;
+	}
+
+	void printUsage() {
+		std::wcout << L"Usage: cybrinth-benchmark [options]" << std::endl;
+		std::wcout << L"  -benchmark TEXT  Only run benchmarks whose names contain this text. Can be given more than once. Default: all of them." << std::endl;
+		std::wcout << L"  -sizes N,N,...   Maze sizes to try, smallest first (default 10,32,64,128,256,512,1024,2048,4096)" << std::endl;
+		std::wcout << L"  -runs N          How many random seeds to try at each size (default 3). Small sizes get more runs, so that every size looks at 100,000 cells or more." << std::endl;
+		std::wcout << L"  -seed N          The first random seed; the rest use the following seeds (default 1)" << std::endl;
+		std::wcout << L"  -max-seconds N   Stop a benchmark once it takes, or looks likely to take, longer than this at one size (default 10). The runs finished so far at that size are still reported." << std::endl;
+		std::wcout << L"  -list            Print the benchmarks' names and exit" << std::endl;
+		std::wcout << L"Output columns: benchmark, maze size, runs, mean cells per run, nanoseconds per cell, allocations per run, the peak memory use of the whole process so far in KiB, and, for the bot benchmarks, how many cells the bot looked at per run (see cybrinth-sim). Since the peak memory never goes down, run one benchmark at a time to see how much it needs by itself." << std::endl;
+	}
+}
+
+//Replacing these lets us count every allocation made by anything we call. The array versions use these too.
+void* operator new( std::size_t size ) {
+	numAllocations.fetch_add( 1, std::memory_order_relaxed );
+	void* memory = std::malloc( size > 0 ? size : 1 );
+	if( memory == nullptr ) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void operator delete( void* memory ) noexcept {
+	std::free( memory );
+}
+
+#if __cpp_sized_deallocation
+	void operator delete( void* memory, std::size_t ) noexcept {
+		std::free( memory );
+	}
+#endif //__cpp_sized_deallocation
+
+int main( int argc, char *argv[] ) {
+	const std::locale utf8Locale( std::locale(), new std::codecvt_utf8< wchar_t > ); //Same as in the game's main()
+	std::locale::global( utf8Locale );
+
+	try {
+		std::vector< std::wstring > filters;
+		std::vector< coordinate_t > sizes = { 10, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+		uint_fast32_t minimumRuns = 3;
+		std::minstd_rand::result_type firstSeed = 1;
+		double maxSeconds = 10;
+		const uint_fast64_t minimumCellsPerSize = 100000;
+
+		auto benchmarks = allBenchmarks();
+
+		StringConverter sc;
+		for( decltype( argc ) argNum = 1; argNum < argc; ++argNum ) {
+			auto argument = sc.toStdWString( argv[ argNum ] );
+			bool hasValue = ( argNum + 1 < argc );
+
+			if( argument.compare( L"-list" ) == 0 ) {
+				for( decltype( benchmarks.size() ) b = 0; b < benchmarks.size(); ++b ) {
+					std::wcout << benchmarks.at( b ).name << std::endl;
+				}
+				return EXIT_SUCCESS;
+			} else if( argument.compare( L"-help" ) == 0 or argument.compare( L"--help" ) == 0 ) {
+				printUsage();
+				return EXIT_SUCCESS;
+			} else if( hasValue ) {
+				argNum += 1;
+				auto value = sc.toStdWString( argv[ argNum ] );
+
+				if( argument.compare( L"-benchmark" ) == 0 ) {
+					filters.push_back( value );
+				} else if( argument.compare( L"-sizes" ) == 0 ) {
+					sizes.clear();
+					std::wstringstream stream( value );
+					std::wstring size;
+					while( std::getline( stream, size, L',' ) ) {
+						sizes.push_back( std::max< unsigned long >( 3, std::stoul( size ) ) );
+					}
+				} else if( argument.compare( L"-runs" ) == 0 ) {
+					minimumRuns = std::max< unsigned long >( 1, std::stoul( value ) );
+				} else if( argument.compare( L"-seed" ) == 0 ) {
+					firstSeed = std::stoul( value );
+				} else if( argument.compare( L"-max-seconds" ) == 0 ) {
+					maxSeconds = std::stod( value );
+				} else {
+					std::wcerr << L"Unrecognized option: " << argument << std::endl;
+					printUsage();
+					return EXIT_FAILURE;
+				}
+			} else {
+				std::wcerr << L"Unrecognized option, or option missing its value: " << argument << std::endl;
+				printUsage();
+				return EXIT_FAILURE;
+			}
+		}
+
+		SystemSpecificsManager system;
+		std::wcout << L"benchmark,size,runs,cells per run,ns per cell,allocations per run,peak memory (KiB),nodes expanded per run" << std::endl;
+
+		for( decltype( benchmarks.size() ) b = 0; b < benchmarks.size(); ++b ) {
+			const auto& benchmark = benchmarks.at( b );
+			bool wanted = filters.empty();
+			for( decltype( filters.size() ) f = 0; not wanted and f < filters.size(); ++f ) {
+				wanted = ( benchmark.name.find( filters.at( f ) ) not_eq std::wstring::npos );
+			}
+			if( not wanted ) {
+				continue;
+			}
+
+			std::chrono::duration< double > previousElapsed( 0 );
+			for( decltype( sizes.size() ) s = 0; s < sizes.size(); ++s ) {
+				auto size = sizes.at( s );
+				uint_fast64_t cellsPerRun = static_cast< uint_fast64_t >( size ) * size;
+				auto runs = std::max< uint_fast64_t >( minimumRuns, minimumCellsPerSize / cellsPerRun );
+
+				Sample total;
+				decltype( runs ) runsDone = 0;
+				auto started = std::chrono::steady_clock::now();
+				std::chrono::duration< double > elapsed( 0 );
+				while( runsDone < runs and elapsed.count() <= maxSeconds ) {
+					auto sample = benchmark.run( size, firstSeed + runsDone );
+					total.cells += sample.cells;
+					total.time += sample.time;
+					total.allocations += sample.allocations;
+					total.nodesExpanded += sample.nodesExpanded;
+					total.botsGaveUp += sample.botsGaveUp;
+					runsDone += 1;
+					elapsed = std::chrono::steady_clock::now() - started;
+				}
+
+				std::wcout << benchmark.name << L"," << size << L"," << runsDone << L"," << total.cells / runsDone << L"," << ( total.cells > 0 ? static_cast< double >( total.time.count() ) / total.cells : 0 ) << L"," << static_cast< double >( total.allocations ) / runsDone << L"," << system.getPeakMemoryUsage() / 1024 << L"," << static_cast< double >( total.nodesExpanded ) / runsDone << std::endl;
+				if( total.botsGaveUp > 0 ) {
+					std::wcerr << L"Warning: in " << total.botsGaveUp << L" of " << runsDone << L" runs of " << benchmark.name << L" at size " << size << L", the bot gave up before reaching the goal" << std::endl;
+				}
+
+				if( runsDone < runs ) {
+					std::wcerr << L"Skipping sizes above " << size << L" for " << benchmark.name << L": this size took too long" << std::endl;
+					break;
+				}
+
+				//Each size has about four times as many cells as the last, so guess that the next one will take as much longer than this one as this one took than the last. That stops the slow algorithms before they get to sizes that would take hours (or run out of memory).
+				if( s + 1 < sizes.size() ) {
+					double growth = ( previousElapsed.count() > 0 ? std::max( 1.0, elapsed.count() / previousElapsed.count() ) : 1.0 );
+					if( elapsed.count() * growth > maxSeconds ) {
+						std::wcerr << L"Skipping sizes above " << size << L" for " << benchmark.name << L": the next size would take too long" << std::endl;
+						break;
+					}
+				}
+				previousElapsed = elapsed;
+			}
+		}
+
+		return EXIT_SUCCESS;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error caught by main(): " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_FAILURE;
+}
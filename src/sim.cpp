@@ -0,0 +1,229 @@
+/**
+ * @file
+ * @author James Dearing <dearingj@lifetime.oregonstate.edu>
+ *
+ * @section LICENSE
+ * Copyright © 2012-2017.
+ * This file is part of Cybrinth.
+ *
+ * Cybrinth is free software: you can redistribute it and/or modify it under the terms of the GNU Affero General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * Cybrinth is distributed 'as is' in the hope that it will be fun, but WITHOUT ANY WARRANTY; without even the implied warranty of TITLE, MERCHANTABILITY, COMPLETE DESTRUCTION OF EVIL MONSTERS, or FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License along with Cybrinth. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @section DESCRIPTION
+ * The main() function of cybrinth-sim, which holds bot tournaments without opening a window. Every bot algorithm plays the same mazes (made from consecutive random seeds, exactly as the game would make them), spread across all the processor's cores, and the program reports how many steps each algorithm took to reach the goal, how long it spent thinking, and how many cells it looked at along the way. Run it with -help to see the options.
+ */
+
+#include "AI.h"
+#include "HeadlessGame.h"
+#include "MazeGenerator.h"
+#include "StringConverter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <codecvt>
+#ifdef HAVE_IOSTREAM
+	#include <iostream>
+#endif //HAVE_IOSTREAM
+#include <locale>
+#include <thread>
+#ifdef HAVE_VECTOR
+	#include <vector>
+#endif //HAVE_VECTOR
+
+namespace {
+	/**
+	 * What happened to every bot using one algorithm, added up over all the mazes.
+	 */
+	struct AlgorithmTotals {
+		uint_fast64_t mazes = 0;
+		uint_fast64_t bots = 0;
+		uint_fast64_t botsAtGoal = 0;
+		uint_fast64_t stepsToGoal = 0; ///< Only counts bots which reached the goal
+		uint_fast64_t nodesExpanded = 0;
+		std::chrono::nanoseconds thinkingTime = std::chrono::nanoseconds::zero();
+		std::chrono::nanoseconds longestThinkingTime = std::chrono::nanoseconds::zero();
+	};
+
+	void printUsage() {
+		std::wcout << L"Usage: cybrinth-sim [options]" << std::endl;
+		std::wcout << L"  -mazes N         How many mazes each algorithm plays (default 100)" << std::endl;
+		std::wcout << L"  -bots N          How many bots play each maze at once (default 1)" << std::endl;
+		std::wcout << L"  -algorithm NAME  A bots' solving algorithm to include, as in prefs.cfg. Can be given more than once. Default: all of them." << std::endl;
+		std::wcout << L"  -solved          Bots know the solution beforehand (the \"bots know the solution\" preference)" << std::endl;
+		std::wcout << L"  -size N          The \"maze size\" preference (default 30)" << std::endl;
+		std::wcout << L"  -generator NAME  The \"maze generator\" preference" << std::endl;
+		std::wcout << L"  -policy NAME     The \"growing tree policy\" preference" << std::endl;
+		std::wcout << L"  -seed N          The first maze's random seed; the rest use the following seeds (default 1)" << std::endl;
+		std::wcout << L"  -max-turns N     Bots give up after this many turns. Default: the number of cells in the maze, squared." << std::endl;
+		std::wcout << L"  -threads N       How many mazes to play at once (default: one per core)" << std::endl;
+		std::wcout << L"  -csv             Print comma-separated values instead of a table" << std::endl;
+	}
+}
+
+int main( int argc, char *argv[] ) {
+	const std::locale utf8Locale( std::locale(), new std::codecvt_utf8< wchar_t > ); //Same as in the game's main()
+	std::locale::global( utf8Locale );
+
+	try {
+		uint_fast64_t numMazes = 100;
+		uint_fast8_t numBots = 1;
+		std::vector< AI::algorithm_t > algorithms;
+		bool botsKnowSolution = false;
+		coordinate_t mazeSize = 30;
+		auto generator = MazeGenerator::DEPTH_FIRST_SEARCH;
+		auto policy = MazeGenerator::NEWEST;
+		std::minstd_rand::result_type firstSeed = 1;
+		uint_fast64_t maxTurns = 0;
+		uint_fast32_t numThreads = std::max< uint_fast32_t >( 1, std::thread::hardware_concurrency() );
+		bool csv = false;
+
+		StringConverter sc;
+		for( decltype( argc ) argNum = 1; argNum < argc; ++argNum ) {
+			auto argument = sc.toStdWString( argv[ argNum ] );
+			bool hasValue = ( argNum + 1 < argc );
+
+			if( argument.compare( L"-solved" ) == 0 ) {
+				botsKnowSolution = true;
+			} else if( argument.compare( L"-csv" ) == 0 ) {
+				csv = true;
+			} else if( argument.compare( L"-help" ) == 0 or argument.compare( L"--help" ) == 0 ) {
+				printUsage();
+				return EXIT_SUCCESS;
+			} else if( hasValue ) {
+				argNum += 1;
+				auto value = sc.toStdWString( argv[ argNum ] );
+
+				if( argument.compare( L"-mazes" ) == 0 ) {
+					numMazes = std::stoull( value );
+				} else if( argument.compare( L"-bots" ) == 0 ) {
+					numBots = std::min< unsigned long >( std::max< unsigned long >( 1, std::stoul( value ) ), UINT8_MAX );
+				} else if( argument.compare( L"-algorithm" ) == 0 ) {
+					algorithms.push_back( AI::algorithmFromString( value ) );
+				} else if( argument.compare( L"-size" ) == 0 ) {
+					mazeSize = std::stoul( value );
+				} else if( argument.compare( L"-generator" ) == 0 ) {
+					generator = MazeGenerator::algorithmFromString( value );
+				} else if( argument.compare( L"-policy" ) == 0 ) {
+					policy = MazeGenerator::policyFromString( value );
+				} else if( argument.compare( L"-seed" ) == 0 ) {
+					firstSeed = std::stoul( value );
+				} else if( argument.compare( L"-max-turns" ) == 0 ) {
+					maxTurns = std::stoull( value );
+				} else if( argument.compare( L"-threads" ) == 0 ) {
+					numThreads = std::max< unsigned long >( 1, std::stoul( value ) );
+				} else {
+					std::wcerr << L"Unrecognized option: " << argument << std::endl;
+					printUsage();
+					return EXIT_FAILURE;
+				}
+			} else {
+				std::wcerr << L"Unrecognized option, or option missing its value: " << argument << std::endl;
+				printUsage();
+				return EXIT_FAILURE;
+			}
+		}
+
+		if( algorithms.empty() ) {
+			for( uint_fast8_t a = 0; a < AI::ALGORITHM_DO_NOT_USE; ++a ) {
+				algorithms.push_back( static_cast< AI::algorithm_t >( a ) );
+			}
+		}
+
+		//Each piece of work is one maze played by one algorithm's bots. The same seeds are used for every algorithm, so they all play the same mazes.
+		uint_fast64_t numGames = numMazes * algorithms.size();
+		numThreads = std::min< uint_fast64_t >( numThreads, std::max< uint_fast64_t >( 1, numGames ) );
+		std::atomic< uint_fast64_t > nextGame( 0 );
+		std::vector< std::vector< AlgorithmTotals > > totalsPerThread( numThreads, std::vector< AlgorithmTotals >( algorithms.size() ) );
+
+		auto work = [ & ]( uint_fast32_t threadNum ) {
+			HeadlessGame game;
+			game.settingsManager.setNumPlayers( numBots );
+			game.settingsManager.setNumBots( numBots );
+			game.settingsManager.setMazeSize( mazeSize );
+			game.settingsManager.setMazeGenerator( generator );
+			game.settingsManager.setGrowingTreePolicy( policy );
+
+			auto& totals = totalsPerThread.at( threadNum );
+			for( auto g = nextGame++; g < numGames; g = nextGame++ ) {
+				auto a = g / numMazes;
+				game.settingsManager.botsKnowSolution = botsKnowSolution;
+				game.settingsManager.setBotAlgorithm( algorithms.at( a ) ); //May turn botsKnowSolution on, if the algorithm needs it
+				game.newMaze( firstSeed + ( g % numMazes ) );
+
+				auto results = game.play( maxTurns );
+				totals.at( a ).mazes += 1;
+				for( decltype( results.size() ) r = 0; r < results.size(); ++r ) {
+					totals.at( a ).bots += 1;
+					if( results.at( r ).reachedGoal ) {
+						totals.at( a ).botsAtGoal += 1;
+						totals.at( a ).stepsToGoal += results.at( r ).steps;
+					}
+					totals.at( a ).nodesExpanded += results.at( r ).nodesExpanded;
+					totals.at( a ).thinkingTime += results.at( r ).thinkingTime;
+					totals.at( a ).longestThinkingTime = std::max( totals.at( a ).longestThinkingTime, results.at( r ).thinkingTime );
+				}
+			}
+		};
+
+		auto started = std::chrono::steady_clock::now();
+		{
+			std::vector< std::thread > threads;
+			for( decltype( numThreads ) t = 1; t < numThreads; ++t ) {
+				threads.push_back( std::thread( work, t ) );
+			}
+			work( 0 );
+			for( decltype( threads.size() ) t = 0; t < threads.size(); ++t ) {
+				threads.at( t ).join();
+			}
+		}
+		std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - started;
+
+		std::vector< AlgorithmTotals > totals( algorithms.size() );
+		for( decltype( totalsPerThread.size() ) t = 0; t < totalsPerThread.size(); ++t ) {
+			for( decltype( totals.size() ) a = 0; a < totals.size(); ++a ) {
+				const auto& threadTotals = totalsPerThread.at( t ).at( a );
+				totals.at( a ).mazes += threadTotals.mazes;
+				totals.at( a ).bots += threadTotals.bots;
+				totals.at( a ).botsAtGoal += threadTotals.botsAtGoal;
+				totals.at( a ).stepsToGoal += threadTotals.stepsToGoal;
+				totals.at( a ).nodesExpanded += threadTotals.nodesExpanded;
+				totals.at( a ).thinkingTime += threadTotals.thinkingTime;
+				totals.at( a ).longestThinkingTime = std::max( totals.at( a ).longestThinkingTime, threadTotals.longestThinkingTime );
+			}
+		}
+
+		if( csv ) {
+			std::wcout << L"algorithm,mazes,bots,bots at goal,mean steps to goal,mean nodes expanded,mean thinking time (ms),longest thinking time (ms)" << std::endl;
+		} else {
+			std::wcout << numGames << L" games (" << numMazes << L" mazes x " << algorithms.size() << L" algorithms, " << static_cast< unsigned int >( numBots ) << L" bots each) on " << numThreads << L" threads in " << elapsed.count() << L" seconds: " << ( elapsed.count() > 0 ? numGames / elapsed.count() : 0 ) << L" games per second" << std::endl;
+		}
+
+		for( decltype( totals.size() ) a = 0; a < totals.size(); ++a ) {
+			const auto& t = totals.at( a );
+			double meanSteps = ( t.botsAtGoal > 0 ? static_cast< double >( t.stepsToGoal ) / t.botsAtGoal : 0 );
+			double meanNodes = ( t.bots > 0 ? static_cast< double >( t.nodesExpanded ) / t.bots : 0 );
+			double meanThinkingMs = ( t.bots > 0 ? std::chrono::duration< double, std::milli >( t.thinkingTime ).count() / t.bots : 0 );
+			double longestThinkingMs = std::chrono::duration< double, std::milli >( t.longestThinkingTime ).count();
+
+			if( csv ) {
+				std::wcout << AI::stringFromAlgorithm( algorithms.at( a ) ) << L"," << t.mazes << L"," << t.bots << L"," << t.botsAtGoal << L"," << meanSteps << L"," << meanNodes << L"," << meanThinkingMs << L"," << longestThinkingMs << std::endl;
+			} else {
+				std::wcout << AI::stringFromAlgorithm( algorithms.at( a ) ) << L":" << std::endl;
+				std::wcout << L"\treached the goal: " << t.botsAtGoal << L" of " << t.bots << std::endl;
+				std::wcout << L"\tmean steps to goal: " << meanSteps << std::endl;
+				std::wcout << L"\tmean nodes expanded: " << meanNodes << std::endl;
+				std::wcout << L"\tmean thinking time: " << meanThinkingMs << L" ms (longest " << longestThinkingMs << L" ms)" << std::endl;
+			}
+		}
+
+		return EXIT_SUCCESS;
+	} catch ( std::exception &e ) {
+		std::wcerr << L"Error caught by main(): " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_FAILURE;
+}